@@ -28,29 +28,52 @@ alignas(CACHE_LINE_SIZE) GLOBAL MasstreeWrapper<Tuple> MT;
 #endif
 
 #ifdef GLOBAL_VALUE_DEFINE
+DEFINE_bool(arrival_poisson, true,
+            "True means Poisson arrivals of the open loop, false means "
+            "fixed intervals.");
+DEFINE_uint64(arrival_rate, 0,
+              "Offered load of all the worker threads[tps]. 0 means the "
+              "closed loop.");
 DEFINE_uint64(clocks_per_us, 2100,
               "CPU_MHz. Use this info for measuring time.");
 DEFINE_uint64(epoch_time, 40, "Epoch interval[msec].");
 DEFINE_uint64(extime, 3, "Execution time[sec].");
 DEFINE_uint64(max_ope, 10,
               "Total number of operations per single transaction.");
+DEFINE_string(result_file, "",
+              "File which the result is appended to in result_format.");
+DEFINE_string(result_format, "",
+              "Format of the exported result, json or csv. Empty means no "
+              "export.");
 DEFINE_bool(rmw, false,
             "True means read modify write, false means blind write.");
 DEFINE_uint64(rratio, 50, "read ratio of single transaction.");
+DEFINE_uint64(sample_interval, 0,
+              "Interval of sampling the throughput[msec]. 0 disables the time "
+              "series.");
 DEFINE_uint64(thread_num, 10, "Total number of worker threads.");
 DEFINE_uint64(tuple_num, 1000000, "Total number of records.");
+DEFINE_uint64(warmup, 0,
+              "Warm-up time[sec] before the measured extime. It is excluded "
+              "from the result.");
 DEFINE_bool(ycsb, true,
             "True uses zipf_skew, false uses faster random generator.");
 DEFINE_double(zipf_skew, 0, "zipf skew. 0 ~ 0.999...");
 #else
+DECLARE_bool(arrival_poisson);
+DECLARE_uint64(arrival_rate);
 DECLARE_uint64(clocks_per_us);
 DECLARE_uint64(epoch_time);
 DECLARE_uint64(extime);
 DECLARE_uint64(max_ope);
+DECLARE_string(result_file);
+DECLARE_string(result_format);
 DECLARE_bool(rmw);
 DECLARE_uint64(rratio);
+DECLARE_uint64(sample_interval);
 DECLARE_uint64(thread_num);
 DECLARE_uint64(tuple_num);
+DECLARE_uint64(warmup);
 DECLARE_bool(ycsb);
 DECLARE_double(zipf_skew);
 #endif
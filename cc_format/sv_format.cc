@@ -27,18 +27,24 @@
 #include "../include/masstree_wrapper.hh"
 #include "../include/random.hh"
 #include "../include/result.hh"
+#include "../include/result_export.hh"
+#include "../include/sampler.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
 #include "../include/zipf.hh"
 
 using namespace std;
 
-void worker(size_t thid, char& ready, const bool& start, const bool& quit) {
+void worker(size_t thid, char& ready, const bool& start, const bool& quit,
+            Sampler& sampler) {
   Result& myres = std::ref(SiloResult[thid]);
   Xoroshiro128Plus rnd;
   rnd.init();
   TxnExecutor trans(thid, (Result*)&myres);
   FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
+  ProcedureBatch batch(rnd, zipf, FLAGS_ycsb);
+  OpenLoop open_loop(rnd, FLAGS_arrival_rate, FLAGS_thread_num,
+                     FLAGS_arrival_poisson, FLAGS_clocks_per_us);
   uint64_t epoch_timer_start, epoch_timer_stop;
 #if BACK_OFF
   Backoff backoff(FLAGS_clocks_per_us);
@@ -78,13 +84,17 @@ void worker(size_t thid, char& ready, const bool& start, const bool& quit) {
   while (!loadAcquire(start)) _mm_pause();
   if (thid == 0) epoch_timer_start = rdtscp();
   while (!loadAcquire(quit)) {
+    sampler.resetAfterWarmup(thid);
+    if (!open_loop.waitArrival(quit, myres,
+                               [&] { sampler.resetAfterWarmup(thid); }))
+      break;
 #if PARTITION_TABLE
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope,
-                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, true,
+    makeProcedure(trans.pro_set_, batch, FLAGS_tuple_num, FLAGS_max_ope,
+                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, true,
                   thid, myres);
 #else
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope,
-                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false,
+    makeProcedure(trans.pro_set_, batch, FLAGS_tuple_num, FLAGS_max_ope,
+                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, false,
                   thid, myres);
 #endif
 
@@ -126,6 +136,7 @@ void worker(size_t thid, char& ready, const bool& start, const bool& quit) {
        */
       storeRelease(myres.local_commit_counts_,
                    loadAcquire(myres.local_commit_counts_) + 1);
+      open_loop.commit(myres);
     } else {
       trans.abort();
       ++myres.local_abort_counts_;
@@ -139,6 +150,7 @@ void worker(size_t thid, char& ready, const bool& start, const bool& quit) {
 int main(int argc, char* argv[]) try {
   gflags::SetUsageMessage("Silo benchmark.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
   chkArg();
   makeDB();
 
@@ -146,15 +158,14 @@ int main(int argc, char* argv[]) try {
   alignas(CACHE_LINE_SIZE) bool quit = false;
   initResult();
   std::vector<char> readys(FLAGS_thread_num);
+  Sampler sampler(SiloResult);
   std::vector<std::thread> thv;
   for (size_t i = 0; i < FLAGS_thread_num; ++i)
     thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                     std::ref(quit));
+                     std::ref(quit), std::ref(sampler));
   waitForReady(readys);
   storeRelease(start, true);
-  for (size_t i = 0; i < FLAGS_extime; ++i) {
-    sleepMs(1000);
-  }
+  sampler.run(FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
   storeRelease(quit, true);
   for (auto& th : thv) th.join();
 
@@ -164,7 +175,9 @@ int main(int argc, char* argv[]) try {
   ShowOptParameters();
   SiloResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime,
                                  FLAGS_thread_num);
+  sampler.display();
 
+  result_export.write();
   return 0;
 } catch (bad_alloc) {
   ERR;
@@ -10,6 +10,9 @@
 
 #include "../include/atomic_wrapper.hh"
 #include "../include/backoff.hh"
+#include "../include/driver.hh"
+#include "../include/result_export.hh"
+#include "../include/sampler.hh"
 #include "include/common.hh"
 #include "include/result.hh"
 #include "include/transaction.hh"
@@ -17,89 +20,61 @@
 
 using namespace std;
 
-void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
-    Xoroshiro128Plus rnd;
-    rnd.init();
-    TxExecutor trans(thid, (Result*) &CicadaResult[thid]);
-    Result &myres = std::ref(CicadaResult[thid]);
-    FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
-    Backoff backoff(FLAGS_clocks_per_us);
-
-#ifdef Linux
-    setThreadAffinity(thid);
-    // printf("Thread #%d: on CPU %d\n", *myid, sched_getcpu());
-    // printf("sysconf(_SC_NPROCESSORS_CONF) %d\n",
-    // sysconf(_SC_NPROCESSORS_CONF));
-#endif  // Linux
-
-#ifdef Darwin
-    int nowcpu;
-    GETCPU(nowcpu);
-    // printf("Thread %d on CPU %d\n", *myid, nowcpu);
-#endif  // Darwin
-
-    storeRelease(ready, 1);
-    while (!loadAcquire(start)) _mm_pause();
-    while (!loadAcquire(quit)) {
-        /* シングル実行で絶対に競合を起こさないワークロードにおいて，
-         * 自トランザクションで read した後に write するのは複雑になる．
-         * write した後に read であれば，write set から read
-         * するので挙動がシンプルになる．
-         * スレッドごとにアクセスブロックを作る形でパーティションを作って
-         * スレッド間の競合を無くした後に sort して同一キーに対しては
-         * write - read とする．
-         * */
+/**
+ * @brief Cicada engine for the driver.
+ */
+class CicadaEngine : public Engine<CicadaEngine> {
+public:
+    CicadaEngine(size_t thid, Result &myres)
+            : trans_(thid, &myres), backoff_(FLAGS_clocks_per_us) {}
+
+    std::vector<Procedure> &procedures() { return trans_.pro_set_; }
+
+    /* シングル実行で絶対に競合を起こさないワークロードにおいて，
+     * 自トランザクションで read した後に write するのは複雑になる．
+     * write した後に read であれば，write set から read
+     * するので挙動がシンプルになる．
+     * スレッドごとにアクセスブロックを作る形でパーティションを作って
+     * スレッド間の競合を無くした後に sort して同一キーに対しては
+     * write - read とする．
+     * */
+    INLINE void prepare() {
 #if SINGLE_EXEC
-        makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
-                      FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, true, thid, myres);
-        sort(trans.pro_set_.begin(), trans.pro_set_.end());
-#else
-#if PARTITION_TABLE
-        makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
-                      FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, true, thid, myres);
-#else
-        makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
-                      FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false, thid, myres);
-#endif
+        sort(trans_.pro_set_.begin(), trans_.pro_set_.end());
 #endif
+    }
 
-RETRY:
-        if (thid == 0) {
-            leaderWork(std::ref(backoff));
+    INLINE void leaderWork() {
+        ::leaderWork(std::ref(backoff_));
 #if BACK_OFF
-            leaderBackoffWork(backoff, CicadaResult);
+        leaderBackoffWork(backoff_, CicadaResult);
 #endif
-        }
-        if (loadAcquire(quit)) break;
-
-        trans.tbegin();
-        for (auto &&itr : trans.pro_set_) {
-            if ((itr).ope_ == Ope::READ) {
-                trans.tread((itr).key_);
-            } else if ((itr).ope_ == Ope::WRITE) {
-                trans.twrite((itr).key_);
-            } else if ((itr).ope_ == Ope::READ_MODIFY_WRITE) {
-                trans.tread((itr).key_);
-                trans.twrite((itr).key_);
-            } else {
-                ERR;
-            }
-
-            if (trans.status_ == TransactionStatus::abort) {
-                trans.earlyAbort();
+    }
+
+    INLINE void begin() { trans_.tbegin(); }
+
+    INLINE void read(uint64_t key) { trans_.tread(key); }
+
+    INLINE void write(uint64_t key) { trans_.twrite(key); }
+
+    INLINE bool aborted() const {
+        return trans_.status_ == TransactionStatus::abort;
+    }
+
+    INLINE void earlyAbort() {
+        trans_.earlyAbort();
 #if SINGLE_EXEC
 #else
-                trans.mainte();
+        trans_.mainte();
 #endif
-                goto RETRY;
-            }
-        }
+    }
 
+    INLINE bool commit() {
         /**
          * Tanabe Optimization for analysis
          */
 #if WORKER1_INSERT_DELAY_RPHASE
-        if (unlikely(thid == 1) && WORKER1_INSERT_DELAY_RPHASE_US != 0) {
+        if (unlikely(trans_.thid_ == 1) && WORKER1_INSERT_DELAY_RPHASE_US != 0) {
           clock_delay(WORKER1_INSERT_DELAY_RPHASE_US * FLAGS_clocks_per_us);
         }
 #endif
@@ -109,82 +84,110 @@ RETRY:
          * A read-only transaction uses (thread.rts) instead,
          * and does not track or validate the read set;
          */
-        if ((*trans.pro_set_.begin()).ronly_) {
-            /**
-             * local_commit_counts is used at ../include/backoff.hh to calcurate about
-             * backoff.
-             */
-            storeRelease(myres.local_commit_counts_,
-                         loadAcquire(myres.local_commit_counts_) + 1);
-        } else {
-            /**
-             * Validation phase
-             */
-            if (!trans.validation()) {
-                trans.abort();
+        if ((*trans_.pro_set_.begin()).ronly_) return true;
+
+        /**
+         * Validation phase
+         */
+        if (!trans_.validation()) return false;
+
+        /**
+         * Write phase
+         */
+        trans_.writePhase();
+        return true;
+    }
+
+    INLINE void abort() {
+        trans_.abort();
 #if SINGLE_EXEC
 #else
-                /**
-                 * Maintenance phase
-                 */
-                trans.mainte();
+        /**
+         * Maintenance phase
+         */
+        trans_.mainte();
 #endif
-                goto RETRY;
-            }
-
-            /**
-             * Write phase
-             */
-            trans.writePhase();
-            /**
-             * local_commit_counts is used at ../include/backoff.hh to calcurate about
-             * backoff.
-             */
-            storeRelease(myres.local_commit_counts_,
-                         loadAcquire(myres.local_commit_counts_) + 1);
-
-            /**
-             * Maintenance phase
-             */
+    }
+
+    INLINE void committed() {
+        /**
+         * Maintenance phase
+         */
 #if SINGLE_EXEC
 #else
-            trans.mainte();
+        if (!(*trans_.pro_set_.begin()).ronly_) trans_.mainte();
 #endif
+    }
+
+    /**
+     * Flush the rest of the group, so that the log includes all the commits
+     * and no worker waits for the pending versions of finished worker.
+     */
+    void finish() {
+        if (FLAGS_group_commit) {
+            if (FLAGS_s_wal) SwalLock.w_lock();
+            trans_.gcpv();
+            if (FLAGS_s_wal) SwalLock.w_unlock();
         }
     }
+
+private:
+    TxExecutor trans_;
+    Backoff backoff_;
+};
+
+void worker(size_t thid, Driver &driver) {
+    CicadaEngine engine(thid, CicadaResult[thid]);
+
+#ifdef Linux
+    setThreadAffinity(thid);
+    // printf("Thread #%d: on CPU %d\n", *myid, sched_getcpu());
+    // printf("sysconf(_SC_NPROCESSORS_CONF) %d\n",
+    // sysconf(_SC_NPROCESSORS_CONF));
+#endif  // Linux
+
+#ifdef Darwin
+    int nowcpu;
+    GETCPU(nowcpu);
+    // printf("Thread %d on CPU %d\n", *myid, nowcpu);
+#endif  // Darwin
+
+    driver.work(engine, thid);
 }
 
 int main(int argc, char* argv[]) try {
     gflags::SetUsageMessage("Cicada benchmark.");
     gflags::ParseCommandLineFlags(&argc, &argv, true);
+    setYcsbZipfSkew(
+        YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len),
+        FLAGS_zipf_skew);
+    ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
     chkArg();
     uint64_t initial_wts;
     makeDB(&initial_wts);
     MinWts.store(initial_wts + 2, memory_order_release);
 
-    alignas(CACHE_LINE_SIZE) bool start = false;
-    alignas(CACHE_LINE_SIZE) bool quit = false;
     initResult();
-    std::vector<char> readys(FLAGS_thread_num);
-    std::vector<std::thread> thv;
-    for (size_t i = 0; i < FLAGS_thread_num; ++i)
-        thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                         std::ref(quit));
-    waitForReady(readys);
-    storeRelease(start, true);
-    for (size_t i = 0; i < FLAGS_extime; ++i) {
-        sleepMs(1000);
-    }
-    storeRelease(quit, true);
-    for (auto &th : thv) th.join();
+#if SINGLE_EXEC || PARTITION_TABLE
+    constexpr bool partition = true;
+#else
+    constexpr bool partition = false;
+#endif
+    Driver driver({FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
+                   FLAGS_rratio, FLAGS_rmw, partition, FLAGS_ycsb,
+                   FLAGS_zipf_skew, FLAGS_arrival_rate, FLAGS_arrival_poisson,
+                   FLAGS_clocks_per_us, FLAGS_trace_record, FLAGS_trace_replay,
+                   YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist,
+                           FLAGS_scan_len)},
+                  CicadaResult);
+    driver.run(worker, FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
 
-    for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-        CicadaResult[0].addLocalAllResult(CicadaResult[i]);
-    }
     ShowOptParameters();
-    CicadaResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime, FLAGS_thread_num);
+    driver.display(FLAGS_extime);
+    if (FLAGS_p_wal || FLAGS_s_wal) displayLogResult();
     deleteDB();
 
+    result_export.write();
     return 0;
 } catch (std::bad_alloc&) {
     ERR;
@@ -7,8 +7,10 @@
 
 #include "../../include/cache_line_size.hh"
 #include "../../include/int64byte.hh"
+#include "../../include/hash_index.hh"
 #include "../../include/masstree_wrapper.hh"
 #include "lock.hh"
+#include "log.hh"
 #include "tuple.hh"
 #include "version.hh"
 
@@ -22,8 +24,12 @@ alignas(CACHE_LINE_SIZE) GLOBAL std::atomic<uint64_t> MinWts(0);
 alignas(
 CACHE_LINE_SIZE) GLOBAL std::atomic<unsigned int> FirstAllocateTimestamp(0);
 #if MASSTREE_USE
+#if HASH_INDEX_USE
+alignas(CACHE_LINE_SIZE) GLOBAL HashIndexWrapper<Tuple> MT; // NOLINT
+#else
 alignas(CACHE_LINE_SIZE) GLOBAL MasstreeWrapper<Tuple> MT; // NOLINT
 #endif
+#endif
 #else
 #define GLOBAL extern
 alignas(CACHE_LINE_SIZE) GLOBAL std::atomic<uint64_t> MinRts;
@@ -31,48 +37,76 @@ alignas(CACHE_LINE_SIZE) GLOBAL std::atomic<uint64_t> MinWts;
 alignas(
 CACHE_LINE_SIZE) GLOBAL std::atomic<unsigned int> FirstAllocateTimestamp;
 #if MASSTREE_USE
+#if HASH_INDEX_USE
+alignas(CACHE_LINE_SIZE) GLOBAL HashIndexWrapper<Tuple> MT;
+#else
 alignas(CACHE_LINE_SIZE) GLOBAL MasstreeWrapper<Tuple> MT;
 #endif
 #endif
+#endif
 
 #ifdef GLOBAL_VALUE_DEFINE
+DEFINE_bool(arrival_poisson, true, "True means Poisson arrivals of the open loop, false means fixed intervals."); // NOLINT
+DEFINE_uint64(arrival_rate, 0, "Offered load of all the worker threads[tps]. 0 means the closed loop."); // NOLINT
 DEFINE_uint64(clocks_per_us, 2100, "CPU_MHz. Use this info for measuring time."); // NOLINT
 DEFINE_uint64(extime, 3, "Execution time[sec]."); // NOLINT
 DEFINE_uint64(gc_inter_us, 10, "GC interval[us]."); // NOLINT
 DEFINE_uint64(group_commit, 0, "Group commit number of transactions."); // NOLINT
 DEFINE_uint64(group_commit_timeout_us, 2, "Timeout used for deadlock resolution when performing group commit[us]."); // NOLINT
-DEFINE_uint64(io_time_ns, 5, "Delay inserted instead of IO."); // NOLINT
+DEFINE_uint64(io_time_ns, 0, "Additional delay after each log flush to emulate slower devices[ns]."); // NOLINT
+DEFINE_string(log_dir, "log", "Directory of log files used by p_wal and s_wal."); // NOLINT
 DEFINE_uint64(max_ope, 10, // NOLINT
               "Total number of operations per single transaction.");
 DEFINE_uint64(pre_reserve_version, 10000, "Pre-allocating memory for the version."); // NOLINT
 DEFINE_bool(p_wal, false, "Parallel write-ahead logging."); // NOLINT
+DEFINE_string(request_dist, "", "uniform, zipfian, latest or hotspot. It overrides the distribution of ycsb_workload."); // NOLINT
+DEFINE_string(result_file, "", "File which the result is appended to in result_format."); // NOLINT
+DEFINE_string(result_format, "", "Format of the exported result, json or csv. Empty means no export."); // NOLINT
 DEFINE_bool(rmw, false, // NOLINT
             "True means read modify write, false means blind write.");
 DEFINE_uint64(rratio, 50, "read ratio of single transaction."); // NOLINT
 DEFINE_bool(s_wal, false, "Normal write-ahead logging."); // NOLINT
+DEFINE_uint64(sample_interval, 0, "Interval of sampling the throughput[msec]. 0 disables the time series."); // NOLINT
+DEFINE_uint64(scan_len, 100, "maximum number of records of a scan of ycsb_workload."); // NOLINT
 DEFINE_uint64(thread_num, 10, "Total number of worker threads."); // NOLINT
+DEFINE_string(trace_record, "", "path prefix of the workload traces to record."); // NOLINT
+DEFINE_string(trace_replay, "", "path prefix of the workload traces to replay."); // NOLINT
 DEFINE_uint64(tuple_num, 1000000, "Total number of records."); // NOLINT
+DEFINE_uint64(warmup, 0, "Warm-up time[sec] before the measured extime. It is excluded from the result."); // NOLINT
 DEFINE_bool(ycsb, true, // NOLINT
             "True uses zipf_skew, false uses faster random generator.");
 DEFINE_uint64(worker1_insert_delay_rphase_us, 0, "Worker 1 insert delay in the end of read phase[us]."); // NOLINT
+DEFINE_string(ycsb_workload, "", "YCSB core workload a ~ f. It overrides rratio and rmw."); // NOLINT
 DEFINE_double(zipf_skew, 0, "zipf skew. 0 ~ 0.999..."); // NOLINT
 #else
+DECLARE_bool(arrival_poisson);
+DECLARE_uint64(arrival_rate);
 DECLARE_uint64(clocks_per_us);
 DECLARE_uint64(extime);
 DECLARE_uint64(gc_inter_us);
 DECLARE_uint64(group_commit);
 DECLARE_uint64(group_commit_timeout_us);
 DECLARE_uint64(io_time_ns);
+DECLARE_string(log_dir);
 DECLARE_uint64(max_ope);
 DECLARE_uint64(pre_reserve_version);
 DECLARE_bool(p_wal);
+DECLARE_string(request_dist);
+DECLARE_string(result_file);
+DECLARE_string(result_format);
 DECLARE_bool(rmw);
 DECLARE_uint64(rratio);
 DECLARE_bool(s_wal);
+DECLARE_uint64(sample_interval);
+DECLARE_uint64(scan_len);
 DECLARE_uint64(thread_num);
+DECLARE_string(trace_record);
+DECLARE_string(trace_replay);
 DECLARE_uint64(tuple_num);
+DECLARE_uint64(warmup);
 DECLARE_bool(ycsb);
 DECLARE_uint64(worker1_insert_delay_rphase_us);
+DECLARE_string(ycsb_workload);
 DECLARE_double(zipf_skew);
 #endif
 
@@ -88,6 +122,8 @@ alignas(CACHE_LINE_SIZE) GLOBAL uint64_t_64byte
 alignas(
 CACHE_LINE_SIZE) GLOBAL Version*** PLogSet;  // [thID][index] pointer array
 alignas(CACHE_LINE_SIZE) GLOBAL Version** SLogSet;  // [index] pointer array
+alignas(CACHE_LINE_SIZE) GLOBAL LogBuffer* PLogBuffer;  // [thID]
+alignas(CACHE_LINE_SIZE) GLOBAL LogBuffer SLogBuffer;
 GLOBAL RWLock SwalLock;
 [[maybe_unused]] GLOBAL  RWLock CtrLock;
 
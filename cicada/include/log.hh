@@ -0,0 +1,105 @@
+#pragma once
+
+#include <string.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../include/fileio.hh"
+#include "../../include/tsc.hh"
+
+class LogHeader {
+public:
+  int chkSum_ = 0;
+  unsigned int logRecNum_ = 0;
+
+  void init() {
+    chkSum_ = 0;
+    logRecNum_ = 0;
+  }
+
+  void convertChkSumIntoComplementOnTwo() {
+    chkSum_ ^= 0xffffffff;
+    ++chkSum_;
+  }
+};
+
+class LogRecord {
+public:
+  uint64_t wts_;
+  uint64_t key_;
+  char val_[VAL_SIZE];
+
+  LogRecord() : wts_(0), key_(0) {}
+
+  LogRecord(uint64_t wts, uint64_t key, char *val) : wts_(wts), key_(key) {
+    memcpy(this->val_, val, VAL_SIZE);
+  }
+
+  int computeChkSum() {
+    // compute checksum
+    int chkSum = 0;
+    int *itr = (int *) this;
+    for (unsigned int i = 0; i < sizeof(LogRecord) / sizeof(int); ++i) {
+      chkSum += (*itr);
+      ++itr;
+    }
+
+    return chkSum;
+  }
+};
+
+/**
+ * @brief Log buffer and its log file.
+ * @details Records are batched in the buffer and written with its header by
+ * one flush, which ends with fdatasync. p_wal uses one per worker thread and
+ * s_wal uses one shared buffer under SwalLock.
+ */
+class LogBuffer {
+public:
+  LogHeader header_;
+  std::vector<LogRecord> records_;
+  File logfile_;
+  uint64_t byte_count_ = 0;
+  uint64_t flush_count_ = 0;
+
+  void init(const std::string &path, std::size_t capacity) {
+    if (!logfile_.open(path, O_CREAT | O_TRUNC | O_WRONLY, 0644)) ERR;
+    records_.reserve(capacity);
+    header_.init();
+  }
+
+  void add(uint64_t wts, uint64_t key, char *val) {
+    records_.emplace_back(wts, key, val);
+    header_.chkSum_ += records_.back().computeChkSum();
+    ++header_.logRecNum_;
+  }
+
+  bool empty() { return records_.empty(); }
+
+  /**
+   * @brief write the buffered records and make them durable.
+   * @param [in] delay_clocks additional delay to emulate slower devices.
+   */
+  void flush(uint64_t delay_clocks) {
+    if (records_.empty()) return;
+
+    header_.convertChkSumIntoComplementOnTwo();
+    logfile_.write((void *) &header_, sizeof(LogHeader));
+    logfile_.write((void *) records_.data(),
+                   sizeof(LogRecord) * header_.logRecNum_);
+    logfile_.fdatasync();
+    byte_count_ += sizeof(LogHeader) + sizeof(LogRecord) * header_.logRecNum_;
+    ++flush_count_;
+
+    if (delay_clocks) {
+      uint64_t spinstart = rdtscp();
+      while ((rdtscp() - spinstart) < delay_clocks) {
+      }  // spin-wait
+    }
+
+    header_.init();
+    records_.clear();
+  }
+};
@@ -103,7 +103,7 @@ public:
   void earlyAbort();
 
   void mainte();  // maintenance
-  void gcpv();    // group commit pending versions
+  void gcpv();    // flush log and group commit pending versions
   void precpv();  // pre-commit pending versions
   void pwal();    // parallel write ahead log.
   void swal();
@@ -112,6 +112,18 @@ public:
 
   void tread(const uint64_t key);
 
+  /**
+   * @brief Wait for the result of the pending version.
+   * @details With group commit, the version may be pending until the group of
+   * other transaction is flushed, and that transaction may also wait for the
+   * pending versions of this worker. So it flushes its own group on timeout.
+   */
+  void waitPending(Version *ver) {
+    while (ver->ldAcqStatus() == VersionStatus::pending) {
+      if (FLAGS_group_commit) chkGcpvTimeout();
+    }
+  }
+
   void twrite(const uint64_t key);
 
   bool validation();
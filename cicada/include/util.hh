@@ -14,6 +14,8 @@ extern void deleteDB();
 
 [[maybe_unused]] extern void displayMinWts();
 
+extern void displayLogResult();
+
 extern void displayParameter();
 
 [[maybe_unused]] extern void displaySLogSet();
@@ -22,6 +24,8 @@ extern void displayParameter();
 
 [[maybe_unused]] extern void displayThreadRtsArray();
 
+extern void initLog();
+
 extern void leaderWork([[maybe_unused]] Backoff &backoff);
 
 extern void makeDB(uint64_t *initial_wts);
@@ -140,8 +140,7 @@ void TxExecutor::tread(const uint64_t key) {
     /**
      * Wait for the result of the pending version in the view.
      */
-    while (ver->status_.load(memory_order_acquire) == VersionStatus::pending) {
-    }
+    waitPending(ver);
     if (ver->status_.load(memory_order_acquire) == VersionStatus::aborted) {
       ver = ver->ldAcqNext();
     }
@@ -163,7 +162,7 @@ void TxExecutor::tread(const uint64_t key) {
 #if INLINE_VERSION_OPT
 #if INLINE_VERSION_PROMOTION
 #if ADD_ANALYSIS
-  cres_->local_read_latency_ += rdtscp() - start;
+  cres_->recordReadLatency(rdtscp() - start);
 #endif  // if ADD_ANALYSIS
   inlineVersionPromotion(key, tuple, later_ver, ver);
   goto END_TREAD;
@@ -173,7 +172,7 @@ void TxExecutor::tread(const uint64_t key) {
 FINISH_TREAD:
 
 #if ADD_ANALYSIS
-  cres_->local_read_latency_ += rdtscp() - start;
+  cres_->recordReadLatency(rdtscp() - start);
 #endif
 
   END_TREAD:
@@ -287,7 +286,7 @@ void TxExecutor::twrite(const uint64_t key) {
 FINISH_TWRITE:
 
 #if ADD_ANALYSIS
-  cres_->local_write_latency_ += rdtscp() - start;
+  cres_->recordWriteLatency(rdtscp() - start);
 #endif  // if ADD_ANALYSIS
 
   return;
@@ -375,10 +374,10 @@ bool TxExecutor::validation() {
     while (ver->ldAcqWts() >= this->wts_.ts_) ver = ver->ldAcqNext();
     // if write after read occured, it may happen "==".
 
-    while (ver->ldAcqStatus() == VersionStatus::pending);
+    waitPending(ver);
     while (ver->ldAcqStatus() != VersionStatus::committed) {
       ver = ver->ldAcqNext();
-      while (ver->ldAcqStatus() == VersionStatus::pending);
+      waitPending(ver);
     }
     /**
      * This part is different from the original.
@@ -397,10 +396,10 @@ bool TxExecutor::validation() {
    */
   for (auto itr = write_set_.begin(); itr != write_set_.end(); ++itr) {
     Version *ver = (*itr).new_ver_->ldAcqNext();
-    while (ver->ldAcqStatus() == VersionStatus::pending);
+    waitPending(ver);
     while (ver->ldAcqStatus() != VersionStatus::committed) {
       ver = ver->ldAcqNext();
-      while (ver->ldAcqStatus() == VersionStatus::pending);
+      waitPending(ver);
     }
 
     if (ver->ldAcqRts() > this->wts_.ts_) {
@@ -411,32 +410,32 @@ bool TxExecutor::validation() {
 
 FINISH_VALIDATION:
 #if ADD_ANALYSIS
-  cres_->local_vali_latency_ += rdtscp() - start;
+  cres_->recordValiLatency(rdtscp() - start);
 #endif  // if ADD_ANALYSIS
   return result;
 }
 
+/**
+ * @brief Delay inserted after each log flush to emulate slower devices.
+ */
+static uint64_t ioDelayClocks() {
+  return FLAGS_clocks_per_us * FLAGS_io_time_ns / 1000;
+}
+
 void TxExecutor::swal() {
   if (!FLAGS_group_commit) {  // non-group commit
     SwalLock.w_lock();
-
-    int i = 0;
     for (auto itr = write_set_.begin(); itr != write_set_.end(); ++itr) {
-      SLogSet[i] = (*itr).new_ver_;
-      ++i;
+      SLogBuffer.add(this->wts_.ts_, (*itr).key_, write_val_);
     }
-
-    double threshold = FLAGS_clocks_per_us * FLAGS_io_time_ns / 1000;
-    uint64_t spinstart = rdtscp();
-    while ((rdtscp() - spinstart) < threshold) {
-    }  // spin-wait
-
+    SLogBuffer.flush(ioDelayClocks());
     SwalLock.w_unlock();
   } else {  // group commit
     SwalLock.w_lock();
     for (auto itr = write_set_.begin(); itr != write_set_.end(); ++itr) {
       SLogSet[GROUP_COMMIT_INDEX[0].obj_] = (*itr).new_ver_;
       ++GROUP_COMMIT_INDEX[0].obj_;
+      SLogBuffer.add(this->wts_.ts_, (*itr).key_, write_val_);
     }
 
     if (GROUP_COMMIT_COUNTER[0].obj_ == 0) {
@@ -446,12 +445,7 @@ void TxExecutor::swal() {
     ++GROUP_COMMIT_COUNTER[0].obj_;
 
     if (GROUP_COMMIT_COUNTER[0].obj_ == FLAGS_group_commit) {
-      double threshold = FLAGS_clocks_per_us * FLAGS_io_time_ns / 1000;
-      uint64_t spinstart = rdtscp();
-      while ((rdtscp() - spinstart) < threshold) {
-      }  // spin-wait
-
-      // group commit pending version.
+      // flush log and group commit pending version.
       gcpv();
     }
     SwalLock.w_unlock();
@@ -460,21 +454,15 @@ void TxExecutor::swal() {
 
 void TxExecutor::pwal() {
   if (!FLAGS_group_commit) {
-    int i = 0;
     for (auto itr = write_set_.begin(); itr != write_set_.end(); ++itr) {
-      PLogSet[thid_][i] = (*itr).new_ver_;
-      ++i;
+      PLogBuffer[thid_].add(this->wts_.ts_, (*itr).key_, write_val_);
     }
-
-    // it gives lat ency instead of flush.
-    double threshold = FLAGS_clocks_per_us * FLAGS_io_time_ns / 1000;
-    uint64_t spinstart = rdtscp();
-    while ((rdtscp() - spinstart) < threshold) {
-    }  // spin-wait
+    PLogBuffer[thid_].flush(ioDelayClocks());
   } else {
     for (auto itr = write_set_.begin(); itr != write_set_.end(); ++itr) {
       PLogSet[thid_][GROUP_COMMIT_INDEX[thid_].obj_] = (*itr).new_ver_;
       ++GROUP_COMMIT_INDEX[this->thid_].obj_;
+      PLogBuffer[thid_].add(this->wts_.ts_, (*itr).key_, write_val_);
     }
 
     if (GROUP_COMMIT_COUNTER[this->thid_].obj_ == 0) {
@@ -485,12 +473,7 @@ void TxExecutor::pwal() {
     ++GROUP_COMMIT_COUNTER[this->thid_].obj_;
 
     if (GROUP_COMMIT_COUNTER[this->thid_].obj_ == FLAGS_group_commit) {
-      // it gives latency instead of flush.
-      double threshold = FLAGS_clocks_per_us * FLAGS_io_time_ns / 1000;
-      uint64_t spinstart = rdtscp();
-      while ((rdtscp() - spinstart) < threshold) {
-      }  // spin-wait
-
+      // flush log and group commit pending version.
       gcpv();
     }
   }
@@ -524,14 +507,33 @@ inline void TxExecutor::cpv()  // commit pending versions
   }
 }
 
+/**
+ * @brief Pre-commit pending versions.
+ * @details It is used by group commit. It writes the payload and schedules
+ * garbage collection, but the versions stay pending until gcpv() makes them
+ * committed after the log of the group is durable.
+ */
+void TxExecutor::precpv() {
+  for (auto itr = write_set_.begin(); itr != write_set_.end(); ++itr) {
+    memcpy((*itr).new_ver_->val_, write_val_, VAL_SIZE);
+    gcq_.emplace_back(GCElement((*itr).key_, (*itr).rcdptr_, (*itr).new_ver_,
+                                this->wts_.ts_));
+    ++(*itr).rcdptr_->continuing_commit_;
+  }
+}
+
 void TxExecutor::gcpv() {
   if (FLAGS_s_wal) {
+    if (GROUP_COMMIT_COUNTER[0].obj_ == 0) return;
+    SLogBuffer.flush(ioDelayClocks());
     for (unsigned int i = 0; i < GROUP_COMMIT_INDEX[0].obj_; ++i) {
       SLogSet[i]->status_.store(VersionStatus::committed, memory_order_release);
     }
     GROUP_COMMIT_COUNTER[0].obj_ = 0;
     GROUP_COMMIT_INDEX[0].obj_ = 0;
   } else if (FLAGS_p_wal) {
+    if (GROUP_COMMIT_COUNTER[thid_].obj_ == 0) return;
+    PLogBuffer[thid_].flush(ioDelayClocks());
     for (unsigned int i = 0; i < GROUP_COMMIT_INDEX[thid_].obj_; ++i) {
       PLogSet[thid_][i]->status_.store(VersionStatus::committed,
                                        memory_order_release);
@@ -551,7 +553,6 @@ void TxExecutor::earlyAbort() {
 
   this->wts_.set_clockBoost(FLAGS_clocks_per_us);
   this->status_ = TransactionStatus::abort;
-  ++cres_->local_abort_counts_;
 
 #if BACK_OFF
   backoff();
@@ -572,7 +573,6 @@ void TxExecutor::abort() {
   }
 
   this->wts_.set_clockBoost(FLAGS_clocks_per_us);
-  ++cres_->local_abort_counts_;
 
 #if BACK_OFF
   backoff();
@@ -602,6 +602,8 @@ bool TxExecutor::chkGcpvTimeout() {
       SwalLock.w_lock();
       gcpv();
       SwalLock.w_unlock();
+      // the group may be started by other thread.
+      grpcmt_start_ = grpcmt_stop_;
       return true;
     }
   }
@@ -674,7 +676,7 @@ void TxExecutor::mainte() {
   }
   //-----
 #if ADD_ANALYSIS
-  cres_->local_gc_latency_ += rdtscp() - start;
+  cres_->recordGCLatency(rdtscp() - start);
 #endif
 }
 
@@ -683,16 +685,19 @@ void TxExecutor::writePhase() {
   uint64_t start = rdtscp();
 #endif
   if (FLAGS_group_commit) {
+    precpv();
+    // log write set & possibly group commit pending version
+    if (FLAGS_p_wal) pwal();
+    if (FLAGS_s_wal) swal();
     // check time out of commit pending versions
     chkGcpvTimeout();
   } else {
+    // the log must be durable before the versions are committed.
+    if (FLAGS_p_wal) pwal();
+    if (FLAGS_s_wal) swal();
     cpv();
   }
 
-  /* log write set & possibly group commit pending version
-  if (FLAGS_p_wal) pwal();
-  if (FLAGS_s_wal) swal();*/
-
   this->wts_.set_clockBoost(0);
   read_set_.clear();
   write_set_.clear();
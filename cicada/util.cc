@@ -1,10 +1,14 @@
 
+#include <algorithm>
 #include <atomic>
 #include <bitset>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <string>
+
+#include "boost/filesystem.hpp"
 
 // ccbench/cicada/include
 #include "include/common.hh"
@@ -38,6 +42,16 @@ void chkArg() {
         exit(0);
     }
 
+    if (FLAGS_p_wal && FLAGS_s_wal) {
+        SPDLOG_INFO("p_wal and s_wal are exclusive.");
+        ERR;
+    }
+
+    if (FLAGS_group_commit && !FLAGS_p_wal && !FLAGS_s_wal) {
+        SPDLOG_INFO("group_commit needs p_wal or s_wal.");
+        ERR;
+    }
+
     if (posix_memalign((void**) &ThreadRtsArrayForGroup, CACHE_LINE_SIZE,
                        FLAGS_thread_num * sizeof(uint64_t_64byte)) != 0)
         ERR;
@@ -77,6 +91,8 @@ void chkArg() {
         ThreadWtsArray[i].obj_ = 0;
         ThreadRtsArrayForGroup[i].obj_ = 0;
     }
+
+    if (FLAGS_p_wal || FLAGS_s_wal) initLog();
 }
 
 [[maybe_unused]] void displayDB() {
@@ -130,22 +146,50 @@ void chkArg() {
 
 [[maybe_unused]] void displayMinWts() { cout << "MinWts:  " << MinWts << endl << endl; }
 
+void displayLogResult() {
+    uint64_t byte_count = 0;
+    uint64_t flush_count = 0;
+    if (FLAGS_p_wal) {
+        for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
+            byte_count += PLogBuffer[i].byte_count_;
+            flush_count += PLogBuffer[i].flush_count_;
+        }
+    } else if (FLAGS_s_wal) {
+        byte_count = SLogBuffer.byte_count_;
+        flush_count = SLogBuffer.flush_count_;
+    }
+    cout << "log_bytes:\t" << byte_count << endl;
+    cout << "fdatasync_counts:\t" << flush_count << endl;
+}
+
 void displayParameter() {
+    cout << "#FLAGS_arrival_poisson:\t\t\t" << FLAGS_arrival_poisson << endl;
+    cout << "#FLAGS_arrival_rate:\t\t\t" << FLAGS_arrival_rate << endl;
     cout << "#FLAGS_clocks_per_us:\t\t\t" << FLAGS_clocks_per_us << endl;
     cout << "#FLAGS_extime:\t\t\t\t" << FLAGS_extime << endl;
     cout << "#FLAGS_gc_inter_us:\t\t\t" << FLAGS_gc_inter_us << endl;
     cout << "#FLAGS_group_commit:\t\t\t" << FLAGS_group_commit << endl;
     cout << "#FLAGS_group_commit_timeout_us:\t\t" << FLAGS_group_commit_timeout_us << endl;
     cout << "#FLAGS_io_time_ns:\t\t\t" << FLAGS_io_time_ns << endl;
+    cout << "#FLAGS_log_dir:\t\t\t\t" << FLAGS_log_dir << endl;
     cout << "#FLAGS_max_ope:\t\t\t\t" << FLAGS_max_ope << endl;
     cout << "#FLAGS_pre_reserve_version:\t\t" << FLAGS_pre_reserve_version << endl;
     cout << "#FLAGS_p_wal:\t\t\t\t" << FLAGS_p_wal << endl;
+    cout << "#FLAGS_request_dist:\t\t\t" << FLAGS_request_dist << endl;
+    cout << "#FLAGS_result_file:\t\t\t" << FLAGS_result_file << endl;
+    cout << "#FLAGS_result_format:\t\t\t" << FLAGS_result_format << endl;
     cout << "#FLAGS_rmw:\t\t\t\t" << FLAGS_rmw << endl;
     cout << "#FLAGS_rratio:\t\t\t\t" << FLAGS_rratio << endl;
     cout << "#FLAGS_s_wal:\t\t\t\t" << FLAGS_s_wal << endl;
+    cout << "#FLAGS_sample_interval:\t\t\t" << FLAGS_sample_interval << endl;
+    cout << "#FLAGS_scan_len:\t\t\t" << FLAGS_scan_len << endl;
     cout << "#FLAGS_thread_num:\t\t\t" << FLAGS_thread_num << endl;
+    cout << "#FLAGS_trace_record:\t\t\t" << FLAGS_trace_record << endl;
+    cout << "#FLAGS_trace_replay:\t\t\t" << FLAGS_trace_replay << endl;
+    cout << "#FLAGS_warmup:\t\t\t\t" << FLAGS_warmup << endl;
     cout << "#FLAGS_ycsb:\t\t\t\t" << FLAGS_ycsb << endl;
     cout << "#FLAGS_worker1_insert_delay_rphase_us:\t" << FLAGS_worker1_insert_delay_rphase_us << endl;
+    cout << "#FLAGS_ycsb_workload:\t\t\t" << FLAGS_ycsb_workload << endl;
     cout << "#FLAGS_zipf_skew:\t\t\t" << FLAGS_zipf_skew << endl;
 }
 
@@ -250,9 +294,36 @@ void deleteDB() {
     delete SLogSet;
     for (uint i = 0; i < FLAGS_thread_num; ++i) delete PLogSet[i];
     delete PLogSet;
+    delete[] PLogBuffer;
+}
+
+void initLog() {
+    const boost::filesystem::path log_dir_path(FLAGS_log_dir);
+    if (!boost::filesystem::exists(log_dir_path)) {
+        boost::system::error_code error;
+        const bool result = boost::filesystem::create_directories(log_dir_path, error);
+        if (!result || error) ERR;
+    }
+
+    /**
+     * A log buffer holds the write sets of a group.
+     */
+    std::size_t capacity = FLAGS_max_ope * std::max<uint64_t>(FLAGS_group_commit, 1);
+    if (FLAGS_p_wal) {
+        PLogBuffer = new LogBuffer[FLAGS_thread_num];
+        for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
+            PLogBuffer[i].init(FLAGS_log_dir + "/plog" + std::to_string(i), capacity);
+        }
+    } else {
+        // all the worker threads share the log buffer.
+        SLogBuffer.init(FLAGS_log_dir + "/slog", capacity);
+    }
 }
 
 void makeDB(uint64_t* initial_wts) {
+#if MASSTREE_USE
+    MT.reserve(FLAGS_tuple_num);
+#endif
     if (posix_memalign((void**) &Table, PAGE_SIZE, FLAGS_tuple_num * sizeof(Tuple)) !=
         0)
         ERR;
@@ -321,6 +392,7 @@ void ShowOptParameters() {
          << ": ADD_ANALYSIS " << ADD_ANALYSIS << ": BACK_OFF " << BACK_OFF
          << ": INLINE_VERSION_OPT " << INLINE_VERSION_OPT
          << ": INLINE_VERSION_PROMOTION " << INLINE_VERSION_PROMOTION
+         << ": HASH_INDEX_USE " << HASH_INDEX_USE
          << ": MASSTREE_USE " << MASSTREE_USE << ": PARTITION_TABLE "
          << PARTITION_TABLE << ": REUSE_VERSION " << REUSE_VERSION
          << ": SINGLE_EXEC " << SINGLE_EXEC << ": KEY_SIZE " << KEY_SIZE
@@ -2,6 +2,7 @@
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <string>
 
 #include "../include/debug.hh"
 #include "../include/result.hh"
@@ -28,6 +29,65 @@ void Result::displayCommitCounts() {
   cout << "commit_counts_:\t" << total_commit_counts_ << endl;
 }
 
+/**
+ * @brief num / den, or 0 if den is 0.
+ * @details Every display function prints its key even if the value is 0, so
+ * that the set of keys of a run does not depend on the values (a CSV export
+ * has one header for all the runs).
+ */
+static long double ratio(long double num, long double den) {
+  return den == 0 ? 0 : num / den;
+}
+
+void Result::displayDurableCommit(size_t clocks_per_us, size_t extime) {
+  cout << "durable_commit_counts:\t" << total_durable_commit_counts_ << endl;
+  cout << "durable_throughput[tps]:\t"
+       << total_durable_commit_counts_ / extime << endl;
+  long double ave_latency =
+      ratio((long double) total_durable_latency_,
+            (long double) total_durable_commit_counts_) /
+      (long double) clocks_per_us;
+  cout << fixed << setprecision(4) << "durable_latency[us]:\t" << ave_latency
+       << endl;
+}
+
+/**
+ * @brief display p50, p99, p99.9 and max of the histogram.
+ * @param [in] divisor it divides the values, e.g. clocks_per_us.
+ */
+static void displayPercentiles(const std::string &name, const std::string &unit,
+                               const Histogram &hist, long double divisor) {
+  cout << fixed << setprecision(4);
+  cout << name << "_p50" << unit << ":\t"
+       << (long double) hist.percentile(0.5) / divisor << endl;
+  cout << name << "_p99" << unit << ":\t"
+       << (long double) hist.percentile(0.99) / divisor << endl;
+  cout << name << "_p99.9" << unit << ":\t"
+       << (long double) hist.percentile(0.999) / divisor << endl;
+  cout << name << "_max" << unit << ":\t" << (long double) hist.max() / divisor
+       << endl;
+}
+
+void Result::displayLatencyPercentiles(size_t clocks_per_us) {
+  cout << fixed << setprecision(4) << "queueing_delay[us]:\t"
+       << ratio((long double) total_queueing_delay_,
+                (long double) total_latency_hist_.count()) /
+          (long double) clocks_per_us
+       << endl;
+  displayPercentiles("latency", "[us]", total_latency_hist_, clocks_per_us);
+  displayPercentiles("retry", "", total_retry_hist_, 1);
+#if ADD_ANALYSIS
+  displayPercentiles("read_latency", "[us]", total_read_latency_hist_,
+                     clocks_per_us);
+  displayPercentiles("vali_latency", "[us]", total_vali_latency_hist_,
+                     clocks_per_us);
+  displayPercentiles("write_latency", "[us]", total_write_latency_hist_,
+                     clocks_per_us);
+  displayPercentiles("gc_latency", "[us]", total_gc_latency_hist_,
+                     clocks_per_us);
+#endif
+}
+
 void Result::displayTps(size_t extime, size_t thread_num) {
   uint64_t result = total_commit_counts_ / extime;
   cout << "latency[ns]:\t" << powl(10.0, 9.0) / result * thread_num << endl;
@@ -36,58 +96,58 @@ void Result::displayTps(size_t extime, size_t thread_num) {
 
 #if ADD_ANALYSIS
 void Result::displayAbortByOperationRate() {
-  if (total_abort_by_operation_) {
-    long double rate;
-    rate = (long double)total_abort_by_operation_ /
-           (long double)total_abort_counts_;
-    cout << "abort_by_operation:\t" << total_abort_by_operation_ << endl;
-    cout << fixed << setprecision(4) << "abort_by_operation_rate:\t" << rate
-         << endl;
-  }
+  long double rate;
+  rate = ratio((long double)total_abort_by_operation_,
+               (long double)total_abort_counts_);
+  cout << "abort_by_operation:\t" << total_abort_by_operation_ << endl;
+  cout << fixed << setprecision(4) << "abort_by_operation_rate:\t" << rate
+       << endl;
 }
 
 void Result::displayAbortByValidationRate() {
-  if (total_abort_by_validation_) {
-    long double rate;
-    rate = (double)total_abort_by_validation_ / (double)total_abort_counts_;
-    cout << "abort_by_validation:\t" << total_abort_by_validation_ << endl;
-    cout << fixed << setprecision(4) << "abort_by_validation_rate:\t" << rate
-         << endl;
-  }
+  long double rate;
+  rate = ratio((long double)total_abort_by_validation_,
+               (long double)total_abort_counts_);
+  cout << "abort_by_validation:\t" << total_abort_by_validation_ << endl;
+  cout << fixed << setprecision(4) << "abort_by_validation_rate:\t" << rate
+       << endl;
 }
 
 void Result::displayCommitLatencyRate(size_t clocks_per_us, size_t extime,
                                       size_t thread_num) {
-  if (total_commit_latency_) {
-    long double rate;
-    rate =
-        (long double)total_commit_latency_ /
-        ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
-        thread_num;
-    cout << fixed << setprecision(4) << "commit_latency_rate:\t" << rate
-         << endl;
-  }
+  long double rate;
+  rate =
+      (long double)total_commit_latency_ /
+      ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
+      thread_num;
+  cout << fixed << setprecision(4) << "commit_latency_rate:\t" << rate
+       << endl;
 }
 
 void Result::displayBackoffLatencyRate(size_t clocks_per_us, size_t extime,
                                        size_t thread_num) {
-  if (total_backoff_latency_) {
-    long double rate;
-    rate =
-        (long double)total_backoff_latency_ /
-        ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
-        thread_num;
-    cout << fixed << setprecision(4) << "backoff_latency_rate:\t" << rate
-         << endl;
-  }
+  long double rate;
+  rate =
+      (long double)total_backoff_latency_ /
+      ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
+      thread_num;
+  cout << fixed << setprecision(4) << "backoff_latency_rate:\t" << rate
+       << endl;
+}
+
+void Result::displayAbsentAborts() {
+  cout << "absent_aborts:\t" << total_absent_aborts_ << endl;
+}
+
+void Result::displayDeleteCounts() {
+  cout << "delete_counts:\t" << total_delete_counts_ << endl;
 }
 
 void Result::displayEarlyAbortRate() {
-  if (total_early_aborts_) {
-    cout << fixed << setprecision(4) << "early_abort_rate:\t"
-         << (long double)total_early_aborts_ / (long double)total_abort_counts_
-         << endl;
-  }
+  cout << fixed << setprecision(4) << "early_abort_rate:\t"
+       << ratio((long double)total_early_aborts_,
+                (long double)total_abort_counts_)
+       << endl;
 }
 
 void Result::displayExtraReads() {
@@ -95,49 +155,45 @@ void Result::displayExtraReads() {
 }
 
 void Result::displayGCCounts() {
-  if (total_gc_counts_) cout << "gc_counts:\t" << total_gc_counts_ << endl;
+  cout << "gc_counts:\t" << total_gc_counts_ << endl;
 }
 
 void Result::displayGCLatencyRate(size_t clocks_per_us, size_t extime,
                                   size_t thread_num) {
-  if (total_gc_latency_) {
-    long double rate;
-    rate =
-        (long double)total_gc_latency_ /
-        ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
-        thread_num;
-    cout << fixed << setprecision(4) << "gc_latency_rate:\t" << rate << endl;
-  }
+  long double rate;
+  rate =
+      (long double)total_gc_latency_ /
+      ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
+      thread_num;
+  cout << fixed << setprecision(4) << "gc_latency_rate:\t" << rate << endl;
 }
 
 void Result::displayGCTMTElementsCounts() {
-  if (total_gc_TMT_elements_counts_)
-    cout << "gc_TMT_elements_counts:\t" << total_gc_TMT_elements_counts_
-         << endl;
+  cout << "gc_TMT_elements_counts:\t" << total_gc_TMT_elements_counts_
+       << endl;
 }
 
 void Result::displayGCVersionCounts() {
-  if (total_gc_version_counts_)
-    cout << "gc_version_counts:\t" << total_gc_version_counts_ << endl;
+  cout << "gc_version_counts:\t" << total_gc_version_counts_ << endl;
+}
+
+void Result::displayInsertCounts() {
+  cout << "insert_counts:\t" << total_insert_counts_ << endl;
 }
 
 void Result::displayMakeProcedureLatencyRate(size_t clocks_per_us,
                                              size_t extime, size_t thread_num) {
-  if (total_make_procedure_latency_) {
-    long double rate;
-    rate =
-        (long double)total_make_procedure_latency_ /
-        ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
-        thread_num;
-    cout << fixed << setprecision(4) << "make_procedure_latency_rate:\t" << rate
-         << endl;
-  }
+  long double rate;
+  rate =
+      (long double)total_make_procedure_latency_ /
+      ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
+      thread_num;
+  cout << fixed << setprecision(4) << "make_procedure_latency_rate:\t" << rate
+       << endl;
 }
 
 void Result::displayMemcpys() {
-  if (total_memcpys) {
-    cout << "memcpys:\t" << total_memcpys << endl;
-  }
+  cout << "memcpys:\t" << total_memcpys << endl;
 }
 
 void Result::displayOtherWorkLatencyRate(size_t clocks_per_us, size_t extime,
@@ -180,108 +236,97 @@ void Result::displayOtherWorkLatencyRate(size_t clocks_per_us, size_t extime,
 }
 
 void Result::displayPreemptiveAbortsCounts() {
-  if (total_preemptive_aborts_counts_)
-    cout << "preemptive_aborts_counts:\t" << total_preemptive_aborts_counts_
-         << endl;
+  cout << "preemptive_aborts_counts:\t" << total_preemptive_aborts_counts_
+       << endl;
 }
 
 void Result::displayRatioOfPreemptiveAbortToTotalAbort() {
-  if (total_preemptive_aborts_counts_) {
-    long double rate;
-    rate =
-        (double)total_preemptive_aborts_counts_ / (double)total_abort_counts_;
-    cout << fixed << setprecision(4)
-         << "ratio_of_preemptive_abort_to_total_abort:\t" << rate << endl;
-  }
+  long double rate;
+  rate = ratio((long double)total_preemptive_aborts_counts_,
+               (long double)total_abort_counts_);
+  cout << fixed << setprecision(4)
+       << "ratio_of_preemptive_abort_to_total_abort:\t" << rate << endl;
 }
 
 void Result::displayReadLatencyRate(size_t clocks_per_us, size_t extime,
                                     size_t thread_num) {
-  if (total_read_latency_) {
-    long double rate;
-    rate =
-        (long double)total_read_latency_ /
-        ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
-        thread_num;
-    cout << fixed << setprecision(4) << "read_latency_rate:\t" << rate << endl;
-  }
+  long double rate;
+  rate =
+      (long double)total_read_latency_ /
+      ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
+      thread_num;
+  cout << fixed << setprecision(4) << "read_latency_rate:\t" << rate << endl;
 }
 
 void Result::displayRtsupdRate() {
-  if (total_rtsupd_chances_) {
-    long double rate;
-    rate = (double)total_rtsupd_ /
-           ((double)total_rtsupd_ + (double)total_rtsupd_chances_);
-    cout << fixed << setprecision(4) << "rtsupd_rate:\t" << rate << endl;
-  }
+  long double rate;
+  rate = ratio((long double)total_rtsupd_,
+               (long double)total_rtsupd_ + (long double)total_rtsupd_chances_);
+  cout << fixed << setprecision(4) << "rtsupd_rate:\t" << rate << endl;
+}
+
+void Result::displayTemperatureFalseLockRate() {
+  cout << "temperature_locks:\t" << total_temperature_locks_ << endl;
+  long double rate = ratio((long double)total_temperature_false_locks_,
+                           (long double)total_temperature_locks_);
+  cout << fixed << setprecision(4) << "temperature_false_lock_rate:\t" << rate
+       << endl;
 }
 
 void Result::displayTemperatureResets() {
-  if (total_temperature_resets_)
-    cout << "temperature_resets:\t" << total_temperature_resets_ << endl;
+  cout << "temperature_resets:\t" << total_temperature_resets_ << endl;
 }
 
 void Result::displayTimestampHistorySuccessCounts() {
-  if (total_timestamp_history_success_counts_)
-    cout << "timestamp_history_success_counts:\t"
-         << total_timestamp_history_success_counts_ << endl;
+  cout << "timestamp_history_success_counts:\t"
+       << total_timestamp_history_success_counts_ << endl;
 }
 
 void Result::displayTimestampHistoryFailCounts() {
-  if (total_timestamp_history_fail_counts_)
-    cout << "timestamp_history_fail_counts:\t"
-         << total_timestamp_history_fail_counts_ << endl;
+  cout << "timestamp_history_fail_counts:\t"
+       << total_timestamp_history_fail_counts_ << endl;
 }
 
 void Result::displayTreeTraversal() {
-  if (total_tree_traversal_)
-    cout << "tree_traversal:\t" << total_tree_traversal_ << endl;
+  cout << "tree_traversal:\t" << total_tree_traversal_ << endl;
 }
 
 void Result::displayTMTElementMalloc() {
-  if (total_TMT_element_malloc_)
-    cout << "TMT_element_malloc:\t" << total_TMT_element_malloc_ << endl;
+  cout << "TMT_element_malloc:\t" << total_TMT_element_malloc_ << endl;
 }
 
 void Result::displayTMTElementReuse() {
-  if (total_TMT_element_reuse_)
-    cout << "TMT_element_reuse:\t" << total_TMT_element_reuse_ << endl;
+  cout << "TMT_element_reuse:\t" << total_TMT_element_reuse_ << endl;
 }
 
 void Result::displayValiLatencyRate(size_t clocks_per_us, size_t extime,
                                     size_t thread_num) {
-  if (total_vali_latency_) {
-    long double rate;
-    rate =
-        (long double)total_vali_latency_ /
-        ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
-        thread_num;
-    cout << fixed << setprecision(4) << "vali_latency_rate:\t" << rate << endl;
-  }
+  long double rate;
+  rate =
+      (long double)total_vali_latency_ /
+      ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
+      thread_num;
+  cout << fixed << setprecision(4) << "vali_latency_rate:\t" << rate << endl;
 }
 
 void Result::displayValidationFailureByTidRate() {
-  if (total_validation_failure_by_tid_) {
-    long double rate;
-    rate = (double)total_validation_failure_by_tid_ /
-           (double)total_abort_by_validation_;
-    cout << "validation_failure_by_tid:\t" << total_validation_failure_by_tid_
-         << endl;
-    cout << fixed << setprecision(4) << "validation_failure_by_tid_rate:\t"
-         << rate << endl;
-  }
+  long double rate;
+  rate = ratio((long double)total_validation_failure_by_tid_,
+               (long double)total_abort_by_validation_);
+  cout << "validation_failure_by_tid:\t" << total_validation_failure_by_tid_
+       << endl;
+  cout << fixed << setprecision(4) << "validation_failure_by_tid_rate:\t"
+       << rate << endl;
 }
 
 void Result::displayValidationFailureByWritelockRate() {
-  if (total_validation_failure_by_writelock_) {
-    long double rate;
-    rate = (double)total_validation_failure_by_writelock_ /
-           (double)total_abort_by_validation_;
-    cout << "validation_failure_by_writelock:\t"
-         << total_validation_failure_by_writelock_ << endl;
-    cout << fixed << setprecision(4)
-         << "validation_failure_by_writelock_rate:\t" << rate << endl;
-  }
+  long double rate;
+  rate = ratio((long double)total_validation_failure_by_writelock_,
+               (long double)total_abort_by_validation_);
+  cout << "validation_failure_by_writelock:\t"
+       << total_validation_failure_by_writelock_ << endl;
+  cout << fixed << setprecision(4)
+       << "validation_failure_by_writelock_rate:\t" << rate << endl;
 }
 
 void Result::displayVersionMalloc() {
@@ -289,20 +334,17 @@ void Result::displayVersionMalloc() {
 }
 
 void Result::displayVersionReuse() {
-  if (total_version_reuse_)
-    cout << "version_reuse:\t" << total_version_reuse_ << endl;
+  cout << "version_reuse:\t" << total_version_reuse_ << endl;
 }
 
 void Result::displayWriteLatencyRate(size_t clocks_per_us, size_t extime,
                                      size_t thread_num) {
-  if (total_write_latency_) {
-    long double rate;
-    rate =
-        (long double)total_write_latency_ /
-        ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
-        thread_num;
-    cout << fixed << setprecision(4) << "write_latency_rate:\t" << rate << endl;
-  }
+  long double rate;
+  rate =
+      (long double)total_write_latency_ /
+      ((long double)clocks_per_us * powl(10.0, 6.0) * (long double)extime) /
+      thread_num;
+  cout << fixed << setprecision(4) << "write_latency_rate:\t" << rate << endl;
 }
 #endif
 
@@ -314,6 +356,26 @@ void Result::addLocalCommitCounts(const uint64_t count) {
   total_commit_counts_ += count;
 }
 
+void Result::addLocalDurableCommitCounts(const uint64_t count) {
+  total_durable_commit_counts_ += count;
+}
+
+void Result::addLocalDurableLatency(const uint64_t count) {
+  total_durable_latency_ += count;
+}
+
+void Result::addLocalLatencyHist(const Histogram &hist) {
+  total_latency_hist_.merge(hist);
+}
+
+void Result::addLocalQueueingDelay(const uint64_t count) {
+  total_queueing_delay_ += count;
+}
+
+void Result::addLocalRetryHist(const Histogram &hist) {
+  total_retry_hist_.merge(hist);
+}
+
 #if ADD_ANALYSIS
 void Result::addLocalAbortByOperation(const uint64_t count) {
   total_abort_by_operation_ += count;
@@ -331,6 +393,14 @@ void Result::addLocalBackoffLatency(const uint64_t count) {
   total_backoff_latency_ += count;
 }
 
+void Result::addLocalAbsentAborts(const uint64_t count) {
+  total_absent_aborts_ += count;
+}
+
+void Result::addLocalDeleteCounts(const uint64_t count) {
+  total_delete_counts_ += count;
+}
+
 void Result::addLocalEarlyAborts(const uint64_t count) {
   total_early_aborts_ += count;
 }
@@ -339,6 +409,10 @@ void Result::addLocalExtraReads(const uint64_t count) {
   total_extra_reads_ += count;
 }
 
+void Result::addLocalInsertCounts(const uint64_t count) {
+  total_insert_counts_ += count;
+}
+
 void Result::addLocalGCCounts(const uint64_t count) {
   total_gc_counts_ += count;
 }
@@ -375,6 +449,14 @@ void Result::addLocalRtsupdChances(const uint64_t count) {
   total_rtsupd_chances_ += count;
 }
 
+void Result::addLocalTemperatureFalseLocks(const uint64_t count) {
+  total_temperature_false_locks_ += count;
+}
+
+void Result::addLocalTemperatureLocks(const uint64_t count) {
+  total_temperature_locks_ += count;
+}
+
 void Result::addLocalTemperatureResets(const uint64_t count) {
   total_temperature_resets_ += count;
 }
@@ -422,6 +504,22 @@ void Result::addLocalVersionReuse(const uint64_t count) {
 void Result::addLocalWriteLatency(const uint64_t count) {
   total_write_latency_ += count;
 }
+
+void Result::addLocalGCLatencyHist(const Histogram &hist) {
+  total_gc_latency_hist_.merge(hist);
+}
+
+void Result::addLocalReadLatencyHist(const Histogram &hist) {
+  total_read_latency_hist_.merge(hist);
+}
+
+void Result::addLocalValiLatencyHist(const Histogram &hist) {
+  total_vali_latency_hist_.merge(hist);
+}
+
+void Result::addLocalWriteLatencyHist(const Histogram &hist) {
+  total_write_latency_hist_.merge(hist);
+}
 #endif
 
 void Result::displayAllResult([[maybe_unused]] size_t clocks_per_us,
@@ -430,14 +528,17 @@ void Result::displayAllResult([[maybe_unused]] size_t clocks_per_us,
 #if ADD_ANALYSIS
   displayAbortByOperationRate();
   displayAbortByValidationRate();
+  displayAbsentAborts();
   displayCommitLatencyRate(clocks_per_us, extime, thread_num);
   displayBackoffLatencyRate(clocks_per_us, extime, thread_num);
+  displayDeleteCounts();
   displayEarlyAbortRate();
   displayExtraReads();
   displayGCCounts();
   displayGCLatencyRate(clocks_per_us, extime, thread_num);
   displayGCTMTElementsCounts();
   displayGCVersionCounts();
+  displayInsertCounts();
   displayMakeProcedureLatencyRate(clocks_per_us, extime, thread_num);
   displayMemcpys();
   displayOtherWorkLatencyRate(clocks_per_us, extime, thread_num);
@@ -445,6 +546,7 @@ void Result::displayAllResult([[maybe_unused]] size_t clocks_per_us,
   displayRatioOfPreemptiveAbortToTotalAbort();
   displayReadLatencyRate(clocks_per_us, extime, thread_num);
   displayRtsupdRate();
+  displayTemperatureFalseLockRate();
   displayTemperatureResets();
   displayTimestampHistorySuccessCounts();
   displayTimestampHistoryFailCounts();
@@ -460,6 +562,8 @@ void Result::displayAllResult([[maybe_unused]] size_t clocks_per_us,
 #endif
   displayAbortCounts();
   displayCommitCounts();
+  displayDurableCommit(clocks_per_us, extime);
+  displayLatencyPercentiles(clocks_per_us);
   displayRusageRUMaxrss();
   displayAbortRate();
   displayTps(extime, thread_num);
@@ -468,17 +572,25 @@ void Result::displayAllResult([[maybe_unused]] size_t clocks_per_us,
 void Result::addLocalAllResult(const Result &other) {
   addLocalAbortCounts(other.local_abort_counts_);
   addLocalCommitCounts(other.local_commit_counts_);
+  addLocalDurableCommitCounts(other.local_durable_commit_counts_);
+  addLocalDurableLatency(other.local_durable_latency_);
+  addLocalLatencyHist(other.local_latency_hist_);
+  addLocalQueueingDelay(other.local_queueing_delay_);
+  addLocalRetryHist(other.local_retry_hist_);
 #if ADD_ANALYSIS
   addLocalAbortByOperation(other.local_abort_by_operation_);
   addLocalAbortByValidation(other.local_abort_by_validation_);
+  addLocalAbsentAborts(other.local_absent_aborts_);
   addLocalBackoffLatency(other.local_backoff_latency_);
   addLocalCommitLatency(other.local_commit_latency_);
+  addLocalDeleteCounts(other.local_delete_counts_);
   addLocalEarlyAborts(other.local_early_aborts_);
   addLocalExtraReads(other.local_extra_reads_);
   addLocalGCCounts(other.local_gc_counts_);
   addLocalGCLatency(other.local_gc_latency_);
   addLocalGCVersionCounts(other.local_gc_version_counts_);
   addLocalGCTMTElementsCounts(other.local_gc_TMT_elements_counts_);
+  addLocalInsertCounts(other.local_insert_counts_);
   addLocalMakeProcedureLatency(other.local_make_procedure_latency_);
   addLocalMemcpys(other.local_memcpys);
   addLocalPreemptiveAbortsCounts(other.local_preemptive_aborts_counts_);
@@ -489,6 +601,8 @@ void Result::addLocalAllResult(const Result &other) {
       other.local_timestamp_history_success_counts_);
   addLocalTimestampHistoryFailCounts(
       other.local_timestamp_history_fail_counts_);
+  addLocalTemperatureFalseLocks(other.local_temperature_false_locks_);
+  addLocalTemperatureLocks(other.local_temperature_locks_);
   addLocalTemperatureResets(other.local_temperature_resets_);
   addLocalTreeTraversal(other.local_tree_traversal_);
   addLocalTMTElementsMalloc(other.local_TMT_element_malloc_);
@@ -500,5 +614,9 @@ void Result::addLocalAllResult(const Result &other) {
       other.local_validation_failure_by_writelock_);
   addLocalVersionMalloc(other.local_version_malloc_);
   addLocalVersionReuse(other.local_version_reuse_);
+  addLocalGCLatencyHist(other.local_gc_latency_hist_);
+  addLocalReadLatencyHist(other.local_read_latency_hist_);
+  addLocalValiLatencyHist(other.local_vali_latency_hist_);
+  addLocalWriteLatencyHist(other.local_write_latency_hist_);
 #endif
 }
@@ -45,7 +45,7 @@ void displayProcedureVector(std::vector<Procedure> &pro) {
 void displayRusageRUMaxrss() {
     struct rusage r{};
     if (getrusage(RUSAGE_SELF, &r) != 0) ERR;
-    printf("maxrss:\t%ld kB\n", r.ru_maxrss);
+    std::cout << "maxrss:\t" << r.ru_maxrss << " kB" << std::endl;
 }
 
 void readyAndWaitForReadyOfAllThread(std::atomic<size_t> &running,
@@ -15,11 +15,14 @@
 #include "../include/backoff.hh"
 #include "../include/cpu.hh"
 #include "../include/debug.hh"
+#include "../include/driver.hh"
 #include "../include/int64byte.hh"
 #include "../include/masstree_wrapper.hh"
 #include "../include/procedure.hh"
 #include "../include/random.hh"
 #include "../include/result.hh"
+#include "../include/result_export.hh"
+#include "../include/sampler.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
 #include "../include/zipf.hh"
@@ -31,17 +34,69 @@
 
 using namespace std;
 
-void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
-  TxExecutor trans(thid, (Result *) &ErmiaResult[thid]);
-  Xoroshiro128Plus rnd;
-  rnd.init();
-  Result &myres = std::ref(ErmiaResult[thid]);
-  FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
-  GarbageCollection gcob;
+/**
+ * @brief ERMIA engine for the driver.
+ */
+class ErmiaEngine : public Engine<ErmiaEngine> {
+public:
+  ErmiaEngine(size_t thid, Result &myres)
+          : trans_(thid, &myres), backoff_(FLAGS_clocks_per_us) {
+    if (thid == 0) gcob_.decideFirstRange();
+    trans_.gcstart_ = rdtscp();
+  }
+
+  std::vector<Procedure> &procedures() { return trans_.pro_set_; }
+
+  INLINE void leaderWork() {
+    ::leaderWork(gcob_);
+    leaderBackoffWork(backoff_, ErmiaResult);
+  }
+
+  INLINE void begin() { trans_.tbegin(); }
+
+  INLINE void read(uint64_t key) { trans_.ssn_tread(key); }
+
+  INLINE void write(uint64_t key) { trans_.ssn_twrite(key); }
+
+  /**
+   * early abort.
+   */
+  INLINE bool aborted() const {
+    return trans_.status_ == TransactionStatus::aborted;
+  }
+
+  INLINE void earlyAbort() {
+    trans_.abort();
+#if ADD_ANALYSIS
+    ++trans_.eres_->local_early_aborts_;
+#endif
+  }
+
+  INLINE bool commit() {
+    trans_.ssn_parallel_commit();
+    return trans_.status_ == TransactionStatus::committed;
+  }
+
+  INLINE void abort() { trans_.abort(); }
+
+  INLINE void committed() {
+    /**
+     * Maintenance phase
+     */
+    trans_.mainte();
+  }
+
+private:
+  TxExecutor trans_;
+  GarbageCollection gcob_;
   /**
    * Cicada's backoff opt.
    */
-  Backoff backoff(FLAGS_clocks_per_us);
+  Backoff backoff_;
+};
+
+void worker(size_t thid, Driver &driver) {
+  ErmiaEngine engine(thid, ErmiaResult[thid]);
 
 #if MASSTREE_USE
   MasstreeWrapper<Tuple>::thread_init(int(thid));
@@ -53,98 +108,34 @@ void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
   // printf("sysconf(_SC_NPROCESSORS_CONF) %ld\n",
   // sysconf(_SC_NPROCESSORS_CONF));
 #endif  // Linux
-  // printf("Thread #%d: on CPU %d\n", *myid, sched_getcpu());
-
-  if (thid == 0) gcob.decideFirstRange();
-  storeRelease(ready, 1);
-  while (!loadAcquire(start)) _mm_pause();
-  trans.gcstart_ = rdtscp();
-  while (!loadAcquire(quit)) {
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
-                  FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false, thid, myres);
-RETRY:
-    if (thid == 0) {
-      leaderWork(std::ref(gcob));
-      leaderBackoffWork(backoff, ErmiaResult);
-    }
-    if (loadAcquire(quit)) break;
-
-    trans.tbegin();
-    for (auto itr = trans.pro_set_.begin(); itr != trans.pro_set_.end();
-         ++itr) {
-      if ((*itr).ope_ == Ope::READ) {
-        trans.ssn_tread((*itr).key_);
-      } else if ((*itr).ope_ == Ope::WRITE) {
-        trans.ssn_twrite((*itr).key_);
-      } else if ((*itr).ope_ == Ope::READ_MODIFY_WRITE) {
-        trans.ssn_tread((*itr).key_);
-        trans.ssn_twrite((*itr).key_);
-      } else {
-        ERR;
-      }
-
-      /**
-       * early abort.
-       */
-      if (trans.status_ == TransactionStatus::aborted) {
-        trans.abort();
-#if ADD_ANALYSIS
-        ++trans.eres_->local_early_aborts_;
-#endif
-        goto RETRY;
-      }
-    }
-
-    trans.ssn_parallel_commit();
-    if (trans.status_ == TransactionStatus::committed) {
-      /**
-       * local_commit_counts is used at ../include/backoff.hh to calcurate about
-       * backoff.
-       */
-      storeRelease(myres.local_commit_counts_,
-                   loadAcquire(myres.local_commit_counts_) + 1);
-    } else if (trans.status_ == TransactionStatus::aborted) {
-      trans.abort();
-      goto RETRY;
-    }
-
-    /**
-     * Maintenance phase
-     */
-    trans.mainte();
-  }
 
-  return;
+  driver.work(engine, thid);
 }
 
 int main(int argc, char *argv[]) try {
   gflags::SetUsageMessage("ERMIA benchmark.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  setYcsbZipfSkew(
+          YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len),
+          FLAGS_zipf_skew);
+  ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
   chkArg();
   makeDB();
 
-  alignas(CACHE_LINE_SIZE) bool start = false;
-  alignas(CACHE_LINE_SIZE) bool quit = false;
   initResult();
-  std::vector<char> readys(FLAGS_thread_num);
-  std::vector<std::thread> thv;
-  for (size_t i = 0; i < FLAGS_thread_num; ++i)
-    thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                     std::ref(quit));
-  waitForReady(readys);
-  storeRelease(start, true);
-  for (size_t i = 0; i < FLAGS_extime; ++i) {
-    sleepMs(1000);
-  }
-  storeRelease(quit, true);
-  for (auto &th : thv) th.join();
+  Driver driver({FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
+                 FLAGS_rratio, FLAGS_rmw, false, FLAGS_ycsb, FLAGS_zipf_skew,
+                 FLAGS_arrival_rate, FLAGS_arrival_poisson,
+                 FLAGS_clocks_per_us, FLAGS_trace_record, FLAGS_trace_replay,
+                 YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist,
+                         FLAGS_scan_len)},
+                ErmiaResult);
+  driver.run(worker, FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
 
-  for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-    ErmiaResult[0].addLocalAllResult(ErmiaResult[i]);
-  }
   ShowOptParameters();
-  ErmiaResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime, FLAGS_thread_num);
+  driver.display(FLAGS_extime);
 
+  result_export.write();
   return 0;
 } catch (bad_alloc) {
   ERR;
@@ -75,6 +75,19 @@ public:
 
   void ssn_parallel_commit();
 
+  /**
+   * @brief allocate the commit timestamp.
+   * @details An update transaction takes the next even stamp from Lsn. A
+   * read-only transaction creates no version, so its stamp only has to be
+   * after those of the committed update transactions and before those of the
+   * later ones. It takes the odd stamp after the latest even one without
+   * writing Lsn, so read-only transactions don't contend on it.
+   */
+  INLINE uint32_t allocCstamp() {
+    if (write_set_.empty()) return Lsn.load(memory_order_acquire) + 1;
+    return Lsn.fetch_add(2, memory_order_acq_rel) + 2;
+  }
+
   void abort();
 
   void mainte();
@@ -180,7 +180,7 @@ void TxExecutor::ssn_tread(uint64_t key) {
 
 FINISH_TREAD:
 #if ADD_ANALYSIS
-  eres_->local_read_latency_ += rdtscp() - start;
+  eres_->recordReadLatency(rdtscp() - start);
 #endif
   return;
 }
@@ -318,7 +318,7 @@ void TxExecutor::ssn_twrite(uint64_t key) {
 
 FINISH_TWRITE:
 #if ADD_ANALYSIS
-  eres_->local_write_latency_ += rdtscp() - start;
+  eres_->recordWriteLatency(rdtscp() - start);
 #endif
   return;
 }
@@ -331,7 +331,7 @@ void TxExecutor::ssn_commit() {
   TransactionTable *tmt = loadAcquire(TMT[thid_]);
   tmt->status_.store(TransactionStatus::committing);
 
-  this->cstamp_ = ++Lsn;
+  this->cstamp_ = allocCstamp();
   tmt->cstamp_.store(this->cstamp_, memory_order_release);
 
   // begin pre-commit
@@ -417,9 +417,7 @@ void TxExecutor::ssn_parallel_commit() {
   TransactionTable *tmt = TMT[thid_];
   tmt->status_.store(TransactionStatus::committing);
 
-  this->cstamp_ = ++Lsn;
-  // this->cstamp_ = 2; test for effect of centralized counter in YCSB-C (read
-  // only workload)
+  this->cstamp_ = allocCstamp();
 
   tmt->cstamp_.store(this->cstamp_, memory_order_release);
 
@@ -529,7 +527,7 @@ void TxExecutor::ssn_parallel_commit() {
   }
 
 #if ADD_ANALYSIS
-  eres_->local_vali_latency_ += rdtscp() - start;
+  eres_->recordValiLatency(rdtscp() - start);
   start = rdtscp();
 #endif
 
@@ -613,7 +611,6 @@ void TxExecutor::abort() {
     downReadersBits((*itr).ver_);
 
   read_set_.clear();
-  ++eres_->local_abort_counts_;
 
 #if BACK_OFF
 
@@ -653,7 +650,7 @@ void TxExecutor::mainte() {
       pre_gc_threshold_ = loadThreshold;
       gcstart_ = gcstop_;
 #if ADD_ANALYSIS
-      eres_->local_gc_latency_ += rdtscp() - start;
+      eres_->recordGCLatency(rdtscp() - start);
 #endif
     }
   }
@@ -99,16 +99,27 @@ void displayDB() {
 }
 
 void displayParameter() {
+  cout << "#FLAGS_arrival_poisson:\t\t\t" << FLAGS_arrival_poisson << endl;
+  cout << "#FLAGS_arrival_rate:\t\t\t" << FLAGS_arrival_rate << endl;
   cout << "#FLAGS_clocks_per_us:\t\t\t" << FLAGS_clocks_per_us << endl;
   cout << "#FLAGS_extime:\t\t\t\t" << FLAGS_extime << endl;
   cout << "#FLAGS_gc_inter_us:\t\t\t" << FLAGS_gc_inter_us << endl;
   cout << "#FLAGS_max_ope:\t\t\t\t" << FLAGS_max_ope << endl;
   cout << "#FLAGS_pre_reserve_tmt_element:\t\t" << FLAGS_pre_reserve_tmt_element << endl;
   cout << "#FLAGS_pre_reserve_version:\t\t" << FLAGS_pre_reserve_version << endl;
+  cout << "#FLAGS_request_dist:\t\t\t" << FLAGS_request_dist << endl;
+  cout << "#FLAGS_result_file:\t\t\t" << FLAGS_result_file << endl;
+  cout << "#FLAGS_result_format:\t\t\t" << FLAGS_result_format << endl;
   cout << "#FLAGS_rmw:\t\t\t\t" << FLAGS_rmw << endl;
   cout << "#FLAGS_rratio:\t\t\t\t" << FLAGS_rratio << endl;
+  cout << "#FLAGS_sample_interval:\t\t\t" << FLAGS_sample_interval << endl;
+  cout << "#FLAGS_scan_len:\t\t\t" << FLAGS_scan_len << endl;
   cout << "#FLAGS_thread_num:\t\t\t" << FLAGS_thread_num << endl;
+  cout << "#FLAGS_trace_record:\t\t\t" << FLAGS_trace_record << endl;
+  cout << "#FLAGS_trace_replay:\t\t\t" << FLAGS_trace_replay << endl;
+  cout << "#FLAGS_warmup:\t\t\t\t" << FLAGS_warmup << endl;
   cout << "#FLAGS_ycsb:\t\t\t\t" << FLAGS_ycsb << endl;
+  cout << "#FLAGS_ycsb_workload:\t\t\t" << FLAGS_ycsb_workload << endl;
   cout << "#FLAGS_zipf_skew:\t\t\t" << FLAGS_zipf_skew << endl;
 }
 
@@ -142,6 +153,9 @@ void partTableInit([[maybe_unused]] size_t thid, uint64_t start, uint64_t end) {
 }
 
 void makeDB() {
+#if MASSTREE_USE
+  MT.reserve(FLAGS_tuple_num);
+#endif
   if (posix_memalign((void **) &Table, PAGE_SIZE, (FLAGS_tuple_num) * sizeof(Tuple)) !=
       0)
     ERR;
@@ -225,6 +239,7 @@ void leaderWork(GarbageCollection &gcob) {
 void ShowOptParameters() {
   cout << "#ShowOptParameters()"
        << ": ADD_ANALYSIS " << ADD_ANALYSIS << ": BACK_OFF " << BACK_OFF
+       << ": HASH_INDEX_USE " << HASH_INDEX_USE
        << ": MASSTREE_USE " << MASSTREE_USE << ": KEY_SIZE " << KEY_SIZE
        << ": KEY_SORT " << KEY_SORT << ": VAL_SIZE " << VAL_SIZE << endl;
 }
@@ -51,7 +51,10 @@ public:
     double new_backoff = Backoff_.load(std::memory_order_acquire);
     double backoff_diff = new_backoff - last_backoff_;
 
-    uint64_t committed_diff = committed_txs - last_committed_txs_;
+    // the counts are reset at the end of warm-up.
+    uint64_t committed_diff = committed_txs >= last_committed_txs_
+                              ? committed_txs - last_committed_txs_
+                              : committed_txs;
     double committed_tput = static_cast<double>(committed_diff) /
                             (static_cast<double>(time_diff) / clocks_per_us_) *
                             pow(10.0, 6);
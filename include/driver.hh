@@ -0,0 +1,302 @@
+#pragma once
+
+#include <xmmintrin.h>
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "atomic_wrapper.hh"
+#include "cache_line_size.hh"
+#include "debug.hh"
+#include "inline.hh"
+#include "open_loop.hh"
+#include "procedure.hh"
+#include "procedure_batch.hh"
+#include "random.hh"
+#include "result.hh"
+#include "sampler.hh"
+#include "trace.hh"
+#include "util.hh"
+#include "ycsb.hh"
+#include "zipf.hh"
+
+/**
+ * @brief Parameters of the generated workload.
+ */
+class Workload {
+public:
+  uint64_t tuple_num_;
+  uint64_t max_ope_;
+  uint64_t thread_num_;
+  uint64_t rratio_;
+  bool rmw_;
+  bool partition_;
+  bool ycsb_;
+  double zipf_skew_;
+  uint64_t arrival_rate_;
+  bool arrival_poisson_;
+  uint64_t clocks_per_us_;
+  std::string trace_record_;  // path prefix of the traces to record
+  std::string trace_replay_;  // path prefix of the traces to replay
+  YcsbMix mix_;               // YCSB core workload instead of rratio
+};
+
+/**
+ * @brief Interface of a concurrency control engine for Driver.
+ * @details An engine derives from Engine<Derived> and defines
+ * - std::vector<Procedure> &procedures(): the procedures of the transaction.
+ * - void begin()
+ * - void read(uint64_t key)
+ * - void write(uint64_t key)
+ * - bool commit(): validation and write phase. false means it must abort.
+ * - void abort()
+ * It may hide the hooks below. The calls are resolved at compile time, so
+ * the hot path has no virtual call. An engine which supports insert, scan or
+ * delete sets kInsert, kScan or kDelete and defines insert, scan or remove.
+ * Only Silo does, so YCSB d, e and churn run on Silo only.
+ */
+template <typename Derived>
+class Engine {
+public:
+  static constexpr bool kInsert = false;
+  static constexpr bool kScan = false;
+  static constexpr bool kDelete = false;
+
+  /**
+   * @brief called once per transaction after its procedures are generated.
+   */
+  INLINE void prepare() {}
+
+  /**
+   * @brief called by worker 0 before every attempt.
+   */
+  INLINE void leaderWork() {}
+
+  INLINE void readWrite(uint64_t key) {
+    derived().read(key);
+    derived().write(key);
+  }
+
+  INLINE void insert([[maybe_unused]] uint64_t key) { ERR; }
+
+  /**
+   * @brief read scan_len records from the key in the key order.
+   */
+  INLINE void scan([[maybe_unused]] uint64_t key,
+                   [[maybe_unused]] uint32_t scan_len) {
+    ERR;
+  }
+
+  INLINE void remove([[maybe_unused]] uint64_t key) { ERR; }
+
+  /**
+   * @brief whether the last operation aborted the transaction.
+   */
+  INLINE bool aborted() const { return false; }
+
+  /**
+   * @brief abort by an operation in the read phase.
+   */
+  INLINE void earlyAbort() { derived().abort(); }
+
+  /**
+   * @brief called after the commit is counted.
+   */
+  INLINE void committed() {}
+
+  /**
+   * @brief called repeatedly while the worker waits for an arrival.
+   */
+  INLINE void idle() {}
+
+  /**
+   * @brief called after the worker resets its result at the end of warm-up.
+   */
+  INLINE void warmedUp() {}
+
+  /**
+   * @brief called when the worker quits.
+   */
+  INLINE void finish() {}
+
+protected:
+  INLINE Derived &derived() { return static_cast<Derived &>(*this); }
+};
+
+/**
+ * @brief Benchmark driver shared by the engines.
+ * @details It owns the workload generation, the arrival schedule, the
+ * threads, the timing and the counting of commits and aborts, so every
+ * engine runs the same loop and is measured in the same way. The worker
+ * function of an engine sets up its thread and calls work() with its engine.
+ */
+class Driver {
+public:
+  alignas(CACHE_LINE_SIZE) bool start_ = false;
+  alignas(CACHE_LINE_SIZE) bool quit_ = false;
+
+  /**
+   * @param [in,out] key_space the key space shared by the runs on the same
+   * database, e.g. the points of a sweep, so inserts continue after the keys
+   * of the previous runs. nullptr means the initial tuple_num records.
+   */
+  Driver(const Workload &workload, std::vector<Result> &results,
+         KeySpace *key_space = nullptr)
+          : workload_(workload), results_(results), sampler_(results),
+            readys_(workload.thread_num_), key_space_(key_space) {
+    if (key_space_ == nullptr) {
+      own_key_space_ = std::make_unique<KeySpace>(workload.tuple_num_);
+      key_space_ = own_key_space_.get();
+    }
+    if (!workload_.trace_record_.empty() && !workload_.trace_replay_.empty()) {
+      std::cout << "trace_record and trace_replay are exclusive." << std::endl;
+      ERR;
+    }
+  }
+
+  /**
+   * @brief run worker(thid, *this) on each thread and merge the results.
+   * @param [in] warmup warm-up time[sec].
+   * @param [in] extime measured time[sec].
+   * @param [in] interval_ms interval of samples. 0 means no samples.
+   */
+  template <typename Worker>
+  void run(Worker worker, uint64_t warmup, uint64_t extime,
+           uint64_t interval_ms) {
+    std::vector<std::thread> thv;
+    for (size_t i = 0; i < workload_.thread_num_; ++i)
+      thv.emplace_back(worker, i, std::ref(*this));
+    waitForReady(readys_);
+    storeRelease(start_, true);
+    sampler_.run(warmup, extime, interval_ms);
+    storeRelease(quit_, true);
+    for (auto &th : thv) th.join();
+
+    for (unsigned int i = 0; i < workload_.thread_num_; ++i) {
+      results_[0].addLocalAllResult(results_[i]);
+    }
+  }
+
+  void display(uint64_t extime) {
+    results_[0].displayAllResult(workload_.clocks_per_us_, extime,
+                                 workload_.thread_num_);
+    sampler_.display();
+  }
+
+  /**
+   * @brief the loop of a worker.
+   * @details With trace_record, the generated procedures of each worker are
+   * recorded to its trace. With trace_replay, they are read from the trace
+   * instead of being generated, so every engine runs the same transactions.
+   */
+  template <typename E>
+  void work(E &engine, size_t thid) {
+    Result &myres = results_[thid];
+    Xoroshiro128Plus rnd;
+    rnd.init();
+    const YcsbMix &mix = workload_.mix_;
+    if ((mix.insert_ != 0 && !E::kInsert) || (mix.scan_ != 0 && !E::kScan) ||
+        (mix.delete_ != 0 && !E::kDelete)) {
+      std::cout << "this engine does not support the insert, scan or delete of "
+                   "ycsb_workload. d, e and churn run on silo only."
+                << std::endl;
+      ERR;
+    }
+    FastZipf zipf(&rnd, workload_.zipf_skew_, workload_.tuple_num_);
+    ProcedureBatch batch(rnd, zipf,
+                         mix.enabled_ ? mix.zipf() : workload_.ycsb_);
+    OpenLoop open_loop(rnd, workload_.arrival_rate_, workload_.thread_num_,
+                       workload_.arrival_poisson_, workload_.clocks_per_us_);
+    std::vector<Procedure> &pro_set = engine.procedures();
+    std::unique_ptr<TraceWriter> trace_writer;
+    std::unique_ptr<TraceReader> trace_reader;
+    if (!workload_.trace_record_.empty())
+      trace_writer = std::make_unique<TraceWriter>(
+              tracePath(workload_.trace_record_, thid), workload_.tuple_num_);
+    if (!workload_.trace_replay_.empty())
+      trace_reader = std::make_unique<TraceReader>(
+              tracePath(workload_.trace_replay_, thid), workload_.tuple_num_);
+
+    storeRelease(readys_[thid], 1);
+    while (!loadAcquire(start_)) _mm_pause();
+    while (!loadAcquire(quit_)) {
+      if (sampler_.resetAfterWarmup(thid)) engine.warmedUp();
+      // worker 0 keeps the leader work, e.g. advancing the epoch, going.
+      if (!open_loop.waitArrival(quit_, myres, [&] {
+            if (thid == 0) engine.leaderWork();
+            engine.idle();
+            if (sampler_.resetAfterWarmup(thid)) engine.warmedUp();
+          }))
+        break;
+      if (trace_reader) {
+        trace_reader->next(pro_set);
+      } else if (mix.enabled_) {
+        makeYcsbProcedure(pro_set, batch, rnd, mix, *key_space_,
+                          workload_.tuple_num_, workload_.max_ope_);
+        if (trace_writer) trace_writer->append(pro_set);
+      } else {
+        makeProcedure(pro_set, batch, workload_.tuple_num_, workload_.max_ope_,
+                      workload_.thread_num_, workload_.rratio_, workload_.rmw_,
+                      workload_.partition_, thid, myres);
+        if (trace_writer) trace_writer->append(pro_set);
+      }
+      engine.prepare();
+RETRY:
+      if (thid == 0) engine.leaderWork();
+      if (loadAcquire(quit_)) break;
+
+      engine.begin();
+      for (auto &pro : pro_set) {
+        if (pro.ope_ == Ope::READ) {
+          engine.read(pro.key_);
+        } else if (pro.ope_ == Ope::WRITE) {
+          engine.write(pro.key_);
+        } else if (pro.ope_ == Ope::READ_MODIFY_WRITE) {
+          engine.readWrite(pro.key_);
+        } else if (pro.ope_ == Ope::INSERT) {
+          engine.insert(pro.key_);
+        } else if (pro.ope_ == Ope::SCAN) {
+          engine.scan(pro.key_, pro.scan_len_);
+        } else if (pro.ope_ == Ope::DELETE) {
+          engine.remove(pro.key_);
+        } else {
+          ERR;
+        }
+
+        if (engine.aborted()) {
+          engine.earlyAbort();
+          ++myres.local_abort_counts_;
+          goto RETRY;
+        }
+      }
+
+      if (!engine.commit()) {
+        engine.abort();
+        ++myres.local_abort_counts_;
+        goto RETRY;
+      }
+      /**
+       * local_commit_counts is used at ../include/backoff.hh to calcurate about
+       * backoff.
+       */
+      storeRelease(myres.local_commit_counts_,
+                   loadAcquire(myres.local_commit_counts_) + 1);
+      open_loop.commit(myres);
+      engine.committed();
+    }
+    engine.finish();
+  }
+
+private:
+  Workload workload_;
+  std::vector<Result> &results_;
+  Sampler sampler_;
+  std::vector<char> readys_;
+  KeySpace *key_space_;
+  std::unique_ptr<KeySpace> own_key_space_;
+};
@@ -99,7 +99,7 @@ public:
     }
   }
 
-#ifdef Linux
+#if defined(Linux) || defined(__linux__)
   void fdatasync() {
     if (::fdatasync(fd()) < 0) {
       throw LibcError(errno, "fdsync failed: ");
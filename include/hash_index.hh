@@ -0,0 +1,438 @@
+#pragma once
+
+#include <stdlib.h>
+#include <xmmintrin.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "cache_line_size.hh"
+#include "debug.hh"
+#include "inline.hh"
+
+/**
+ * @brief Concurrent hash index of uint64_t keys with the interface of
+ * MasstreeWrapper.
+ * @details It is a bucketized cuckoo hash table. A bucket is a cache line of a
+ * version and kSlotNum slots, and a key is in one of its two buckets, so a
+ * lookup reads at most two cache lines and needs no bswap or traversal.
+ * Lookups are optimistic and lock-free: they read the versions, the slots
+ * and the versions again, and retry if a version changed. Inserts and removes
+ * lock the two buckets by the lowest bit of their versions, and unlocking
+ * increments the versions. If both buckets are full, an insert moves keys to
+ * their other buckets along a path found by breadth-first search, one move
+ * at a time from the end of the path, so a key is always in a bucket. If no
+ * path is found, the table is doubled. It has no order, so it has no scan.
+ */
+template <typename T>
+class HashIndexWrapper {
+public:
+  static constexpr std::size_t kSlotNum = 3;
+  static constexpr uint64_t kEmpty = UINT64_MAX;
+  static constexpr std::size_t kMaxPathDepth = 5;
+  static constexpr std::size_t kInitBucketNum = 64;
+
+  class Bucket {
+  public:
+    std::atomic<uint64_t> version_;
+    std::atomic<uint64_t> keys_[kSlotNum];
+    std::atomic<T *> values_[kSlotNum];
+  };
+  static_assert(sizeof(Bucket) <= CACHE_LINE_SIZE, "a bucket is a line");
+
+  /**
+   * buckets of missing keys and their versions, for phantom validation.
+   */
+  typedef std::vector<std::pair<const Bucket *, uint64_t>> node_set_type;
+
+  HashIndexWrapper() { reserve(0); }
+
+  HashIndexWrapper(const HashIndexWrapper &) = delete;
+
+  HashIndexWrapper &operator=(const HashIndexWrapper &) = delete;
+
+  static void thread_init([[maybe_unused]] int thread_id) {}
+
+  /**
+   * @brief size the table for num keys at the load factor of 50 %, so the
+   * loading does not grow it. It is called before the workers start.
+   */
+  void reserve(std::size_t num) {
+    std::size_t bucket_num = kInitBucketNum;
+    while (bucket_num * kSlotNum < num * 2) bucket_num <<= 1;
+    tables_.clear();
+    tables_.emplace_back(std::make_unique<Table>(bucket_num));
+    table_.store(tables_.back().get(), std::memory_order_release);
+  }
+
+  INLINE T *get_value(uint64_t key) { return get_value(key, nullptr); }
+
+  /**
+   * @brief get_value which appends the buckets of a missing key and their
+   * versions to the node set, so an insert of the key is detected.
+   */
+  INLINE T *get_value(uint64_t key, node_set_type *node_set) {
+    for (;;) {
+      Table *t = table_.load(std::memory_order_acquire);
+      Bucket *b1, *b2;
+      t->buckets(key, b1, b2);
+      uint64_t v1, v2;
+      if (!stableVersion(t, b1, v1)) continue;
+      T *value = find(b1, key);
+      if (value != nullptr) {
+        // inserts fill b1 first, so most lookups read one cache line.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (b1->version_.load(std::memory_order_relaxed) == v1) return value;
+        continue;
+      }
+      if (!stableVersion(t, b2, v2)) continue;
+      value = find(b2, key);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (b1->version_.load(std::memory_order_relaxed) != v1 ||
+          b2->version_.load(std::memory_order_relaxed) != v2)
+        continue;
+      if (value == nullptr && node_set != nullptr) {
+        node_set->emplace_back(b1, v1);
+        node_set->emplace_back(b2, v2);
+      }
+      return value;
+    }
+  }
+
+  /**
+   * @brief insert the value if the key does not exist.
+   * @param [in,out] node_set the versions of the own buckets in it are
+   * updated, so the own insert is not a phantom for the own reads.
+   * @return whether it is inserted.
+   */
+  bool insert_value(uint64_t key, T *value,
+                    node_set_type *node_set = nullptr) {
+    if (key == kEmpty) ERR;
+    for (;;) {
+      Table *t = table_.load(std::memory_order_acquire);
+      Bucket *b1, *b2;
+      t->buckets(key, b1, b2);
+      uint64_t v1, v2;
+      if (!lockPair(t, b1, b2, v1, v2)) continue;
+      if (find(b1, key) != nullptr || find(b2, key) != nullptr) {
+        unlockPair(b1, b2);
+        return false;
+      }
+      if (put(b1, key, value) || put(b2, key, value)) {
+        unlockPair(b1, b2);
+        if (node_set) {
+          for (auto &elem : *node_set) {
+            if (elem.first == b1 && elem.second == v1) elem.second = v1 + 2;
+            if (elem.first == b2 && elem.second == v2) elem.second = v2 + 2;
+          }
+        }
+        return true;
+      }
+      unlockPair(b1, b2);
+      // both are full. Concurrent moves may break each other's paths.
+      std::lock_guard<std::mutex> lock(cuckoo_mutex_);
+      if (table_.load(std::memory_order_relaxed) != t) continue;
+      if (!makeRoom(t, b1) && !makeRoom(t, b2)) grow(t);
+    }
+  }
+
+  /**
+   * @brief remove the key.
+   * @param [in,out] node_set the versions of the own buckets in it are
+   * updated, so removing the own insert is not a phantom for the own reads.
+   * @return whether it existed.
+   */
+  bool remove_value(uint64_t key, node_set_type *node_set = nullptr) {
+    for (;;) {
+      Table *t = table_.load(std::memory_order_acquire);
+      Bucket *b1, *b2;
+      t->buckets(key, b1, b2);
+      uint64_t v1, v2;
+      if (!lockPair(t, b1, b2, v1, v2)) continue;
+      bool found = erase(b1, key) || erase(b2, key);
+      unlockPair(b1, b2);
+      if (found && node_set) {
+        for (auto &elem : *node_set) {
+          if (elem.first == b1 && elem.second == v1) elem.second = v1 + 2;
+          if (elem.first == b2 && elem.second == v2) elem.second = v2 + 2;
+        }
+      }
+      return found;
+    }
+  }
+
+  /**
+   * @brief the hash index has no order.
+   */
+  void scan([[maybe_unused]] uint64_t lkey, [[maybe_unused]] uint64_t rkey,
+            [[maybe_unused]] std::vector<std::pair<uint64_t, T *>> &values,
+            [[maybe_unused]] node_set_type *node_set) {
+    ERR;
+  }
+
+  /**
+   * @brief whether the buckets of the node set are unchanged.
+   * @details The buckets of a retired table stay locked, so a grow fails the
+   * validation.
+   */
+  static bool validate_node_set(const node_set_type &node_set) {
+    for (auto &node : node_set) {
+      if (node.first->version_.load(std::memory_order_acquire) != node.second)
+        return false;
+    }
+    return true;
+  }
+
+private:
+  class Table {
+  public:
+    Bucket *buckets_ = nullptr;
+    std::size_t mask_;
+
+    explicit Table(std::size_t bucket_num) : mask_(bucket_num - 1) {
+      if (posix_memalign((void **) &buckets_, CACHE_LINE_SIZE,
+                         bucket_num * CACHE_LINE_SIZE) != 0)
+        ERR;
+      for (std::size_t i = 0; i < bucket_num; ++i) {
+        Bucket &b = bucket(i);
+        b.version_.store(0, std::memory_order_relaxed);
+        for (std::size_t j = 0; j < kSlotNum; ++j) {
+          b.keys_[j].store(kEmpty, std::memory_order_relaxed);
+          b.values_[j].store(nullptr, std::memory_order_relaxed);
+        }
+      }
+    }
+
+    Table(const Table &) = delete;
+
+    Table &operator=(const Table &) = delete;
+
+    ~Table() { free(buckets_); }
+
+    INLINE Bucket &bucket(std::size_t index) {
+      return *reinterpret_cast<Bucket *>(reinterpret_cast<char *>(buckets_) +
+                                         index * CACHE_LINE_SIZE);
+    }
+
+    INLINE void buckets(uint64_t key, Bucket *&b1, Bucket *&b2) {
+      uint64_t h = hash(key);
+      std::size_t i1 = h & mask_;
+      std::size_t i2 = (h >> 32) & mask_;
+      if (i2 == i1) i2 = (i1 + 1) & mask_;
+      b1 = &bucket(i1);
+      b2 = &bucket(i2);
+    }
+
+    INLINE Bucket *otherBucket(uint64_t key, Bucket *b) {
+      Bucket *b1, *b2;
+      buckets(key, b1, b2);
+      return b == b1 ? b2 : b1;
+    }
+  };
+
+  std::atomic<Table *> table_;
+  /**
+   * every table, including the retired ones. Lock-free readers may still be
+   * in a retired table, so they are freed at the destruction.
+   */
+  std::vector<std::unique_ptr<Table>> tables_;
+  std::mutex cuckoo_mutex_;
+
+  // the finalizer of splitmix64.
+  static INLINE uint64_t hash(uint64_t key) {
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+  }
+
+  /**
+   * @brief wait until the bucket is unlocked.
+   * @return false if the table is retired.
+   */
+  INLINE bool stableVersion(Table *t, Bucket *b, uint64_t &v) {
+    v = b->version_.load(std::memory_order_acquire);
+    while (v & 1) {
+      if (table_.load(std::memory_order_acquire) != t) return false;
+      _mm_pause();
+      v = b->version_.load(std::memory_order_acquire);
+    }
+    return true;
+  }
+
+  /**
+   * @return false if the table is retired.
+   */
+  INLINE bool lock(Table *t, Bucket *b, uint64_t &v) {
+    v = b->version_.load(std::memory_order_relaxed);
+    for (;;) {
+      if (v & 1) {
+        if (table_.load(std::memory_order_acquire) != t) return false;
+        _mm_pause();
+        v = b->version_.load(std::memory_order_relaxed);
+      } else if (b->version_.compare_exchange_weak(
+                         v, v + 1, std::memory_order_acquire,
+                         std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  }
+
+  static INLINE void unlock(Bucket *b) {
+    b->version_.fetch_add(1, std::memory_order_release);
+  }
+
+  // the buckets are locked in the address order against deadlocks.
+  INLINE bool lockPair(Table *t, Bucket *b1, Bucket *b2, uint64_t &v1,
+                       uint64_t &v2) {
+    Bucket *first = b1 < b2 ? b1 : b2;
+    Bucket *second = b1 < b2 ? b2 : b1;
+    uint64_t &vf = b1 < b2 ? v1 : v2;
+    uint64_t &vs = b1 < b2 ? v2 : v1;
+    if (!lock(t, first, vf)) return false;
+    if (!lock(t, second, vs)) {
+      unlock(first);
+      return false;
+    }
+    return true;
+  }
+
+  static INLINE void unlockPair(Bucket *b1, Bucket *b2) {
+    unlock(b1);
+    unlock(b2);
+  }
+
+  static INLINE T *find(Bucket *b, uint64_t key) {
+    for (std::size_t i = 0; i < kSlotNum; ++i) {
+      if (b->keys_[i].load(std::memory_order_relaxed) == key)
+        return b->values_[i].load(std::memory_order_relaxed);
+    }
+    return nullptr;
+  }
+
+  static INLINE bool put(Bucket *b, uint64_t key, T *value) {
+    for (std::size_t i = 0; i < kSlotNum; ++i) {
+      if (b->keys_[i].load(std::memory_order_relaxed) == kEmpty) {
+        b->values_[i].store(value, std::memory_order_relaxed);
+        b->keys_[i].store(key, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static INLINE bool erase(Bucket *b, uint64_t key) {
+    for (std::size_t i = 0; i < kSlotNum; ++i) {
+      if (b->keys_[i].load(std::memory_order_relaxed) == key) {
+        b->keys_[i].store(kEmpty, std::memory_order_relaxed);
+        b->values_[i].store(nullptr, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static INLINE bool hasFree(Bucket *b) {
+    for (std::size_t i = 0; i < kSlotNum; ++i) {
+      if (b->keys_[i].load(std::memory_order_relaxed) == kEmpty) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief make a free slot in the bucket by moving keys to their other
+   * buckets. It is called with cuckoo_mutex_, so the table is not retired.
+   * @return false if no path is found.
+   */
+  bool makeRoom(Table *t, Bucket *start) {
+    class Step {
+    public:
+      Bucket *bucket_;
+      std::size_t parent_;  // index of the step which moves into bucket_.
+      std::size_t slot_;    // slot of the parent bucket moved into bucket_.
+    };
+    std::vector<Step> steps;
+    steps.push_back({start, SIZE_MAX, 0});
+    std::size_t level_begin = 0;
+    for (std::size_t depth = 0; depth < kMaxPathDepth; ++depth) {
+      std::size_t level_end = steps.size();
+      for (std::size_t s = level_begin; s < level_end; ++s) {
+        Bucket *b = steps[s].bucket_;
+        for (std::size_t i = 0; i < kSlotNum; ++i) {
+          uint64_t key = b->keys_[i].load(std::memory_order_relaxed);
+          if (key == kEmpty) return true;  // removed concurrently.
+          Bucket *alt = t->otherBucket(key, b);
+          steps.push_back({alt, s, i});
+          if (!hasFree(alt)) continue;
+          // move from the end, so every key is in a bucket during the moves.
+          for (std::size_t m = steps.size() - 1; steps[m].parent_ != SIZE_MAX;
+               m = steps[m].parent_) {
+            Bucket *from = steps[steps[m].parent_].bucket_;
+            Bucket *to = steps[m].bucket_;
+            std::size_t slot = steps[m].slot_;
+            uint64_t vf, vt;
+            lockPair(t, from, to, vf, vt);
+            uint64_t moving = from->keys_[slot].load(std::memory_order_relaxed);
+            bool moved =
+                    moving != kEmpty && t->otherBucket(moving, from) == to &&
+                    put(to, moving,
+                        from->values_[slot].load(std::memory_order_relaxed));
+            if (moved) {
+              from->keys_[slot].store(kEmpty, std::memory_order_relaxed);
+              from->values_[slot].store(nullptr, std::memory_order_relaxed);
+            }
+            unlockPair(from, to);
+            // a concurrent insert or remove changed the path, so retry.
+            if (!moved) return true;
+          }
+          return true;
+        }
+      }
+      level_begin = level_end;
+    }
+    return false;
+  }
+
+  /**
+   * @brief double the table. It is called with cuckoo_mutex_.
+   * @details Every bucket of the old table is locked and never unlocked, so
+   * lock-free readers and writers in it retry in the new one.
+   */
+  void grow(Table *old) {
+    std::size_t bucket_num = old->mask_ + 1;
+    for (std::size_t i = 0; i < bucket_num; ++i) {
+      uint64_t v;
+      lock(old, &old->bucket(i), v);
+    }
+    for (;;) {
+      bucket_num <<= 1;
+      auto next = std::make_unique<Table>(bucket_num);
+      if (rehash(old, next.get())) {
+        tables_.emplace_back(std::move(next));
+        table_.store(tables_.back().get(), std::memory_order_release);
+        return;
+      }
+    }
+  }
+
+  bool rehash(Table *from, Table *to) {
+    for (std::size_t i = 0; i <= from->mask_; ++i) {
+      Bucket &b = from->bucket(i);
+      for (std::size_t j = 0; j < kSlotNum; ++j) {
+        uint64_t key = b.keys_[j].load(std::memory_order_relaxed);
+        if (key == kEmpty) continue;
+        T *value = b.values_[j].load(std::memory_order_relaxed);
+        Bucket *b1, *b2;
+        to->buckets(key, b1, b2);
+        while (!put(b1, key, value) && !put(b2, key, value)) {
+          if (!makeRoom(to, b1) && !makeRoom(to, b2)) return false;
+        }
+      }
+    }
+    return true;
+  }
+};
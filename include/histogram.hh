@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "inline.hh"
+
+/**
+ * @brief Log-linear histogram in the style of HdrHistogram.
+ * @details Values in [0, 2^kSubBits) have their own buckets. Above that, each
+ * power of two range is divided into 2^kSubBits buckets, so the relative
+ * error of a reported value is less than 2^-kSubBits (1.6%). Recording is a
+ * few instructions without atomic operations. Each worker thread records to
+ * its own histogram, and the histograms are merged after the workers finish.
+ * The buckets are allocated at the first record, so an unused histogram
+ * costs nothing.
+ */
+class Histogram {
+public:
+  static constexpr unsigned kSubBits = 6;
+  static constexpr uint64_t kSubCount = 1ULL << kSubBits;
+  static constexpr std::size_t kBucketNum = (64 - kSubBits + 1) * kSubCount;
+
+  INLINE void record(uint64_t value) {
+    if (counts_.empty()) counts_.resize(kBucketNum);
+    ++counts_[index(value)];
+    ++count_;
+    sum_ += value;
+    if (value > max_) max_ = value;
+  }
+
+  void merge(const Histogram &other) {
+    if (other.counts_.empty()) return;
+    if (counts_.empty()) counts_.resize(kBucketNum);
+    for (std::size_t i = 0; i < kBucketNum; ++i) counts_[i] += other.counts_[i];
+    count_ += other.count_;
+    sum_ += other.sum_;
+    if (other.max_ > max_) max_ = other.max_;
+  }
+
+  uint64_t count() const { return count_; }
+
+  uint64_t max() const { return max_; }
+
+  double mean() const {
+    return count_ == 0 ? 0 : (double) sum_ / (double) count_;
+  }
+
+  /**
+   * @brief the value at the percentile.
+   * @param [in] p percentile in [0, 1].
+   * @return the highest value in the bucket containing the percentile. It is
+   * not greater than max().
+   */
+  uint64_t percentile(double p) const {
+    if (count_ == 0) return 0;
+    uint64_t rank = (uint64_t) (p * (double) count_);
+    if (rank == 0) rank = 1;
+    if (rank > count_) rank = count_;
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketNum; ++i) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        uint64_t value = highestEquivalentValue(i);
+        return value < max_ ? value : max_;
+      }
+    }
+    return max_;
+  }
+
+private:
+  std::vector<uint64_t> counts_;
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t max_ = 0;
+
+  static INLINE std::size_t index(uint64_t value) {
+    if (value < kSubCount) return value;
+    unsigned msb = 63 - __builtin_clzll(value);
+    unsigned shift = msb - kSubBits;
+    // the top kSubBits + 1 bits. The highest bit is always 1.
+    uint64_t sub = (value >> shift) & (kSubCount - 1);
+    return (shift + 1) * kSubCount + sub;
+  }
+
+  static uint64_t highestEquivalentValue(std::size_t index) {
+    std::size_t group = index / kSubCount;
+    uint64_t sub = index % kSubCount;
+    if (group == 0) return sub;
+    unsigned shift = group - 1;
+    uint64_t lowest = (kSubCount + sub) << shift;
+    return lowest + ((1ULL << shift) - 1);
+  }
+};
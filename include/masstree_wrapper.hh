@@ -4,10 +4,12 @@
 #include <iostream>
 #include <random>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
 #include <xmmintrin.h>
 
 // フォーマッターを利用すると，辞書順のために下記2行が入れ替わる．
@@ -67,6 +69,11 @@ public:
   typedef typename table_type::node_type node_type;
   typedef typename unlocked_cursor_type::nodeversion_value_type
           nodeversion_value_type;
+  /**
+   * leaves visited by scans and their versions, for phantom validation.
+   */
+  typedef std::vector<std::pair<const leaf_type *, nodeversion_value_type>>
+          node_set_type;
 
   static __thread typename table_params::threadinfo_type *ti;
 
@@ -85,6 +92,12 @@ public:
     if (ti == nullptr) ti = threadinfo::make(threadinfo::TI_PROCESS, thread_id);
   }
 
+  /**
+   * @brief masstree grows by splits, so it needs no reservation. It is for
+   * the interface shared with HashIndexWrapper.
+   */
+  void reserve([[maybe_unused]] std::size_t num) {}
+
   void table_print() {
     table_.print(stdout);
     fprintf(stdout, "Stats: %s\n",
@@ -93,7 +106,15 @@ public:
                     .c_str());
   }
 
-  void insert_value(std::string_view key, T *value) {
+  /**
+   * @brief insert the value if the key does not exist.
+   * @param [in,out] node_set if the leaf of the key is in it with the version
+   * before the insert, the version is updated, so the own insert is not a
+   * phantom for the own scans.
+   * @return whether it is inserted.
+   */
+  bool insert_value(std::string_view key, T *value,
+                    node_set_type *node_set = nullptr) {
     cursor_type lp(table_, key.data(), key.size());
     bool found = lp.find_insert(*ti);
     // always_assert(!found, "keys should all be unique");
@@ -101,17 +122,52 @@ public:
       // release lock of existing nodes meaning the first arg equals 0
       lp.finish(0, *ti);
       // return
-      return;
+      return false;
     }
     lp.value() = value;
+    const leaf_type *node = lp.node();
+    nodeversion_value_type prev = lp.previous_full_version_value();
+    nodeversion_value_type next = lp.next_full_version_value(1);
     fence();
     lp.finish(1, *ti);
-    return;
+    if (node_set) {
+      for (auto &elem : *node_set) {
+        if (elem.first == node && elem.second == prev) elem.second = next;
+      }
+    }
+    return true;
   }
 
-  void insert_value(std::uint64_t key, T *value) {
+  bool insert_value(std::uint64_t key, T *value,
+                    node_set_type *node_set = nullptr) {
     std::uint64_t key_buf{__builtin_bswap64(key)};
-    insert_value({reinterpret_cast<char *>(&key_buf), sizeof(key_buf)}, value); // NOLINT
+    return insert_value({reinterpret_cast<char *>(&key_buf), sizeof(key_buf)}, // NOLINT
+                        value, node_set);
+  }
+
+  /**
+   * @brief remove the key.
+   * @param [in,out] node_set if the leaf of the key is in it with the version
+   * before the remove, the version is updated, so removing the own insert is
+   * not a phantom for the own scans.
+   * @return whether it existed.
+   */
+  bool remove_value(std::uint64_t key, node_set_type *node_set = nullptr) {
+    std::uint64_t key_buf;
+    Str mtkey = make_key(key, key_buf);
+    cursor_type lp(table_, mtkey);
+    bool found = lp.find_locked(*ti);
+    if (found && node_set) {
+      const leaf_type *node = lp.node();
+      nodeversion_value_type prev = lp.previous_full_version_value();
+      nodeversion_value_type next = lp.next_full_version_value(-1);
+      for (auto &elem : *node_set) {
+        if (elem.first == node && elem.second == prev) elem.second = next;
+      }
+    }
+    // -1 removes the key, and 0 only releases the lock.
+    lp.finish(found ? -1 : 0, *ti);
+    return found;
   }
 
   T *get_value(std::string_view key) {
@@ -128,10 +184,82 @@ public:
     return get_value({reinterpret_cast<char *>(&key_buf), sizeof(key_buf)});
   }
 
+  /**
+   * @brief get_value which appends the leaf of a missing key and its version
+   * to the node set, so an insert of the key is detected as a phantom.
+   */
+  T *get_value(std::uint64_t key, node_set_type *node_set) {
+    std::uint64_t key_buf;
+    Str mtkey = make_key(key, key_buf);
+    unlocked_cursor_type lp(table_, mtkey);
+    if (lp.find_unlocked(*ti)) return lp.value();
+    node_set->emplace_back(lp.node(), lp.full_version_value());
+    return nullptr;
+  }
+
+  /**
+   * @brief scan the values of the keys in [lkey, rkey] in the key order.
+   * @details The leaves it visits and their versions are appended to the
+   * node set. A leaf which has any insert or remove after that has the other
+   * version, so validate_node_set() detects phantoms in the range.
+   * @param [out] values the pairs of a key and its value.
+   * @param [out] node_set nullptr means no phantom validation.
+   */
+  void scan(std::uint64_t lkey, std::uint64_t rkey,
+            std::vector<std::pair<std::uint64_t, T *>> &values,
+            node_set_type *node_set) {
+    std::uint64_t key_buf;
+    Str mtkey = make_key(lkey, key_buf);
+    SearchRangeScanner scanner(rkey, values, node_set);
+    table_.scan(mtkey, true, scanner, *ti);
+  }
+
+  /**
+   * @brief whether the leaves of the node set are unchanged.
+   */
+  static bool validate_node_set(const node_set_type &node_set) {
+    for (auto &node : node_set) {
+      if (node.first->full_unlocked_version_value() != node.second)
+        return false;
+    }
+    return true;
+  }
+
   static inline std::atomic<bool> stopping{};
   static inline std::atomic<std::uint32_t> printing{};
 
 private:
+  class SearchRangeScanner {
+  public:
+    SearchRangeScanner(std::uint64_t rkey,
+                       std::vector<std::pair<std::uint64_t, T *>> &values,
+                       node_set_type *node_set)
+            : rkey_(rkey), values_(values), node_set_(node_set) {}
+
+    template<typename SS, typename K>
+    void visit_leaf(const SS &scanstack, const K &, threadinfo &) {
+      if (node_set_) {
+        node_set_->emplace_back(scanstack.node(),
+                                scanstack.full_version_value());
+      }
+    }
+
+    bool visit_value(Str key, T *value, threadinfo &) {
+      std::uint64_t int_key;
+      if (key.length() != sizeof(int_key)) return true;
+      memcpy(&int_key, key.data(), sizeof(int_key));
+      int_key = __builtin_bswap64(int_key);
+      if (int_key > rkey_) return false;
+      values_.emplace_back(int_key, value);
+      return true;
+    }
+
+  private:
+    std::uint64_t rkey_;
+    std::vector<std::pair<std::uint64_t, T *>> &values_;
+    node_set_type *node_set_;
+  };
+
   table_type table_;
   std::uint64_t key_gen_;
 
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <xmmintrin.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "atomic_wrapper.hh"
+#include "inline.hh"
+#include "random.hh"
+#include "result.hh"
+#include "tsc.hh"
+
+/**
+ * @brief Arrival schedule of a worker thread and latency of its transactions.
+ * @details In the closed loop, a transaction arrives as soon as the previous
+ * one commits. In the open loop, transactions of each worker arrive at
+ * arrival_rate / thread_num [tps] by a Poisson process (or at fixed
+ * intervals) regardless of their completion. A transaction arriving while the
+ * worker is busy waits in the queue. In both loops, the latency is from the
+ * arrival to the commit including the queueing delay and retries.
+ */
+class OpenLoop {
+public:
+  /**
+   * @param [in] arrival_rate offered load of all the workers [tps]. 0 means
+   * the closed loop.
+   * @param [in] poisson true means exponential intervals, false means fixed
+   * intervals.
+   */
+  OpenLoop(Xoroshiro128Plus &rnd, uint64_t arrival_rate, size_t thread_num,
+           bool poisson, size_t clocks_per_us)
+          : rnd_(rnd), poisson_(poisson) {
+    if (arrival_rate != 0)
+      interval_ = (double) clocks_per_us * 1000 * 1000 * (double) thread_num /
+                  (double) arrival_rate;
+  }
+
+  bool enabled() const { return interval_ != 0; }
+
+  /**
+   * @brief wait for the arrival of the next transaction.
+   * @param [in] idle called repeatedly while the worker waits.
+   * @return false if it is interrupted by quit.
+   */
+  template <typename Idle>
+  INLINE bool waitArrival(const bool &quit, Result &res, Idle idle) {
+    if (!enabled()) {
+      arrival_ = rdtscp();
+      aborts_ = res.local_abort_counts_;
+      return true;
+    }
+    if (next_arrival_ == 0) next_arrival_ = rdtscp();
+    arrival_ = next_arrival_;
+    next_arrival_ += nextInterval();
+
+    uint64_t now = rdtscp();
+    while (now < arrival_) {
+      if (loadAcquire(quit)) return false;
+      idle();
+      _mm_pause();
+      now = rdtscp();
+    }
+    res.local_queueing_delay_ += now - arrival_;
+    // idle may reset the result.
+    aborts_ = res.local_abort_counts_;
+    return true;
+  }
+
+  INLINE bool waitArrival(const bool &quit, Result &res) {
+    return waitArrival(quit, res, [] {});
+  }
+
+  /**
+   * @brief record the latency and the retries of the committed transaction.
+   */
+  INLINE void commit(Result &res) {
+    res.local_latency_hist_.record(rdtscp() - arrival_);
+    res.local_retry_hist_.record(res.local_abort_counts_ - aborts_);
+  }
+
+private:
+  Xoroshiro128Plus &rnd_;
+  double interval_ = 0;  // mean interval of arrivals [clocks]
+  bool poisson_;
+  uint64_t aborts_ = 0;  // local_abort_counts_ at the arrival
+  uint64_t arrival_ = 0;
+  uint64_t next_arrival_ = 0;
+
+  INLINE uint64_t nextInterval() {
+    if (!poisson_) return (uint64_t) interval_;
+    // uniform random number in (0, 1].
+    double u = (double) ((rnd_.next() >> 11) + 1) / (double) (1ULL << 53);
+    return (uint64_t) (-std::log(u) * interval_);
+  }
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 
 using std::cout;
@@ -9,6 +10,9 @@ enum class Ope : uint8_t {
   READ,
   WRITE,
   READ_MODIFY_WRITE,
+  INSERT,
+  SCAN,
+  DELETE,
 };
 
 class Procedure {
@@ -17,11 +21,15 @@ public:
   uint64_t key_;
   bool ronly_ = false;
   bool wonly_ = false;
+  uint32_t scan_len_ = 0;  // the number of records from key_ for SCAN.
 
   Procedure() : ope_(Ope::READ), key_(0) {}
 
   Procedure(Ope ope, uint64_t key) : ope_(ope), key_(key) {}
 
+  Procedure(Ope ope, uint64_t key, uint32_t scan_len)
+          : ope_(ope), key_(key), scan_len_(scan_len) {}
+
   bool operator<(const Procedure &right) const {
     if (this->key_ == right.key_ && this->ope_ == Ope::WRITE &&
         right.ope_ == Ope::READ) {
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "inline.hh"
+#include "random.hh"
+#include "zipf.hh"
+
+/**
+ * @brief Random numbers for makeProcedure generated in batches.
+ * @details makeProcedure draws access keys and dice of operation types one by
+ * one. This generates kBatchSize of them at once with kLanes independent
+ * xoroshiro128+ generators held in struct-of-arrays form, so the loop over the
+ * lanes is vectorized by the compiler (e.g. 4 x 64-bit lanes with AVX2 when
+ * built with -march=native). Zipf mapping is done in a separate tight loop
+ * over the batch.
+ */
+class ProcedureBatch {
+public:
+  static constexpr std::size_t kLanes = 4;
+  static constexpr std::size_t kBatchSize = 1024;
+
+  /**
+   * @param [in] rnd seeds the lanes.
+   * @param [in] zipf maps keys if ycsb is true.
+   * @param [in] ycsb true means zipf keys, false means uniform random keys.
+   */
+  ProcedureBatch(Xoroshiro128Plus &rnd, FastZipf &zipf, bool ycsb)
+          : zipf_(zipf), ycsb_(ycsb) {
+    for (std::size_t i = 0; i < kLanes; ++i) {
+      s0_[i] = rnd.next();
+      s1_[i] = rnd.splitMix64(s0_[i]);
+      rnd.jump();
+    }
+  }
+
+  /**
+   * @brief the next key before it is mapped into the table (or partition).
+   */
+  INLINE uint64_t nextKey() {
+    if (key_pos_ == kBatchSize) refillKeys();
+    return keys_[key_pos_++];
+  }
+
+  /**
+   * @brief the next dice in [0, 100).
+   */
+  INLINE uint64_t nextDice() {
+    if (dice_pos_ == kBatchSize) refillDice();
+    return dice_[dice_pos_++];
+  }
+
+private:
+  uint64_t s0_[kLanes];
+  uint64_t s1_[kLanes];
+  uint64_t keys_[kBatchSize];
+  uint64_t dice_[kBatchSize];
+  std::size_t key_pos_ = kBatchSize;
+  std::size_t dice_pos_ = kBatchSize;
+  FastZipf &zipf_;
+  const bool ycsb_;
+
+  static INLINE uint64_t rotl(const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  /**
+   * @brief the same as Xoroshiro128Plus::next for all the lanes.
+   */
+  INLINE void fill(uint64_t *out) {
+    for (std::size_t i = 0; i < kBatchSize; i += kLanes) {
+      for (std::size_t j = 0; j < kLanes; ++j) {
+        const uint64_t s0 = s0_[j];
+        uint64_t s1 = s1_[j];
+        out[i + j] = s0 + s1;
+        s1 ^= s0;
+        s0_[j] = rotl(s0, 24) ^ s1 ^ (s1 << 16);
+        s1_[j] = rotl(s1, 37);
+      }
+    }
+  }
+
+  void refillKeys() {
+    fill(keys_);
+    if (ycsb_) {
+      for (std::size_t i = 0; i < kBatchSize; ++i)
+        keys_[i] = zipf_.sample(keys_[i]);
+    }
+    key_pos_ = 0;
+  }
+
+  void refillDice() {
+    fill(dice_);
+    // multiply-shift instead of modulo, which is not vectorized.
+    for (std::size_t i = 0; i < kBatchSize; ++i)
+      dice_[i] = ((dice_[i] >> 32) * 100) >> 32;
+    dice_pos_ = 0;
+  }
+};
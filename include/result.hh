@@ -3,30 +3,49 @@
 #include <atomic>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 #include "./cache_line_size.hh"
+#include "./histogram.hh"
+#include "./inline.hh"
 
 class Result {
 public:
   alignas(CACHE_LINE_SIZE) uint64_t local_abort_counts_ = 0;
   uint64_t local_commit_counts_ = 0;
+  // commits acknowledged after its log became durable (group commit).
+  uint64_t local_durable_commit_counts_ = 0;
+  // sum of latency from the beginning of transaction to its acknowledgement.
+  uint64_t local_durable_latency_ = 0;
+  // latency from the arrival to the commit of transaction including retries.
+  Histogram local_latency_hist_;
+  // number of aborts of each committed transaction.
+  Histogram local_retry_hist_;
+  // sum of delay from the arrival to the beginning of transaction (open loop).
+  uint64_t local_queueing_delay_ = 0;
 #if ADD_ANALYSIS
   uint64_t local_abort_by_operation_ = 0;
   uint64_t local_abort_by_validation_ = 0;
+  uint64_t local_absent_aborts_ = 0;
   uint64_t local_commit_latency_ = 0;
   uint64_t local_backoff_latency_ = 0;
+  uint64_t local_delete_counts_ = 0;
   uint64_t local_early_aborts_ = 0;
   uint64_t local_extra_reads_ = 0;
   uint64_t local_gc_counts_ = 0;
   uint64_t local_gc_latency_ = 0;
   uint64_t local_gc_version_counts_ = 0;
   uint64_t local_gc_TMT_elements_counts_ = 0;
+  uint64_t local_insert_counts_ = 0;
   uint64_t local_make_procedure_latency_ = 0;
   uint64_t local_memcpys = 0;
   uint64_t local_preemptive_aborts_counts_ = 0;
   uint64_t local_read_latency_ = 0;
   uint64_t local_rtsupd_ = 0;
   uint64_t local_rtsupd_chances_ = 0;
+  // locks taken by temperature, and those on records not genuinely hot.
+  uint64_t local_temperature_false_locks_ = 0;
+  uint64_t local_temperature_locks_ = 0;
   uint64_t local_temperature_resets_ = 0;
   uint64_t local_timestamp_history_fail_counts_ = 0;
   uint64_t local_timestamp_history_success_counts_ = 0;
@@ -39,27 +58,42 @@ public:
   uint64_t local_version_malloc_ = 0;
   uint64_t local_version_reuse_ = 0;
   uint64_t local_write_latency_ = 0;
+  // the same as the above sums, but each latency is recorded.
+  Histogram local_gc_latency_hist_;
+  Histogram local_read_latency_hist_;
+  Histogram local_vali_latency_hist_;
+  Histogram local_write_latency_hist_;
 #endif
 
   uint64_t total_abort_counts_ = 0;
   uint64_t total_commit_counts_ = 0;
+  uint64_t total_durable_commit_counts_ = 0;
+  uint64_t total_durable_latency_ = 0;
+  Histogram total_latency_hist_;
+  Histogram total_retry_hist_;
+  uint64_t total_queueing_delay_ = 0;
 #if ADD_ANALYSIS
   uint64_t total_abort_by_operation_ = 0;
   uint64_t total_abort_by_validation_ = 0;
+  uint64_t total_absent_aborts_ = 0;
   uint64_t total_commit_latency_ = 0;
   uint64_t total_backoff_latency_ = 0;
+  uint64_t total_delete_counts_ = 0;
   uint64_t total_early_aborts_ = 0;
   uint64_t total_extra_reads_ = 0;
   uint64_t total_gc_counts_ = 0;
   uint64_t total_gc_latency_ = 0;
   uint64_t total_gc_version_counts_ = 0;
   uint64_t total_gc_TMT_elements_counts_ = 0;
+  uint64_t total_insert_counts_ = 0;
   uint64_t total_make_procedure_latency_ = 0;
   uint64_t total_memcpys = 0;
   uint64_t total_preemptive_aborts_counts_ = 0;
   uint64_t total_read_latency_ = 0;
   uint64_t total_rtsupd_ = 0;
   uint64_t total_rtsupd_chances_ = 0;
+  uint64_t total_temperature_false_locks_ = 0;
+  uint64_t total_temperature_locks_ = 0;
   uint64_t total_temperature_resets_ = 0;
   uint64_t total_timestamp_history_fail_counts_ = 0;
   uint64_t total_timestamp_history_success_counts_ = 0;
@@ -74,14 +108,27 @@ public:
   uint64_t total_write_latency_ = 0;
   // not exist local version.
   uint64_t total_latency_ = 0;
+  Histogram total_gc_latency_hist_;
+  Histogram total_read_latency_hist_;
+  Histogram total_vali_latency_hist_;
+  Histogram total_write_latency_hist_;
 #endif
 
+  /**
+   * @brief clear every counter and histogram.
+   */
+  void reset() { *this = Result(); }
+
   void displayAbortCounts();
 
   void displayAbortRate();
 
   void displayCommitCounts();
 
+  void displayDurableCommit(size_t clocks_per_us, size_t extime);
+
+  void displayLatencyPercentiles(size_t clocks_per_us);
+
   void displayTps(size_t extime, size_t thread_num);
 
   void displayAllResult(size_t clocks_per_us, size_t extime, size_t thread_num);
@@ -89,10 +136,12 @@ public:
 #if ADD_ANALYSIS
   void displayAbortByOperationRate();   // abort by operation rate;
   void displayAbortByValidationRate();  // abort by validation rate;
+  void displayAbsentAborts();
   void displayCommitLatencyRate(size_t clocks_per_us, size_t extime,
                                  size_t thread_num);
   void displayBackoffLatencyRate(size_t clocks_per_us, size_t extime,
                                  size_t thread_num);
+  void displayDeleteCounts();
   void displayEarlyAbortRate();
   void displayExtraReads();
   void displayGCCounts();
@@ -100,6 +149,7 @@ public:
                             size_t thread_num);
   void displayGCTMTElementsCounts();
   void displayGCVersionCounts();
+  void displayInsertCounts();
   void displayMakeProcedureLatencyRate(size_t clocks_per_us, size_t extime,
       size_t thread_num);
   void displayMemcpys();
@@ -110,6 +160,7 @@ public:
   void displayReadLatencyRate(size_t clocks_per_us, size_t extime,
                               size_t thread_num);
   void displayRtsupdRate();
+  void displayTemperatureFalseLockRate();
   void displayTemperatureResets();
   void displayTimestampHistorySuccessCounts();
   void displayTimestampHistoryFailCounts();
@@ -133,17 +184,30 @@ public:
 
   void addLocalCommitCounts(const uint64_t count);
 
+  void addLocalDurableCommitCounts(const uint64_t count);
+
+  void addLocalDurableLatency(const uint64_t count);
+
+  void addLocalLatencyHist(const Histogram &hist);
+
+  void addLocalQueueingDelay(const uint64_t count);
+
+  void addLocalRetryHist(const Histogram &hist);
+
 #if ADD_ANALYSIS
   void addLocalAbortByOperation(const uint64_t count);
   void addLocalAbortByValidation(const uint64_t count);
+  void addLocalAbsentAborts(const uint64_t count);
   void addLocalCommitLatency(const uint64_t count);
   void addLocalBackoffLatency(const uint64_t count);
+  void addLocalDeleteCounts(const uint64_t count);
   void addLocalEarlyAborts(const uint64_t count);
   void addLocalExtraReads(const uint64_t count);
   void addLocalGCCounts(const uint64_t count);
   void addLocalGCLatency(const uint64_t count);
   void addLocalGCVersionCounts(const uint64_t count);
   void addLocalGCTMTElementsCounts(const uint64_t count);
+  void addLocalInsertCounts(const uint64_t count);
   void addLocalMakeProcedureLatency(const uint64_t count);
   void addLocalMemcpys(const uint64_t count);
   void addLocalPreemptiveAbortsCounts(const uint64_t count);
@@ -152,6 +216,8 @@ public:
   void addLocalRtsupdChances(const uint64_t count);
   void addLocalTimestampHistorySuccessCounts(const uint64_t count);
   void addLocalTimestampHistoryFailCounts(const uint64_t count);
+  void addLocalTemperatureFalseLocks(const uint64_t count);
+  void addLocalTemperatureLocks(const uint64_t count);
   void addLocalTemperatureResets(uint64_t count);
   void addLocalTMTElementsMalloc(const uint64_t count);
   void addLocalTMTElementsReuse(const uint64_t count);
@@ -162,5 +228,29 @@ public:
   void addLocalValidationFailureByWritelock(const uint64_t count);
   void addLocalVersionMalloc(const uint64_t count);
   void addLocalVersionReuse(const uint64_t count);
+  void addLocalGCLatencyHist(const Histogram &hist);
+  void addLocalReadLatencyHist(const Histogram &hist);
+  void addLocalValiLatencyHist(const Histogram &hist);
+  void addLocalWriteLatencyHist(const Histogram &hist);
+
+  /**
+   * @brief add the latency of a phase to its sum and its histogram.
+   */
+  INLINE void recordGCLatency(const uint64_t clocks) {
+    local_gc_latency_ += clocks;
+    local_gc_latency_hist_.record(clocks);
+  }
+  INLINE void recordReadLatency(const uint64_t clocks) {
+    local_read_latency_ += clocks;
+    local_read_latency_hist_.record(clocks);
+  }
+  INLINE void recordValiLatency(const uint64_t clocks) {
+    local_vali_latency_ += clocks;
+    local_vali_latency_hist_.record(clocks);
+  }
+  INLINE void recordWriteLatency(const uint64_t clocks) {
+    local_write_latency_ += clocks;
+    local_write_latency_hist_.record(clocks);
+  }
 #endif
 };
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "debug.hh"
+
+/**
+ * @brief Export of the result of a run as JSON or CSV.
+ * @details Every result line of the text output is "name:\tvalue", and
+ * ShowOptParameters() prints the compile-time options in one line. So while
+ * it is alive, it copies std::cout into a buffer, and at the end of the run
+ * it parses the buffer instead of duplicating every display function.
+ * Runtime flags are taken from gflags. One run appends one line to the file:
+ * a JSON object, or a CSV row (with the header row if the file is new). A run
+ * whose columns differ from the header of an existing CSV file is an error.
+ * In a sweep, each point is written as one run.
+ */
+class ResultExport {
+public:
+  using Entries = std::vector<std::pair<std::string, std::string>>;
+
+  /**
+   * @param [in] format "json", "csv", or "" (no export).
+   * @param [in] path file to append to.
+   */
+  ResultExport(const std::string &format, const std::string &path)
+          : format_(format), path_(path) {
+    if (format_.empty()) return;
+    if (format_ != "json" && format_ != "csv") {
+      std::cout << "result_format must be json or csv." << std::endl;
+      ERR;
+    }
+    if (path_.empty()) {
+      std::cout << "result_file is needed for result_format." << std::endl;
+      ERR;
+    }
+    tee_.reset(std::cout.rdbuf());
+    std::cout.rdbuf(&tee_);
+  }
+
+  ~ResultExport() {
+    if (!format_.empty()) std::cout.rdbuf(tee_.sink());
+  }
+
+  /**
+   * @brief append the result of the run to the file.
+   * @details It parses the output since the previous write().
+   */
+  void write() {
+    if (format_.empty()) return;
+    std::cout.flush();
+    Entries flags, options, results;
+    std::vector<std::string> samples;
+    collectFlags(flags);
+    parse(tee_.str(), options, results, samples);
+
+    if (format_ == "json") {
+      std::ofstream ofs(path_, std::ios::app);
+      ofs << "{\"flags\":" << jsonObject(flags)
+          << ",\"options\":" << jsonObject(options)
+          << ",\"result\":" << jsonObject(results) << ",\"samples\":[";
+      for (std::size_t i = 0; i < samples.size(); ++i)
+        ofs << (i ? "," : "") << "[" << samples[i] << "]";
+      ofs << "]}" << std::endl;
+    } else {
+      Entries all;
+      for (auto *entries : {&flags, &options, &results})
+        all.insert(all.end(), entries->begin(), entries->end());
+      std::string header;
+      for (std::size_t i = 0; i < all.size(); ++i)
+        header += (i ? "," : "") + csvField(all[i].first);
+      std::ifstream ifs(path_);
+      const bool is_new = !ifs.good() || ifs.peek() == EOF;
+      if (!is_new) {
+        std::string existing;
+        std::getline(ifs, existing);
+        if (existing != header) {
+          std::cout << "the columns of the run differ from the header of "
+                    << path_ << "; write it to another result_file."
+                    << std::endl;
+          ERR;
+        }
+      }
+      ifs.close();
+      std::ofstream ofs(path_, std::ios::app);
+      if (is_new) ofs << header << std::endl;
+      for (std::size_t i = 0; i < all.size(); ++i)
+        ofs << (i ? "," : "") << csvField(all[i].second);
+      ofs << std::endl;
+    }
+    tee_.clear();
+  }
+
+private:
+  /**
+   * @brief stream buffer which writes to the sink and keeps a copy.
+   */
+  class TeeBuf : public std::streambuf {
+  public:
+    void reset(std::streambuf *sink) { sink_ = sink; }
+
+    std::streambuf *sink() const { return sink_; }
+
+    const std::string &str() const { return copy_; }
+
+    void clear() { copy_.clear(); }
+
+  protected:
+    int overflow(int c) override {
+      if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+      copy_.push_back(static_cast<char>(c));
+      return sink_->sputc(static_cast<char>(c));
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+      copy_.append(s, n);
+      return sink_->sputn(s, n);
+    }
+
+    int sync() override { return sink_->pubsync(); }
+
+  private:
+    std::streambuf *sink_ = nullptr;
+    std::string copy_;
+  };
+
+  std::string format_;
+  std::string path_;
+  TeeBuf tee_;
+
+  static void collectFlags(Entries &flags) {
+    std::vector<gflags::CommandLineFlagInfo> infos;
+    gflags::GetAllFlags(&infos);
+    for (auto &info : infos) {
+      // the flags of the engine, not those of gflags and glog.
+      if (info.filename.find("common.hh") == std::string::npos) continue;
+      flags.emplace_back(info.name, info.current_value);
+    }
+  }
+
+  static void set(Entries &entries, const std::string &key,
+                  const std::string &value) {
+    for (auto &entry : entries) {
+      if (entry.first == key) {
+        entry.second = value;
+        return;
+      }
+    }
+    entries.emplace_back(key, value);
+  }
+
+  static std::string trim(const std::string &s) {
+    std::size_t begin = s.find_first_not_of(" \t");
+    if (begin == std::string::npos) return "";
+    std::size_t end = s.find_last_not_of(" \t");
+    return s.substr(begin, end - begin + 1);
+  }
+
+  static void parse(const std::string &text, Entries &options,
+                    Entries &results, std::vector<std::string> &samples) {
+    std::istringstream iss(text);
+    std::string line;
+    const std::string opt_prefix = "#ShowOptParameters()";
+    while (std::getline(iss, line)) {
+      if (line.compare(0, opt_prefix.size(), opt_prefix) == 0) {
+        // ": NAME value: NAME value..."
+        std::istringstream opts(line.substr(opt_prefix.size()));
+        std::string opt;
+        std::getline(opts, opt, ':');
+        while (std::getline(opts, opt, ':')) {
+          std::istringstream kv(opt);
+          std::string key, value;
+          kv >> key >> value;
+          if (key.empty()) continue;
+          set(options, key, value.empty() ? "1" : value);
+        }
+        continue;
+      }
+      if (line.empty() || line[0] == '#') continue;
+      std::size_t colon = line.find(":\t");
+      if (colon == std::string::npos) continue;
+      std::string key = trim(line.substr(0, colon));
+      std::string value = trim(line.substr(colon + 2));
+      if (key == "sample") {
+        for (auto &c : value)
+          if (c == '\t') c = ',';
+        samples.emplace_back(value);
+        continue;
+      }
+      set(results, key, value);
+    }
+  }
+
+  static bool isNumber(const std::string &s) {
+    if (s.empty() || s.find_first_not_of("0123456789+-.eE") != std::string::npos)
+      return false;
+    char *end;
+    std::strtod(s.c_str(), &end);
+    return *end == '\0';
+  }
+
+  static std::string jsonString(const std::string &s) {
+    std::string out = "\"";
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+        out += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+        out += buf;
+      } else {
+        out += c;
+      }
+    }
+    return out + "\"";
+  }
+
+  static std::string jsonObject(const Entries &entries) {
+    std::string out = "{";
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      if (i) out += ",";
+      out += jsonString(entries[i].first) + ":";
+      const std::string &value = entries[i].second;
+      if (isNumber(value) || value == "true" || value == "false")
+        out += value;
+      else
+        out += jsonString(value);
+    }
+    return out + "}";
+  }
+
+  static std::string csvField(const std::string &s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) return s;
+    std::string out = "\"";
+    for (char c : s) {
+      if (c == '"') out += '"';
+      out += c;
+    }
+    return out + "\"";
+  }
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "atomic_wrapper.hh"
+#include "cache_line_size.hh"
+#include "inline.hh"
+#include "result.hh"
+
+/**
+ * @brief Sampler of the counters of the worker threads.
+ * @details The main thread runs it while the workers run. At the end of
+ * warm-up, it tells the workers to reset their results, so no counter or
+ * histogram includes warm-up, and the measured extime starts when all of
+ * them have reset. During extime, it sums the counts every interval and keeps
+ * the differences as a time series, which shows warm-up effects, GC pauses
+ * and epoch hiccups.
+ */
+class Sampler {
+public:
+  class Sample {
+  public:
+    uint64_t time_ms_;  // from the end of warm-up
+    uint64_t commit_counts_;
+    uint64_t abort_counts_;
+  };
+
+  std::vector<Sample> samples_;
+
+  explicit Sampler(std::vector<Result> &results)
+          : results_(results), resets_(results.size()) {}
+
+  /**
+   * @brief wait for warm-up and the measured extime.
+   * @param [in] warmup warm-up time[sec].
+   * @param [in] extime measured time[sec].
+   * @param [in] interval_ms interval of samples. 0 means no samples.
+   */
+  void run(uint64_t warmup, uint64_t extime, uint64_t interval_ms) {
+    if (warmup != 0) {
+      std::this_thread::sleep_for(std::chrono::seconds(warmup));
+      storeRelease(warmed_up_, true);
+      for (auto &reset : resets_) {
+        while (!loadAcquire(reset))
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t end_ms = extime * 1000;
+    uint64_t prev_commits = 0, prev_aborts = 0;
+    if (interval_ms != 0) {
+      for (uint64_t t = interval_ms; t <= end_ms; t += interval_ms) {
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(t));
+        uint64_t commits = 0, aborts = 0;
+        for (auto &result : results_) {
+          commits += loadAcquire(result.local_commit_counts_);
+          aborts += loadAcquire(result.local_abort_counts_);
+        }
+        samples_.push_back({t, commits - prev_commits, aborts - prev_aborts});
+        prev_commits = commits;
+        prev_aborts = aborts;
+      }
+    }
+    std::this_thread::sleep_until(start + std::chrono::milliseconds(end_ms));
+  }
+
+  /**
+   * @brief called by the worker between transactions. At the first call
+   * after warm-up, it resets the result of the worker.
+   * @return true if it reset the result.
+   */
+  INLINE bool resetAfterWarmup(size_t thid) {
+    if (resets_[thid] || !loadAcquire(warmed_up_)) return false;
+    results_[thid].reset();
+    storeRelease(resets_[thid], 1);
+    return true;
+  }
+
+  void display() {
+    if (samples_.empty()) return;
+    std::cout << "#sample[ms]\tcommit_counts\tabort_counts\tthroughput[tps]"
+              << std::endl;
+    uint64_t prev_ms = 0;
+    for (auto &sample : samples_) {
+      std::cout << "sample:\t" << sample.time_ms_ << "\t"
+                << sample.commit_counts_ << "\t" << sample.abort_counts_
+                << "\t"
+                << sample.commit_counts_ * 1000 / (sample.time_ms_ - prev_ms)
+                << std::endl;
+      prev_ms = sample.time_ms_;
+    }
+  }
+
+private:
+  std::vector<Result> &results_;
+  alignas(CACHE_LINE_SIZE) bool warmed_up_ = false;
+  std::vector<char> resets_;  // whether each worker reset its result
+};
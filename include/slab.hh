@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdlib.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "config.hh"
+#include "debug.hh"
+#include "inline.hh"
+
+/**
+ * @brief Allocator of values in size-class slab arenas.
+ * @details The size classes are powers of two from kMinSize. A class carves
+ * its blocks from arenas of kArenaSize bytes (or one block if it is larger)
+ * and keeps freed blocks in an intrusive free list, so an allocation is a pop
+ * or a bump of a pointer. Arenas are never returned, because records in the
+ * index may point to them until the process exits. It is not thread-safe, so
+ * each thread owns one, and a block may be freed to the allocator of the
+ * other thread.
+ */
+class SlabAllocator {
+public:
+  static constexpr std::size_t kMinShift = 3;
+  static constexpr std::size_t kMinSize = 1UL << kMinShift;
+  static constexpr std::size_t kArenaSize = 2UL << 20;
+  static constexpr std::size_t kClassNum = 40;
+
+  SlabAllocator() = default;
+
+  SlabAllocator(const SlabAllocator &) = delete;
+
+  SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+  INLINE char *allocate(std::size_t size) {
+    SizeClass &sc = classes_[classOf(size)];
+    if (sc.free_ != nullptr) {
+      char *block = sc.free_;
+      sc.free_ = *reinterpret_cast<char **>(block);
+      return block;
+    }
+    std::size_t block_size = kMinSize << classOf(size);
+    if (sc.cur_ + block_size > sc.end_) refill(sc, block_size);
+    char *block = sc.cur_;
+    sc.cur_ += block_size;
+    return block;
+  }
+
+  INLINE void deallocate(char *block, std::size_t size) {
+    SizeClass &sc = classes_[classOf(size)];
+    *reinterpret_cast<char **>(block) = sc.free_;
+    sc.free_ = block;
+  }
+
+  /**
+   * @brief the bytes of the arenas.
+   */
+  std::size_t arenaBytes() const { return arena_bytes_; }
+
+private:
+  class SizeClass {
+  public:
+    char *cur_ = nullptr;
+    char *end_ = nullptr;
+    char *free_ = nullptr;
+  };
+
+  std::array<SizeClass, kClassNum> classes_;
+  std::size_t arena_bytes_ = 0;
+
+  static INLINE std::size_t classOf(std::size_t size) {
+    if (size <= kMinSize) return 0;
+    return 64 - __builtin_clzl(size - 1) - kMinShift;
+  }
+
+  void refill(SizeClass &sc, std::size_t block_size) {
+    std::size_t bytes = block_size > kArenaSize ? block_size : kArenaSize;
+    void *arena;
+    if (posix_memalign(&arena, PAGE_SIZE, bytes) != 0) ERR;
+    arena_bytes_ += bytes;
+    sc.cur_ = static_cast<char *>(arena);
+    sc.end_ = sc.cur_ + bytes;
+  }
+};
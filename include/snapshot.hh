@@ -0,0 +1,133 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config.hh"
+#include "debug.hh"
+#include "fileio.hh"
+#include "util.hh"
+
+/**
+ * @brief Header of a table snapshot.
+ * @details A snapshot is the header page followed by the table array of the
+ * loaded database, so the mapped table is page aligned. It is valid only for
+ * the same tuple_num and the same layout of Tuple. The size of Tuple does not
+ * tell its layout, so kLayoutVersion must be incremented whenever a Tuple
+ * changes its members.
+ */
+class SnapshotHeader {
+public:
+  static constexpr uint64_t kMagic = 0x746f687370616e73;  // "snapshot"
+  // 1: silo Tuple has val_size_ and an inline value or a pointer to it.
+  // 2: silo Tuple fits in a cache line again.
+  static constexpr uint64_t kLayoutVersion = 2;
+
+  uint64_t magic_ = kMagic;
+  uint64_t tuple_num_ = 0;
+  uint64_t tuple_size_ = 0;
+  // 0 in a snapshot written before the field.
+  uint64_t layout_version_ = kLayoutVersion;
+};
+
+/**
+ * @brief write the table to the snapshot file.
+ * @details It writes a temporary file and renames it, so a reader never sees
+ * a partial snapshot.
+ */
+template<typename T>
+void writeTableSnapshot(const std::string &path, const T *table,
+                        uint64_t tuple_num) {
+  const std::string tmp_path = path + ".tmp";
+  {
+    File file(tmp_path, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    char header_page[PAGE_SIZE] = {};
+    SnapshotHeader header;
+    header.tuple_num_ = tuple_num;
+    header.tuple_size_ = sizeof(T);
+    memcpy(header_page, &header, sizeof(SnapshotHeader));
+    file.write(header_page, PAGE_SIZE);
+    file.write((const void *) table, sizeof(T) * tuple_num);
+    file.fsync();
+  }
+  if (::rename(tmp_path.c_str(), path.c_str()) != 0)
+    throw LibcError(errno, "rename failed: ");
+}
+
+/**
+ * @brief map the table of the snapshot file.
+ * @details The file is mapped privately, so updates by workers are not
+ * written back to the snapshot. With hugepage, the table is read into
+ * anonymous memory backed by huge pages by multiple threads instead, because
+ * huge pages are not available for a file mapping on ordinary file systems.
+ * @param [in] populate prefault the mapping by MAP_POPULATE.
+ * @param [in] hugepage use huge pages.
+ * @return nullptr if the snapshot does not exist or does not match.
+ */
+template<typename T>
+T *loadTableSnapshot(const std::string &path, uint64_t tuple_num,
+                     bool populate, bool hugepage) {
+  File file;
+  if (!file.open(path, O_RDONLY)) return nullptr;
+
+  SnapshotHeader header;
+  struct stat st;
+  if (::fstat(file.fd(), &st) < 0) throw LibcError(errno, "fstat failed: ");
+  const std::size_t table_size = sizeof(T) * tuple_num;
+  if ((std::size_t) st.st_size != PAGE_SIZE + table_size) return nullptr;
+  file.read(&header, sizeof(SnapshotHeader));
+  if (header.magic_ != SnapshotHeader::kMagic ||
+      header.tuple_num_ != tuple_num || header.tuple_size_ != sizeof(T) ||
+      header.layout_version_ != SnapshotHeader::kLayoutVersion)
+    return nullptr;
+
+  if (!hugepage) {
+    int flags = MAP_PRIVATE;
+    if (populate) flags |= MAP_POPULATE;
+    void *addr =
+            ::mmap(nullptr, table_size, PROT_READ | PROT_WRITE, flags, file.fd(),
+                   PAGE_SIZE);
+    if (addr == MAP_FAILED) throw LibcError(errno, "mmap failed: ");
+    return static_cast<T *>(addr);
+  }
+
+  const std::size_t huge_page_size = 2UL << 20;
+  const std::size_t map_size =
+          (table_size + huge_page_size - 1) / huge_page_size * huge_page_size;
+  void *addr = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (addr == MAP_FAILED) {
+    // no reserved huge pages. fall back to transparent huge pages.
+    addr = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) throw LibcError(errno, "mmap failed: ");
+    ::madvise(addr, map_size, MADV_HUGEPAGE);
+  }
+
+  char *table = static_cast<char *>(addr);
+  const int fd = file.fd();
+  size_t maxthread = decideParallelBuildNumber(tuple_num);
+  std::vector<std::thread> thv;
+  for (size_t i = 0; i < maxthread; ++i) {
+    thv.emplace_back([=] {
+      std::size_t start = table_size / maxthread * i;
+      std::size_t end = (i + 1 == maxthread) ? table_size
+                                             : table_size / maxthread * (i + 1);
+      while (start < end) {
+        ssize_t r = ::pread(fd, table + start, end - start, PAGE_SIZE + start);
+        if (r <= 0) ERR;
+        start += r;
+      }
+    });
+  }
+  for (auto &th : thv) th.join();
+  return reinterpret_cast<T *>(table);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "debug.hh"
+
+/**
+ * @brief One point of a parameter sweep.
+ * @details A sweep runs the points back to back in one process, so the
+ * database is built once. The engine sets its flags to the point before each
+ * run, and resets only the per-run state (epochs, Result, GC queues) between
+ * the points.
+ */
+class SweepPoint {
+public:
+  uint64_t thread_num_;
+  double zipf_skew_;
+  uint64_t rratio_;
+  uint64_t max_ope_;
+};
+
+/**
+ * @brief parse a comma separated list like "1,2,4".
+ * @param [in] dflt the value of the ordinary flag, used for an empty list.
+ */
+template <typename T>
+std::vector<T> parseSweepList(const std::string &name, const std::string &list,
+                              T dflt) {
+  std::vector<T> values;
+  if (list.empty()) {
+    values.emplace_back(dflt);
+    return values;
+  }
+  std::istringstream iss(list);
+  std::string item;
+  while (std::getline(iss, item, ',')) {
+    std::istringstream is(item);
+    T value;
+    if (!(is >> value) || !(is >> std::ws).eof()) {
+      std::cout << name << " must be a comma separated list." << std::endl;
+      ERR;
+    }
+    values.emplace_back(value);
+  }
+  return values;
+}
+
+/**
+ * @brief make the points of a sweep from the lists of the sweep_* flags.
+ * @details The points are the cartesian product of the lists in the order of
+ * thread_num, zipf_skew, rratio and max_ope, and the last one changes
+ * fastest. Without any list, it is the single point of the ordinary flags.
+ * @param [in] dflt the values of the ordinary flags.
+ */
+inline std::vector<SweepPoint> makeSweepPoints(const std::string &thread_num,
+                                               const std::string &zipf_skew,
+                                               const std::string &rratio,
+                                               const std::string &max_ope,
+                                               const SweepPoint &dflt) {
+  std::vector<SweepPoint> points;
+  for (auto th : parseSweepList("sweep_thread_num", thread_num,
+                                dflt.thread_num_)) {
+    if (th == 0) ERR;
+    for (auto skew : parseSweepList("sweep_zipf_skew", zipf_skew,
+                                    dflt.zipf_skew_)) {
+      if (skew < 0 || skew >= 1) {
+        std::cout << "zipf_skew must be 0 ~ 0.999..." << std::endl;
+        ERR;
+      }
+      for (auto rr : parseSweepList("sweep_rratio", rratio, dflt.rratio_)) {
+        if (rr > 100) ERR;
+        for (auto ope : parseSweepList("sweep_max_ope", max_ope,
+                                       dflt.max_ope_)) {
+          if (ope == 0) ERR;
+          points.push_back({th, skew, rr, ope});
+        }
+      }
+    }
+  }
+  return points;
+}
+
+/**
+ * @brief the largest thread_num of the points, for which per-thread arrays
+ * are allocated.
+ */
+inline uint64_t maxSweepThreadNum(const std::vector<SweepPoint> &points) {
+  uint64_t max = 0;
+  for (auto &point : points)
+    if (point.thread_num_ > max) max = point.thread_num_;
+  return max;
+}
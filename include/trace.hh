@@ -0,0 +1,173 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "debug.hh"
+#include "fileio.hh"
+#include "inline.hh"
+#include "procedure.hh"
+#include "util.hh"
+
+/**
+ * @brief Header of a workload trace.
+ * @details A trace is the stream of the procedures of one worker thread.
+ * After the header, each transaction is a varint of (the number of
+ * procedures << 2 | wonly << 1 | ronly), followed by a varint of
+ * (zigzag(key - previous key) << 3 | ope) for each procedure, and a varint of
+ * the scan length for SCAN. The previous key of the first procedure of the
+ * trace is 0.
+ */
+class TraceHeader {
+public:
+  static constexpr uint64_t kMagic = 0x6563617274626363;  // "ccbtrace"
+
+  uint64_t magic_ = kMagic;
+  uint64_t tuple_num_ = 0;
+  uint64_t txn_num_ = 0;
+};
+
+/**
+ * @brief the trace file of the thread.
+ */
+inline std::string tracePath(const std::string &path, size_t thid) {
+  return path + "." + std::to_string(thid);
+}
+
+/**
+ * @brief Recorder of the procedures of a worker thread.
+ */
+class TraceWriter {
+public:
+  static constexpr std::size_t kFlushSize = 1UL << 20;
+
+  TraceWriter(const std::string &path, uint64_t tuple_num)
+          : file_(path, O_CREAT | O_TRUNC | O_WRONLY, 0644) {
+    header_.tuple_num_ = tuple_num;
+    file_.write(&header_, sizeof(TraceHeader));
+    buf_.reserve(kFlushSize);
+  }
+
+  ~TraceWriter() {
+    flush();
+    if (::pwrite(file_.fd(), &header_, sizeof(TraceHeader), 0) !=
+        sizeof(TraceHeader))
+      ERR;
+  }
+
+  INLINE void append(const std::vector<Procedure> &pro) {
+    const Procedure &first = pro.front();
+    putVarint(pro.size() << 2 | (uint64_t) first.wonly_ << 1 |
+              (uint64_t) first.ronly_);
+    for (auto &p : pro) {
+      int64_t delta = (int64_t) (p.key_ - prev_key_);
+      uint64_t zigzag = ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63);
+      putVarint(zigzag << 3 | (uint64_t) p.ope_);
+      if (p.ope_ == Ope::SCAN) putVarint(p.scan_len_);
+      prev_key_ = p.key_;
+    }
+    ++header_.txn_num_;
+    if (buf_.size() >= kFlushSize) flush();
+  }
+
+private:
+  File file_;
+  TraceHeader header_;
+  std::vector<uint8_t> buf_;
+  uint64_t prev_key_ = 0;
+
+  INLINE void putVarint(uint64_t value) {
+    while (value >= 0x80) {
+      buf_.push_back((uint8_t) (value | 0x80));
+      value >>= 7;
+    }
+    buf_.push_back((uint8_t) value);
+  }
+
+  void flush() {
+    if (buf_.empty()) return;
+    file_.write(buf_.data(), buf_.size());
+    buf_.clear();
+  }
+};
+
+/**
+ * @brief Replayer of a trace recorded by TraceWriter.
+ * @details The trace is mapped and prefaulted by MAP_POPULATE, and the
+ * procedures are decoded from the mapping directly. When it reaches the end,
+ * it starts over, so a replay can run longer than the recording.
+ */
+class TraceReader {
+public:
+  TraceReader(const std::string &path, uint64_t tuple_num) {
+    File file;
+    if (!file.open(path, O_RDONLY)) {
+      std::cout << "trace " << path << " is not found." << std::endl;
+      ERR;
+    }
+    struct stat st;
+    if (::fstat(file.fd(), &st) < 0) throw LibcError(errno, "fstat failed: ");
+    size_ = st.st_size;
+    if (size_ < sizeof(TraceHeader)) ERR;
+    void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE | MAP_POPULATE,
+                        file.fd(), 0);
+    if (addr == MAP_FAILED) throw LibcError(errno, "mmap failed: ");
+    base_ = static_cast<const uint8_t *>(addr);
+
+    const TraceHeader *header = reinterpret_cast<const TraceHeader *>(base_);
+    if (header->magic_ != TraceHeader::kMagic || header->txn_num_ == 0) {
+      std::cout << path << " is not a trace." << std::endl;
+      ERR;
+    }
+    if (header->tuple_num_ > tuple_num) {
+      std::cout << "trace " << path << " needs tuple_num "
+                << header->tuple_num_ << "." << std::endl;
+      ERR;
+    }
+    pos_ = base_ + sizeof(TraceHeader);
+  }
+
+  ~TraceReader() { ::munmap(const_cast<uint8_t *>(base_), size_); }
+
+  INLINE void next(std::vector<Procedure> &pro) {
+    if (pos_ == base_ + size_) {
+      pos_ = base_ + sizeof(TraceHeader);
+      prev_key_ = 0;
+    }
+    uint64_t head = getVarint();
+    pro.clear();
+    for (uint64_t i = 0; i < head >> 2; ++i) {
+      uint64_t value = getVarint();
+      uint64_t zigzag = value >> 3;
+      int64_t delta = (int64_t) (zigzag >> 1) ^ -(int64_t) (zigzag & 1);
+      prev_key_ += (uint64_t) delta;
+      Ope ope = (Ope) (value & 7);
+      pro.emplace_back(ope, prev_key_,
+                       ope == Ope::SCAN ? (uint32_t) getVarint() : 0);
+    }
+    pro.front().ronly_ = head & 1;
+    pro.front().wonly_ = head >> 1 & 1;
+  }
+
+private:
+  const uint8_t *base_;
+  std::size_t size_;
+  const uint8_t *pos_;
+  uint64_t prev_key_ = 0;
+
+  INLINE uint64_t getVarint() {
+    uint64_t value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+      uint8_t byte = *pos_++;
+      value |= (uint64_t) (byte & 0x7f) << shift;
+      if (!(byte & 0x80)) return value;
+    }
+  }
+};
@@ -26,7 +26,9 @@
 #include <vector>
 
 #include "debug.hh"
+#include "open_loop.hh"
 #include "procedure.hh"
+#include "procedure_batch.hh"
 #include "random.hh"
 #include "result.hh"
 #include "tsc.hh"
@@ -103,10 +105,15 @@ extern void waitForReadyOfAllThread(std::atomic <size_t> &running, const size_t
     return false;
 }
 
-inline static void makeProcedure(std::vector <Procedure> &pro, Xoroshiro128Plus &rnd,
-                                 FastZipf &zipf, size_t tuple_num, size_t max_ope,
-                                 size_t thread_num, size_t rratio, bool rmw, bool ycsb,
-                                 bool partition, size_t thread_id, [[maybe_unused]]Result &res) {
+/**
+ * @brief make the procedures of a transaction.
+ * @details Keys and dice are taken from the batch. Keys have already been
+ * mapped to the zipf distribution by the batch if ycsb.
+ */
+inline static void makeProcedure(std::vector <Procedure> &pro, ProcedureBatch &batch,
+                                 size_t tuple_num, size_t max_ope, size_t thread_num,
+                                 size_t rratio, bool rmw, bool partition, size_t thread_id,
+                                 [[maybe_unused]]Result &res) {
 #if ADD_ANALYSIS
   uint64_t start = rdtscp();
 #endif
@@ -115,24 +122,15 @@ inline static void makeProcedure(std::vector <Procedure> &pro, Xoroshiro128Plus
   for (size_t i = 0; i < max_ope; ++i) {
     uint64_t tmpkey;
     // decide access destination key.
-    if (ycsb) {
-      if (partition) {
-        size_t block_size = tuple_num / thread_num;
-        tmpkey = (block_size * thread_id) + (zipf() % block_size);
-      } else {
-        tmpkey = zipf() % tuple_num;
-      }
+    if (partition) {
+      size_t block_size = tuple_num / thread_num;
+      tmpkey = (block_size * thread_id) + (batch.nextKey() % block_size);
     } else {
-      if (partition) {
-        size_t block_size = tuple_num / thread_num;
-        tmpkey = (block_size * thread_id) + (rnd.next() % block_size);
-      } else {
-        tmpkey = rnd.next() % tuple_num;
-      }
+      tmpkey = batch.nextKey() % tuple_num;
     }
 
     // decide operation type.
-    if ((rnd.next() % 100) < rratio) {
+    if (batch.nextDice() < rratio) {
       wonly_flag = false;
       pro.emplace_back(Ope::READ, tmpkey);
     } else {
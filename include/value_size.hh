@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "debug.hh"
+#include "inline.hh"
+
+/**
+ * @brief Distribution of the value sizes of the keys.
+ * @details The size of a value is a hash function of its key, so the loader,
+ * the workers and every point of a sweep agree on it. The distribution is
+ * - "" or "fixed": every value has val_size bytes.
+ * - "uniform:MIN:MAX": uniform in [MIN, MAX] bytes.
+ * - "bimodal:SMALL:LARGE:PERCENT": PERCENT % of the keys have LARGE bytes, and
+ *   the others have SMALL bytes.
+ */
+class ValueSize {
+public:
+  ValueSize(uint64_t val_size, const std::string &dist) {
+    std::vector<uint64_t> args;
+    std::string kind = parse(dist, args);
+    if (kind.empty() || kind == "fixed") {
+      kind_ = Kind::FIXED;
+      min_ = max_ = val_size;
+      if (!args.empty()) ERR;
+    } else if (kind == "uniform" && args.size() == 2) {
+      kind_ = Kind::UNIFORM;
+      min_ = args[0], max_ = args[1];
+    } else if (kind == "bimodal" && args.size() == 3 && args[2] <= 100) {
+      kind_ = Kind::BIMODAL;
+      min_ = args[0], max_ = args[1], percent_ = args[2];
+    } else {
+      std::cout << "val_size_dist must be fixed, uniform:MIN:MAX or "
+                   "bimodal:SMALL:LARGE:PERCENT."
+                << std::endl;
+      ERR;
+    }
+    if (min_ == 0 || min_ > max_ || max_ > UINT32_MAX) {
+      std::cout << "value sizes must be 1 ~ 2^32-1, and MIN <= MAX."
+                << std::endl;
+      ERR;
+    }
+  }
+
+  /**
+   * @brief the size of the value of the key.
+   */
+  INLINE uint32_t of(uint64_t key) const {
+    switch (kind_) {
+      case Kind::FIXED:
+        return min_;
+      case Kind::UNIFORM:
+        return min_ + hash(key) % (max_ - min_ + 1);
+      case Kind::BIMODAL:
+        return hash(key) % 100 < percent_ ? max_ : min_;
+      default:
+        ERR;
+    }
+  }
+
+  uint32_t max() const { return max_; }
+
+  bool fixed() const { return kind_ == Kind::FIXED; }
+
+private:
+  enum class Kind : uint8_t {
+    FIXED,
+    UNIFORM,
+    BIMODAL,
+  };
+
+  Kind kind_;
+  uint64_t min_ = 0;
+  uint64_t max_ = 0;
+  uint64_t percent_ = 0;
+
+  // the finalizer of splitmix64.
+  static INLINE uint64_t hash(uint64_t key) {
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+  }
+
+  static std::string parse(const std::string &dist,
+                           std::vector<uint64_t> &args) {
+    std::istringstream iss(dist);
+    std::string kind, item;
+    std::getline(iss, kind, ':');
+    while (std::getline(iss, item, ':')) {
+      std::istringstream is(item);
+      uint64_t value;
+      if (!(is >> value) || !(is >> std::ws).eof()) {
+        std::cout << "val_size_dist has a bad number " << item << "."
+                  << std::endl;
+        ERR;
+      }
+      args.emplace_back(value);
+    }
+    return kind;
+  }
+};
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cache_line_size.hh"
+#include "debug.hh"
+#include "inline.hh"
+#include "procedure.hh"
+#include "procedure_batch.hh"
+#include "random.hh"
+
+/**
+ * @brief Request distribution of the YCSB core workloads.
+ */
+enum class RequestDist : uint8_t {
+  UNIFORM,
+  ZIPFIAN,
+  LATEST,   // zipfian from the most recently inserted key.
+  HOTSPOT,  // kHotOpePercent of requests to the first kHotDataPercent keys.
+};
+
+/**
+ * @brief Operation mix of a YCSB core workload.
+ * @details The percentages of read, update, insert, scan, delete and
+ * read-modify-write sum to 100. Like YCSB, it draws one operation type and
+ * one key for each of max_ope operations.
+ */
+class YcsbMix {
+public:
+  static constexpr uint64_t kHotDataPercent = 20;
+  static constexpr uint64_t kHotOpePercent = 80;
+
+  bool enabled_ = false;
+  uint64_t read_ = 0;
+  uint64_t update_ = 0;
+  uint64_t insert_ = 0;
+  uint64_t scan_ = 0;
+  uint64_t delete_ = 0;
+  uint64_t rmw_ = 0;
+  RequestDist dist_ = RequestDist::ZIPFIAN;
+  uint64_t scan_len_ = 100;  // scan length is uniform in [1, scan_len_].
+
+  YcsbMix() = default;
+
+  /**
+   * @param [in] workload "a" ~ "f", "churn", or "" for the classic rratio
+   * mix.
+   * @param [in] dist "uniform", "zipfian", "latest", "hotspot", or "" for the
+   * distribution of the workload.
+   * @param [in] scan_len the maximum scan length.
+   */
+  YcsbMix(const std::string &workload, const std::string &dist,
+          uint64_t scan_len)
+          : scan_len_(scan_len) {
+    if (workload.empty()) {
+      if (!dist.empty()) {
+        std::cout << "request_dist needs ycsb_workload." << std::endl;
+        ERR;
+      }
+      return;
+    }
+    enabled_ = true;
+    if (workload == "a") {
+      read_ = 50, update_ = 50;
+    } else if (workload == "b") {
+      read_ = 95, update_ = 5;
+    } else if (workload == "c") {
+      read_ = 100;
+    } else if (workload == "d") {
+      read_ = 95, insert_ = 5, dist_ = RequestDist::LATEST;
+    } else if (workload == "e") {
+      scan_ = 95, insert_ = 5;
+    } else if (workload == "f") {
+      read_ = 50, rmw_ = 50;
+    } else if (workload == "churn") {
+      // not in YCSB. the records are inserted and deleted at the same rate.
+      read_ = 50, insert_ = 25, delete_ = 25, dist_ = RequestDist::UNIFORM;
+    } else {
+      std::cout << "ycsb_workload must be a ~ f or churn." << std::endl;
+      ERR;
+    }
+
+    if (dist == "uniform") {
+      dist_ = RequestDist::UNIFORM;
+    } else if (dist == "zipfian") {
+      dist_ = RequestDist::ZIPFIAN;
+    } else if (dist == "latest") {
+      dist_ = RequestDist::LATEST;
+    } else if (dist == "hotspot") {
+      dist_ = RequestDist::HOTSPOT;
+    } else if (!dist.empty()) {
+      std::cout << "request_dist must be uniform, zipfian, latest or hotspot."
+                << std::endl;
+      ERR;
+    }
+    if (scan_ != 0 && scan_len_ == 0) ERR;
+  }
+
+  /**
+   * @brief whether keys are drawn from the zipf distribution.
+   */
+  bool zipf() const {
+    return dist_ == RequestDist::ZIPFIAN || dist_ == RequestDist::LATEST;
+  }
+};
+
+/**
+ * @brief use the skew of YCSB for the zipfian and latest requests of
+ * ycsb_workload unless -zipf_skew is given.
+ * @details It is called right after the flags are parsed, so the skew is
+ * displayed, exported and swept like a given one.
+ */
+inline void setYcsbZipfSkew(const YcsbMix &mix, double &zipf_skew) {
+  if (!mix.enabled_ || !mix.zipf()) return;
+  if (gflags::GetCommandLineFlagInfoOrDie("zipf_skew").is_default)
+    zipf_skew = 0.99;
+}
+
+/**
+ * @brief The number of records shared by the workers.
+ * @details Keys of inserted records are taken from it in order, so the key
+ * space is [0, record number). LATEST requests are relative to it.
+ */
+class KeySpace {
+public:
+  explicit KeySpace(uint64_t tuple_num) : record_num_(tuple_num) {}
+
+  INLINE uint64_t insertKey() {
+    return record_num_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  INLINE uint64_t recordNum() const {
+    return record_num_.load(std::memory_order_relaxed);
+  }
+
+private:
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> record_num_;
+};
+
+/**
+ * @brief make the procedures of a transaction of the YCSB core workload.
+ * @details Keys of zipfian requests are in [0, tuple_num), which is the
+ * initial records, and those of uniform and hotspot requests are in the
+ * current key space. A key of a latest request is counted back from the most
+ * recently inserted key, so it may not be committed yet, and engines treat a
+ * missing key as not found.
+ * @param [in] batch draws zipf keys if the mix is zipf(), and uniform random
+ * numbers otherwise.
+ */
+inline static void makeYcsbProcedure(std::vector<Procedure> &pro,
+                                     ProcedureBatch &batch,
+                                     Xoroshiro128Plus &rnd,
+                                     const YcsbMix &mix, KeySpace &key_space,
+                                     size_t tuple_num, size_t max_ope) {
+  pro.clear();
+  bool ronly_flag(true), wonly_flag(true);
+  for (size_t i = 0; i < max_ope; ++i) {
+    uint64_t dice = batch.nextDice();
+    if (dice < mix.insert_) {
+      ronly_flag = false;
+      pro.emplace_back(Ope::INSERT, key_space.insertKey());
+      continue;
+    }
+
+    uint64_t key;
+    switch (mix.dist_) {
+      case RequestDist::UNIFORM:
+        key = batch.nextKey() % key_space.recordNum();
+        break;
+      case RequestDist::ZIPFIAN:
+        key = batch.nextKey() % tuple_num;
+        break;
+      case RequestDist::LATEST: {
+        uint64_t latest = key_space.recordNum() - 1;
+        uint64_t back = batch.nextKey() % tuple_num;
+        key = back <= latest ? latest - back : 0;
+        break;
+      }
+      case RequestDist::HOTSPOT: {
+        uint64_t record_num = key_space.recordNum();
+        uint64_t hot_num = record_num * YcsbMix::kHotDataPercent / 100;
+        if (hot_num == 0) hot_num = 1;
+        if (batch.nextDice() < YcsbMix::kHotOpePercent ||
+            hot_num == record_num)
+          key = rnd.next() % hot_num;
+        else
+          key = hot_num + rnd.next() % (record_num - hot_num);
+        break;
+      }
+      default:
+        ERR;
+    }
+
+    dice -= mix.insert_;
+    if (dice < mix.read_) {
+      wonly_flag = false;
+      pro.emplace_back(Ope::READ, key);
+    } else if ((dice -= mix.read_) < mix.update_) {
+      ronly_flag = false;
+      pro.emplace_back(Ope::WRITE, key);
+    } else if ((dice -= mix.update_) < mix.scan_) {
+      wonly_flag = false;
+      pro.emplace_back(Ope::SCAN, key, 1 + rnd.next() % mix.scan_len_);
+    } else if ((dice -= mix.scan_) < mix.delete_) {
+      ronly_flag = false;
+      pro.emplace_back(Ope::DELETE, key);
+    } else {
+      ronly_flag = false;
+      pro.emplace_back(Ope::READ_MODIFY_WRITE, key);
+    }
+  }
+
+  (*pro.begin()).ronly_ = ronly_flag;
+  (*pro.begin()).wonly_ = wonly_flag;
+}
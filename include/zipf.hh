@@ -3,8 +3,16 @@
 #include <cassert>
 #include <cfloat>
 #include <cmath>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "inline.hh"
@@ -25,7 +33,7 @@ public:
           : rnd_(rnd),
             nr_(nr),
             alpha_(1.0 / (1.0 - theta)),
-            zetan_(zeta(nr, theta)),
+            zetan_(zetaCached(nr, theta)),
             eta_((1.0 - std::pow(2.0 / (double) nr, 1.0 - theta)) /
                  (1.0 - zeta(2, theta) / zetan_)),
             threshold_(1.0 + std::pow(0.5, theta)) {
@@ -46,8 +54,16 @@ public:
     assert(theta < 1.0);  // 1.0 can not be specified.
   }
 
-  INLINE size_t operator()() {
-    double u = rnd_->next() / (double) UINT64_MAX;
+  INLINE size_t operator()() { return sample(rnd_->next()); }
+
+  /**
+   * @brief map a uniform random number to the zipf distribution.
+   * @details It is used to map random numbers generated in a batch.
+   */
+  INLINE size_t sample(uint64_t rand) const {
+    double u = rand / (double) UINT64_MAX;
+    // theta == 0. pow(x, 1) is x, and it is the most common case.
+    if (alpha_ == 1.0) return (size_t)((double) nr_ * u);
     double uz = u * zetan_;
     if (uz < 1.0) return 0;
     if (uz < threshold_) return 1;
@@ -62,4 +78,86 @@ public:
       ans += std::pow(1.0 / (double) (i + 1), theta);
     return ans;
   }
+
+  // zeta smaller than this is computed directly.
+  static constexpr size_t kZetaCacheMinNr = 1UL << 20;
+  // file of (nr, theta, zeta) lines shared by runs in the same directory.
+  static constexpr const char *kZetaCacheFile = "zeta.cache";
+
+  /**
+   * @brief zeta(nr, theta) computed once per process and per directory.
+   * @details All the worker threads construct FastZipf with the same
+   * parameters. The first one computes zeta in parallel and the others wait
+   * for it and reuse it. Large values are also appended to kZetaCacheFile, so
+   * the following runs of a parameter sweep skip the computation.
+   */
+  static double zetaCached(size_t nr, double theta) {
+    if (theta == 0.0) return (double) nr;
+    if (nr < kZetaCacheMinNr) return zeta(nr, theta);
+
+    static std::mutex mtx;
+    static std::map<std::pair<size_t, double>, double> memo;
+    std::lock_guard<std::mutex> lock(mtx);
+    auto itr = memo.find(std::make_pair(nr, theta));
+    if (itr != memo.end()) return itr->second;
+
+    double ans;
+    if (!loadZetaCache(nr, theta, ans)) {
+      ans = zetaParallel(nr, theta);
+      storeZetaCache(nr, theta, ans);
+    }
+    memo.emplace(std::make_pair(nr, theta), ans);
+    return ans;
+  }
+
+  /**
+   * @brief zeta by all the hardware threads.
+   * @details Each thread sums its chunk from the smallest term, which keeps
+   * the precision, with a simple loop the compiler can vectorize.
+   */
+  static double zetaParallel(size_t nr, double theta) {
+    size_t thread_num = std::thread::hardware_concurrency();
+    if (thread_num == 0) thread_num = 1;
+    std::vector<double> sums(thread_num, 0.0);
+    std::vector<std::thread> thv;
+    for (size_t i = 0; i < thread_num; ++i) {
+      thv.emplace_back([&sums, i, thread_num, nr, theta] {
+        size_t start = nr / thread_num * i;
+        size_t end = (i + 1 == thread_num) ? nr : nr / thread_num * (i + 1);
+        double sum = 0.0;
+        for (size_t j = end; j > start; --j)
+          sum += std::pow((double) j, -theta);
+        sums[i] = sum;
+      });
+    }
+    for (auto &th : thv) th.join();
+    double ans = 0.0;
+    for (size_t i = thread_num; i > 0; --i) ans += sums[i - 1];
+    return ans;
+  }
+
+  static bool loadZetaCache(size_t nr, double theta, double &ans) {
+    std::ifstream ifs(kZetaCacheFile);
+    std::string line;
+    while (std::getline(ifs, line)) {
+      std::istringstream iss(line);
+      std::string nr_str, theta_str, zeta_str;
+      if (!(iss >> nr_str >> theta_str >> zeta_str)) continue;
+      // hexfloat keeps the exact value.
+      if (std::strtoull(nr_str.c_str(), nullptr, 10) == nr &&
+          std::strtod(theta_str.c_str(), nullptr) == theta) {
+        ans = std::strtod(zeta_str.c_str(), nullptr);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void storeZetaCache(size_t nr, double theta, double ans) {
+    std::ostringstream oss;
+    oss << nr << " " << std::hexfloat << theta << " " << ans << "\n";
+    // one write of a short line in append mode is not interleaved.
+    std::ofstream ofs(kZetaCacheFile, std::ios::app);
+    ofs << oss.str() << std::flush;
+  }
 };
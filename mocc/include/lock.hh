@@ -1,10 +1,13 @@
 #pragma once
 
 #include <xmmintrin.h>
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <utility>
+#include <vector>
 
+#include "../../include/cache_line_size.hh"
 #include "../../include/debug.hh"
 
 #define LOCK_TIMEOUT_US 5
@@ -14,6 +17,8 @@ enum class SentinelValue : uint32_t {
   None = 0,
   Acquired,          // 1
   SuccessorLeaving,  // 2
+  NoSuccessor,       // 3, a granted reader needs not wait for its successor
+  Num,
 };
 
 enum class LockMode : uint8_t {
@@ -60,7 +65,8 @@ struct MQLMetaInfo {
   bool atomicCASNext(uint32_t oldnext, uint32_t newnext);
 };
 
-class MQLNode {
+// a qnode is spun on by its owner, so it has its own cache line.
+class alignas(CACHE_LINE_SIZE) MQLNode {
 public:
   // interact with predecessor
   std::atomic <LockMode> type;
@@ -93,6 +99,45 @@ public:
   bool atomicCASSucInfo(MQLMetaInfo expected, MQLMetaInfo desired);
 };
 
+/**
+ * @brief Per-thread pool of qnodes of MQLock.
+ * @details A qnode is identified by the id in MQLNodeTable, which the lock
+ * and the neighbors in its queue store. The ids below kIdBase are
+ * SentinelValue, and a thread owns slotNum(max_ope) ids from kIdBase + thid *
+ * slotNum(max_ope). A transaction uses one qnode per record it locks, so the
+ * qnodes take O(thread_num * max_ope) memory instead of one per thread and
+ * record. A qnode is reused after its lock is released or cancelled, and the
+ * last released one is reused first, so it is likely in the cache.
+ */
+class MQLNodePool {
+public:
+  static constexpr uint32_t kIdBase = (uint32_t) SentinelValue::Num;
+
+  /**
+   * one more than max_ope for the reader lock released by an upgrade.
+   */
+  static uint32_t slotNum(uint64_t max_ope) { return max_ope + 1; }
+
+  MQLNodePool(uint32_t thid, uint64_t max_ope) {
+    uint32_t slot_num = slotNum(max_ope);
+    free_.reserve(slot_num);
+    for (uint32_t slot = slot_num; slot > 0; --slot)
+      free_.emplace_back(kIdBase + thid * slot_num + slot - 1);
+  }
+
+  uint32_t get() {
+    if (free_.empty()) ERR;
+    uint32_t id = free_.back();
+    free_.pop_back();
+    return id;
+  }
+
+  void put(uint32_t id) { free_.emplace_back(id); }
+
+private:
+  std::vector<uint32_t> free_;
+};
+
 class MQLock {
 public:
   std::atomic<unsigned int> nreaders;
@@ -105,40 +150,47 @@ public:
     next_writer = 0;
   }
 
-  MQL_RESULT acquire_reader_lock(uint32_t me, unsigned int key, bool trylock);
+  /**
+   * @brief whether a writer may hold the lock, for optimistic reads.
+   * @details A writer holds it only without readers, and a reader in the
+   * queue is counted after it is granted, so it may be true without a writer
+   * but is never false with one.
+   */
+  bool writer_locked() {
+    return tail.load(std::memory_order_acquire) !=
+                   (uint32_t) SentinelValue::None &&
+           nreaders.load(std::memory_order_acquire) == 0;
+  }
+
+  MQL_RESULT acquire_reader_lock(uint32_t me, bool trylock);
 
-  MQL_RESULT acquire_writer_lock(uint32_t me, unsigned int key, bool trylock);
+  MQL_RESULT acquire_writer_lock(uint32_t me, bool trylock);
 
-  MQL_RESULT acquire_reader_lock_check_reader_pred(uint32_t me,
-                                                   unsigned int key,
-                                                   uint32_t pred, bool trylock);
+  MQL_RESULT acquire_reader_lock_check_reader_pred(uint32_t me, uint32_t pred,
+                                                   bool trylock);
 
-  MQL_RESULT acquire_reader_lock_check_writer_pred(uint32_t me,
-                                                   unsigned int key,
-                                                   uint32_t pred, bool trylock);
+  MQL_RESULT acquire_reader_lock_check_writer_pred(uint32_t me, uint32_t pred,
+                                                   bool trylock);
 
-  MQL_RESULT cancel_reader_lock(uint32_t me, unsigned int key);
+  MQL_RESULT cancel_reader_lock(uint32_t me);
 
-  MQL_RESULT cancel_reader_lock_relink(uint32_t pred, uint32_t me,
-                                       unsigned int key);
+  MQL_RESULT cancel_reader_lock_relink(uint32_t pred, uint32_t me);
 
-  MQL_RESULT cancel_reader_lock_with_reader_pred(uint32_t me, unsigned int key,
-                                                 uint32_t pred);
+  MQL_RESULT cancel_reader_lock_with_reader_pred(uint32_t me, uint32_t pred);
 
-  MQL_RESULT cancel_reader_lock_with_writer_pred(uint32_t me, unsigned int key,
-                                                 uint32_t pred);
+  MQL_RESULT cancel_reader_lock_with_writer_pred(uint32_t me, uint32_t pred);
 
-  MQL_RESULT cancel_writer_lock(uint32_t me, unsigned int key);
+  MQL_RESULT cancel_writer_lock(uint32_t me);
 
-  MQL_RESULT cancel_writer_lock_no_pred(uint32_t me, unsigned int key);
+  MQL_RESULT cancel_writer_lock_no_pred(uint32_t me);
 
-  void release_reader_lock(uint32_t me, unsigned int key);
+  void release_reader_lock(uint32_t me);
 
-  void release_writer_lock(uint32_t me, unsigned int key);
+  void release_writer_lock(uint32_t me);
 
-  MQL_RESULT finish_acquire_reader_lock(uint32_t me, unsigned int key);
+  MQL_RESULT finish_acquire_reader_lock(uint32_t me);
 
-  void finish_release_reader_lock(uint32_t me, unsigned int key);
+  void finish_release_reader_lock(uint32_t me);
 };
 
 class RWLock {
@@ -170,9 +222,10 @@ public:
   unsigned int key_;  // record を識別する．
   T *lock_;
   bool mode_;  // 0 read-mode, 1 write-mode
+  uint32_t qnode_;  // id of the qnode of MQLock.
 
-  LockElement(unsigned int key, T *lock, bool mode)
-          : key_(key), lock_(lock), mode_(mode) {}
+  LockElement(unsigned int key, T *lock, bool mode, uint32_t qnode = 0)
+          : key_(key), lock_(lock), mode_(mode), qnode_(qnode) {}
 
   bool operator<(const LockElement &right) const {
     return this->key_ < right.key_;
@@ -183,6 +236,7 @@ public:
     key_ = other.key_;
     lock_ = other.lock_;
     mode_ = other.mode_;
+    qnode_ = other.qnode_;
   }
 
   // move constructor
@@ -190,6 +244,7 @@ public:
     key_ = other.key_;
     lock_ = other.lock_;
     mode_ = other.mode_;
+    qnode_ = other.qnode_;
   }
 
   LockElement &operator=(LockElement &&other) noexcept {
@@ -197,7 +252,22 @@ public:
       key_ = other.key_;
       lock_ = other.lock_;
       mode_ = other.mode_;
+      qnode_ = other.qnode_;
     }
     return *this;
   }
 };
+
+/**
+ * @brief the first element of the lock list whose key is not less than key.
+ * @details CLL_ and RLL_ are kept sorted by key, so a lookup, the insertion
+ * point and the locks violating the canonical mode are found by binary
+ * search.
+ */
+template<typename T>
+typename std::vector<LockElement<T>>::iterator
+lowerBound(std::vector<LockElement<T>> &list, uint64_t key) {
+  return std::lower_bound(
+          list.begin(), list.end(), key,
+          [](const LockElement<T> &le, uint64_t k) { return le.key_ < k; });
+}
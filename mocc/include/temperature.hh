@@ -0,0 +1,140 @@
+#pragma once
+
+#include <stdlib.h>
+#include <algorithm>
+#include <cstdint>
+
+#include "../../include/atomic_wrapper.hh"
+#include "../../include/cache_line_size.hh"
+#include "../../include/debug.hh"
+#include "../../include/inline.hh"
+#include "../../include/random.hh"
+#include "tuple.hh"
+
+/**
+ * @brief temperature of a counter decayed to the epoch.
+ * @details A temperature is a log2 count, so losing one per elapsed epoch
+ * halves the count per epoch.
+ */
+INLINE uint64_t decayedTemp(const Epotemp &epotemp, uint64_t epoch) {
+  uint64_t age = epoch > epotemp.epoch ? epoch - epotemp.epoch : 0;
+  return epotemp.temp > age ? epotemp.temp - age : 0;
+}
+
+/**
+ * @brief Count-min sketch of the temperature of each record.
+ * @details EpotempAry counts the failed verifications of per_xx_temp bytes,
+ * so cold records sharing a page with a hot one are locked too. The sketch
+ * counts them per record in kDepth rows, and the temperature of a record is
+ * the minimum of its counters, which is not less than its own. A counter is
+ * an approximate counter like EpotempAry, and only the minimum counters are
+ * increased, so a collision raises the estimate at most to the temperature of
+ * the hotter record. A counter decays by one per epoch instead of being reset.
+ */
+class TemperatureSketch {
+public:
+  static constexpr std::size_t kDepth = 2;
+
+  bool enabled() const { return counters_ != nullptr; }
+
+  /**
+   * @param [in] width counters per row. It is rounded up to a power of two,
+   * and 0 disables the sketch.
+   */
+  void init(uint64_t width) {
+    if (width == 0) return;
+    uint64_t row_size = 1;
+    while (row_size < width) row_size <<= 1;
+    mask_ = row_size - 1;
+    if (posix_memalign((void **) &counters_, CACHE_LINE_SIZE,
+                       kDepth * row_size * sizeof(uint64_t)) != 0)
+      ERR;
+    std::fill(counters_, counters_ + kDepth * row_size, 0);
+  }
+
+  INLINE uint64_t temp(uint64_t key, uint64_t epoch) {
+    uint64_t min = TEMP_MAX;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      Epotemp counter;
+      counter.obj_ = loadAcquire(counters_[index(key, row)]);
+      min = std::min(min, decayedTemp(counter, epoch));
+    }
+    return min;
+  }
+
+  /**
+   * @brief count a failed verification of the record.
+   */
+  void heat(uint64_t key, uint64_t epoch, Xoroshiro128Plus &rnd) {
+    uint64_t min = temp(key, epoch);
+    if (min == TEMP_MAX || rnd.next() % (1 << min) != 0) return;
+
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      uint64_t &counter = counters_[index(key, row)];
+      Epotemp expected, desired(min + 1, epoch);
+      expected.obj_ = loadAcquire(counter);
+      for (;;) {
+        if (decayedTemp(expected, epoch) > min) break;
+        if (compareExchange(counter, expected.obj_, desired.obj_)) break;
+      }
+    }
+  }
+
+private:
+  uint64_t *counters_ = nullptr;
+  uint64_t mask_ = 0;
+
+  /**
+   * @details each row uses 32 bits of a splitmix64 hash of the key.
+   */
+  INLINE uint64_t index(uint64_t key, std::size_t row) {
+    uint64_t hash = key + 0x9e3779b97f4a7c15;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+    hash ^= hash >> 31;
+    return row * (mask_ + 1) + ((hash >> (32 * row)) & mask_);
+  }
+};
+
+#if ADD_ANALYSIS
+/**
+ * @brief Exact count of the failed verifications of each record.
+ * @details It is halved per epoch like the temperature, and an approximate
+ * counter of temperature t estimates the count 2^t - 1, so a record is
+ * genuinely hot if its count is at least 2^TEMP_THRESHOLD - 1. A lock by
+ * temperature on a record which is not genuinely hot is a false positive.
+ */
+class RecordHeat {
+public:
+  void init(uint64_t tuple_num) {
+    if (posix_memalign((void **) &counts_, CACHE_LINE_SIZE,
+                       tuple_num * sizeof(uint64_t)) != 0)
+      ERR;
+    std::fill(counts_, counts_ + tuple_num, 0);
+  }
+
+  void heat(uint64_t key, uint64_t epoch) {
+    Epotemp expected, desired;
+    expected.obj_ = loadAcquire(counts_[key]);
+    for (;;) {
+      desired.temp = count(expected, epoch) + 1;
+      desired.epoch = epoch;
+      if (compareExchange(counts_[key], expected.obj_, desired.obj_)) break;
+    }
+  }
+
+  bool hot(uint64_t key, uint64_t epoch) {
+    Epotemp counter;
+    counter.obj_ = loadAcquire(counts_[key]);
+    return count(counter, epoch) >= (1U << TEMP_THRESHOLD) - 1;
+  }
+
+private:
+  uint64_t *counts_ = nullptr;  // the count is in the temp field of Epotemp.
+
+  static uint64_t count(const Epotemp &counter, uint64_t epoch) {
+    uint64_t age = epoch > counter.epoch ? epoch - counter.epoch : 0;
+    return age < 32 ? counter.temp >> age : 0;
+  }
+};
+#endif
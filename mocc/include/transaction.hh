@@ -40,12 +40,19 @@ public:
   Tidword max_wset_;
   Xoroshiro128Plus *rnd_;
   Result *mres_;
+#ifdef MQLOCK
+  MQLNodePool qnodes_;
+#endif  // MQLOCK
 
   char write_val_[VAL_SIZE] = {};
   char return_val_[VAL_SIZE] = {};
 
   TxExecutor(int thid, Xoroshiro128Plus *rnd, Result *mres)
-          : thid_(thid), mres_(mres) {
+          : thid_(thid), mres_(mres)
+#ifdef MQLOCK
+          , qnodes_(thid, FLAGS_max_ope)
+#endif  // MQLOCK
+  {
     read_set_.reserve(FLAGS_max_ope);
     write_set_.reserve(FLAGS_max_ope);
     pro_set_.reserve(FLAGS_max_ope);
@@ -69,6 +76,10 @@ public:
 
   void removeFromCLL(uint64_t key);
 
+  bool isHot(uint64_t key);
+
+  void lockedByTemperature(uint64_t key);
+
   void begin();
 
   void read(uint64_t key);
@@ -79,6 +90,12 @@ public:
 
   void lock(uint64_t key, Tuple *tuple, bool mode);
 
+#ifdef MQLOCK
+  bool mqlAcquire(uint64_t key, MQLock *lock, bool mode, bool trylock);
+
+  void mqlRelease(LockElement<MQLock> &le);
+#endif  // MQLOCK
+
   void construct_RLL();  // invoked on abort;
   void unlockCLL();
 
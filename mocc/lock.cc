@@ -113,8 +113,8 @@ bool MQLMetaInfo::atomicCASNext(uint32_t oldnext, uint32_t newnext) {
 }
 
 MQL_RESULT
-MQLock::acquire_reader_lock(uint32_t me, unsigned int key, bool trylock) {
-  MQLNode *qnode = &MQLNodeTable[me][key];
+MQLock::acquire_reader_lock(uint32_t me, bool trylock) {
+  MQLNode *qnode = &MQLNodeTable[me];
   qnode->init(LockMode::Reader, (uint32_t)SentinelValue::None, false, false,
               LockMode::None, LockStatus::Waiting,
               (uint32_t)SentinelValue::None);
@@ -123,19 +123,19 @@ MQLock::acquire_reader_lock(uint32_t me, unsigned int key, bool trylock) {
   if (p == (uint32_t)SentinelValue::None) {
     nreaders++;
     qnode->granted.store(true, std::memory_order_release);
-    return finish_acquire_reader_lock(me, key);
+    return finish_acquire_reader_lock(me);
   }
 
-  MQLNode *pred = &MQLNodeTable[p][key];
+  MQLNode *pred = &MQLNodeTable[p];
   // haven't set pred.next.id yet, safe to dereference pred
   if (pred->type.load(std::memory_order_acquire) == LockMode::Reader)
-    return acquire_reader_lock_check_reader_pred(me, key, p, trylock);
-  return acquire_reader_lock_check_writer_pred(me, key, p, trylock);
+    return acquire_reader_lock_check_reader_pred(me, p, trylock);
+  return acquire_reader_lock_check_writer_pred(me, p, trylock);
 }
 
 MQL_RESULT
-MQLock::finish_acquire_reader_lock(uint32_t me, unsigned int key) {
-  MQLNode *qnode = &MQLNodeTable[me][key];
+MQLock::finish_acquire_reader_lock(uint32_t me) {
+  MQLNode *qnode = &MQLNodeTable[me];
   qnode->sucInfo.atomicStoreBusy(true);
   qnode->sucInfo.atomicStoreStatus(LockStatus::Granted);
 
@@ -156,8 +156,9 @@ MQLock::finish_acquire_reader_lock(uint32_t me, unsigned int key) {
     ;
 
   uint32_t sucnum = qnode->sucInfo.atomicLoadNext();
-  MQLNode *suc = &MQLNodeTable[sucnum][key];
+  MQLNode *suc = &MQLNodeTable[sucnum];
   if (sucnum == (uint32_t)SentinelValue::None ||
+      sucnum == (uint32_t)SentinelValue::NoSuccessor ||
       suc->type.load(std::memory_order_acquire) == LockMode::Writer) {
     qnode->sucInfo.atomicStoreBusy(false);
     return MQL_RESULT::Acquired;
@@ -192,7 +193,7 @@ MQLock::finish_acquire_reader_lock(uint32_t me, unsigned int key) {
     nreaders++;
     suc->granted.store(true, std::memory_order_release);
     // make sure I know when releasing no need to wait
-    qnode->sucInfo.atomicStoreNext((uint32_t)SentinelValue::None);
+    qnode->sucInfo.atomicStoreNext((uint32_t)SentinelValue::NoSuccessor);
   } else if (qnode->sucInfo.atomicLoadStype() == LockMode::Reader) {
     for (;;) {
       while (suc->prev.load(std::memory_order_acquire) == me)
@@ -202,7 +203,7 @@ MQLock::finish_acquire_reader_lock(uint32_t me, unsigned int key) {
               std::memory_order_acquire)) {
         nreaders++;
         suc->granted.store(true, std::memory_order_release);
-        qnode->sucInfo.atomicStoreNext((uint32_t)SentinelValue::None);
+        qnode->sucInfo.atomicStoreNext((uint32_t)SentinelValue::NoSuccessor);
         break;
       }
     }
@@ -213,12 +214,12 @@ MQLock::finish_acquire_reader_lock(uint32_t me, unsigned int key) {
 }
 
 MQL_RESULT
-MQLock::acquire_reader_lock_check_reader_pred(uint32_t me, unsigned int key,
-                                              uint32_t pred, bool trylock) {
+MQLock::acquire_reader_lock_check_reader_pred(uint32_t me, uint32_t pred,
+                                              bool trylock) {
 check_pred:
   uint32_t pretail;
-  MQLNode *qnode = &MQLNodeTable[me][key];
-  MQLNode *p = &MQLNodeTable[pred][key];
+  MQLNode *qnode = &MQLNodeTable[me];
+  MQLNode *p = &MQLNodeTable[pred];
   // wait for the previous canceling dude to leave
   while (!(p->sucInfo.atomicLoadNext() == (uint32_t)SentinelValue::None &&
            p->sucInfo.atomicLoadStype() == LockMode::None))
@@ -234,6 +235,9 @@ check_pred:
   if (p->sucInfo.atomicLoadBusy() == false &&
       p->sucInfo.atomicLoadStype() == LockMode::Reader &&
       p->sucInfo.atomicLoadStatus() == LockStatus::Waiting) {  // succeeded
+    // pred may wake me up as soon as it sees me on its next, and it waits for
+    // me.prev to be pred, so set it first.
+    qnode->prev.store(pred, std::memory_order_release);
     // link_pred(pred, me)
     p->sucInfo.atomicStoreNext(me);
 
@@ -242,14 +246,14 @@ check_pred:
     // return cancel_reader_lock
     if (trylock) {
       if (qnode->granted.load(std::memory_order_acquire))
-        return finish_acquire_reader_lock(me, key);
+        return finish_acquire_reader_lock(me);
       else
-        return cancel_reader_lock(me, key);
+        return cancel_reader_lock(me);
     } else {
       // tanabe. trylock でないなら，無限に待つべき．
       while (qnode->granted.load(std::memory_order_acquire) != true)
         ;
-      return finish_acquire_reader_lock(me, key);
+      return finish_acquire_reader_lock(me);
     }
   }
 
@@ -268,11 +272,11 @@ check_pred:
     if (pretail == (uint32_t)SentinelValue::Acquired) {
       while (qnode->granted.load(std::memory_order_acquire) != true)
         ;
-      return finish_acquire_reader_lock(me, key);
+      return finish_acquire_reader_lock(me);
     }
-    p = &MQLNodeTable[pretail][key];
+    p = &MQLNodeTable[pretail];
     if (p->type.load(std::memory_order_acquire) == LockMode::Writer)
-      return acquire_reader_lock_check_writer_pred(me, key, pretail, trylock);
+      return acquire_reader_lock_check_writer_pred(me, pretail, trylock);
     pred = pretail;
     goto check_pred;  // p must point to a valid predecessor;
   } else {
@@ -282,25 +286,25 @@ check_pred:
     // For direct_granted,
     // also set its next.id to None so it knows that there's no need to wait and
     // examine successor upon release. This also covers the
-    // case when pred.next.flags has Busy set.
-    p->sucInfo.atomicStoreNext((uint32_t)SentinelValue::None);
+    // case when pred.next.flags has Busy set. It must not be None, or pred
+    // releasing now would wait for me forever.
+    p->sucInfo.atomicStoreNext((uint32_t)SentinelValue::NoSuccessor);
     nreaders++;
     qnode->granted.store(true, std::memory_order_release);
-    return finish_acquire_reader_lock(me, key);
+    return finish_acquire_reader_lock(me);
   }
 }
 
 MQL_RESULT
-MQLock::cancel_reader_lock(uint32_t me, unsigned int key) {
-  NNN;
-  MQLNode *qnode = &MQLNodeTable[me][key];
+MQLock::cancel_reader_lock(uint32_t me) {
+  MQLNode *qnode = &MQLNodeTable[me];
   uint32_t pred = qnode->prev.exchange((uint32_t)SentinelValue::None);
   // prevent from cancelling
 
   if (pred == (uint32_t)SentinelValue::Acquired) {
     while (qnode->granted.load(std::memory_order_acquire) != true)
       ;
-    return finish_acquire_reader_lock(me, key);
+    return finish_acquire_reader_lock(me);
   }
 
   // make sure successor can't leave, unless it tried to leave first
@@ -311,20 +315,18 @@ MQLock::cancel_reader_lock(uint32_t me, unsigned int key) {
 
   // pred not equal qnode->prev.
   // この関数冒頭で exchange しているから．
-  if (MQLNodeTable[pred][key].type.load(std::memory_order_acquire) ==
+  if (MQLNodeTable[pred].type.load(std::memory_order_acquire) ==
       LockMode::Reader) {
-    return cancel_reader_lock_with_reader_pred(me, key, pred);
+    return cancel_reader_lock_with_reader_pred(me, pred);
   }
-  return cancel_reader_lock_with_writer_pred(me, key, pred);
+  return cancel_reader_lock_with_writer_pred(me, pred);
 }
 
 MQL_RESULT
-MQLock::cancel_reader_lock_with_writer_pred(uint32_t me, unsigned int key,
-                                            uint32_t pred) {
-  NNN;
+MQLock::cancel_reader_lock_with_writer_pred(uint32_t me, uint32_t pred) {
 retry:
-  MQLNode *qnode = &MQLNodeTable[me][key];
-  MQLNode *p = &MQLNodeTable[pred][key];
+  MQLNode *qnode = &MQLNodeTable[me];
+  MQLNode *p = &MQLNodeTable[pred];
   // wait for the cancelling pred to finish relink
   // spin until pred.next is me and pred.stype is Reader
   // pred is a writer, so I can go as long as it's not also leaving (cancelling
@@ -344,7 +346,7 @@ retry:
           pred == (uint32_t)SentinelValue::Acquired) {
         while (qnode->granted.load(std::memory_order_acquire) != true)
           ;
-        return finish_acquire_reader_lock(me, key);
+        return finish_acquire_reader_lock(me);
       } else {
         // make sure successor can't leave, unless it tried to leave first
         qnode->sucInfo.atomicStoreStatus(LockStatus::Leaving);
@@ -352,10 +354,10 @@ retry:
                (uint32_t)SentinelValue::SuccessorLeaving)
           ;
         // (tanabe) pred may be changed to new value at L:340
-        p = &MQLNodeTable[pred][key];
+        p = &MQLNodeTable[pred];
         if (p->type.load(std::memory_order_acquire) == LockMode::Reader)
           // (tanabe) if it gets new reader pred, it executes cancel for reader
-          return cancel_reader_lock_with_reader_pred(me, key, pred);
+          return cancel_reader_lock_with_reader_pred(me, pred);
         // (tanabe) get new pred because old pred left.
         goto retry;
       }
@@ -363,10 +365,10 @@ retry:
       qnode->prev.store(pred, std::memory_order_release);
       while (qnode->granted.load(std::memory_order_acquire) != true)
         ;
-      return finish_acquire_reader_lock(me, key);
+      return finish_acquire_reader_lock(me);
     }
     // try to tell pred I'm leaving
-    p = &MQLNodeTable[pred][key];
+    p = &MQLNodeTable[pred];
     MQLMetaInfo expected, desired;
     expected = eflags;
     expected.next = me;
@@ -380,23 +382,21 @@ retry:
   if (qnode->sucInfo.atomicLoadNext() == (uint32_t)SentinelValue::None &&
       tail.compare_exchange_strong(me, pred, std::memory_order_acq_rel,
                                    std::memory_order_acquire)) {
-    p = &MQLNodeTable[pred][key];
+    p = &MQLNodeTable[pred];
     p->sucInfo.atomicStoreStype(LockMode::None);
     p->sucInfo.atomicStoreNext((uint32_t)SentinelValue::None);
     return MQL_RESULT::Cancelled;
   }
 
-  cancel_reader_lock_relink(pred, me, key);
+  cancel_reader_lock_relink(pred, me);
   return MQL_RESULT::Cancelled;
 }
 
 MQL_RESULT
-MQLock::cancel_reader_lock_with_reader_pred(uint32_t me, unsigned int key,
-                                            uint32_t pred) {
-  NNN;
+MQLock::cancel_reader_lock_with_reader_pred(uint32_t me, uint32_t pred) {
 retry:
-  MQLNode *qnode = &MQLNodeTable[me][key];
-  MQLNode *p = &MQLNodeTable[pred][key];
+  MQLNode *qnode = &MQLNodeTable[me];
+  MQLNode *p = &MQLNodeTable[pred];
   // now successor can't attach to me assuming I'm waiting or has already done
   // so. CAS out of pred.next (including id and flags) wait for the canceling
   // pred to finish the relink spin until pred.stype is Reader and (pred.next is
@@ -418,7 +418,7 @@ retry:
       qnode->prev.store(pred, std::memory_order_release);
       while (qnode->granted.load(std::memory_order_acquire) != true)
         ;
-      return finish_acquire_reader_lock(me, key);
+      return finish_acquire_reader_lock(me);
     } else {
       // pred is trying to leave, wait for a new pred or being waken up
       // pred has higher priority to leave, and it should already have me on its
@@ -431,11 +431,11 @@ retry:
       if (pred == (uint32_t)SentinelValue::Acquired) {
         while (qnode->granted.load(std::memory_order_acquire) != true)
           ;
-        return finish_acquire_reader_lock(me, key);
+        return finish_acquire_reader_lock(me);
       }
-      MQLNode *p = &MQLNodeTable[pred][key];
+      MQLNode *p = &MQLNodeTable[pred];
       if (p->type.load(std::memory_order_acquire) == LockMode::Writer)
-        return cancel_reader_lock_with_writer_pred(me, key, pred);
+        return cancel_reader_lock_with_writer_pred(me, pred);
       goto retry;
     }
   } else {
@@ -450,17 +450,15 @@ retry:
       p->sucInfo.atomicStoreNext((uint32_t)SentinelValue::None);
       return MQL_RESULT::Cancelled;
     }
-    cancel_reader_lock_relink(pred, me, key);
+    cancel_reader_lock_relink(pred, me);
   }
   return MQL_RESULT::Cancelled;
 }
 
 MQL_RESULT
-MQLock::cancel_reader_lock_relink(uint32_t pred, uint32_t me,
-                                  unsigned int key) {
-  NNN;
-  MQLNode *qnode = &MQLNodeTable[me][key];
-  MQLNode *p = &MQLNodeTable[pred][key];
+MQLock::cancel_reader_lock_relink(uint32_t pred, uint32_t me) {
+  MQLNode *qnode = &MQLNodeTable[me];
+  MQLNode *p = &MQLNodeTable[pred];
   while (qnode->sucInfo.atomicLoadNext() == (uint32_t)SentinelValue::None)
     ;
   for (;;) {  // preserve pred.flags
@@ -476,7 +474,7 @@ MQLock::cancel_reader_lock_relink(uint32_t pred, uint32_t me,
   // I believe we should do this after setting pred.id, see the comment in
   // cancel_writer_lock. retry untill CAS(me,next.prev, me, pred) is True
   for (;;) {
-    MQLNode *suc = &MQLNodeTable[qnode->sucInfo.atomicLoadNext()][key];
+    MQLNode *suc = &MQLNodeTable[qnode->sucInfo.atomicLoadNext()];
     uint32_t expected = me;
     if (suc->prev.compare_exchange_strong(expected, pred,
                                           std::memory_order_acq_rel,
@@ -487,37 +485,37 @@ MQLock::cancel_reader_lock_relink(uint32_t pred, uint32_t me,
 }
 
 MQL_RESULT
-MQLock::acquire_reader_lock_check_writer_pred(uint32_t me, unsigned int key,
-                                              uint32_t pred, bool trylock) {
+MQLock::acquire_reader_lock_check_writer_pred(uint32_t me, uint32_t pred,
+                                              bool trylock) {
   // wait for the previous canceling dude to leave spin
   // until pred.next is NULL and pred.stype is None
   // pred is a writer, we have to wait anyway, so register and wait with timeout
-  MQLNode *qnode = &MQLNodeTable[me][key];
-  MQLNode *p = &MQLNodeTable[pred][key];
+  MQLNode *qnode = &MQLNodeTable[me];
+  MQLNode *p = &MQLNodeTable[pred];
   p->sucInfo.atomicStoreStype(LockMode::Reader);
   p->sucInfo.atomicStoreNext(me);
   if (qnode->prev.exchange(pred) == (uint32_t)SentinelValue::Acquired) {
     while (qnode->granted.load(std::memory_order_acquire) != true)
       ;
-    return finish_acquire_reader_lock(me, key);
+    return finish_acquire_reader_lock(me);
   }
 
   if (trylock) {
     if (qnode->granted.load(std::memory_order_acquire))
-      return finish_acquire_reader_lock(me, key);
+      return finish_acquire_reader_lock(me);
     else
-      return cancel_reader_lock(me, key);
+      return cancel_reader_lock(me);
   } else {
     while (qnode->granted.load(std::memory_order_acquire) != true)
       ;
-    return finish_acquire_reader_lock(me, key);
+    return finish_acquire_reader_lock(me);
   }
 }
 
-void MQLock::release_reader_lock(uint32_t me, unsigned int key) {
+void MQLock::release_reader_lock(uint32_t me) {
   // make sure successor can't leave; readers, however, can still get the lock
   // as usual by seeing me.next.flags.granted set
-  MQLNode *qnode = &MQLNodeTable[me][key];
+  MQLNode *qnode = &MQLNodeTable[me];
   qnode->sucInfo.atomicStoreBusy(true);
   while (qnode->sucInfo.atomicLoadNext() ==
          (uint32_t)SentinelValue::SuccessorLeaving)
@@ -529,18 +527,19 @@ void MQLock::release_reader_lock(uint32_t me, unsigned int key) {
     if (tail.compare_exchange_strong(expected, (uint32_t)SentinelValue::None,
                                      std::memory_order_acq_rel,
                                      std::memory_order_acquire)) {
-      return finish_release_reader_lock(me, key);
+      return finish_release_reader_lock(me);
     }
-    printf("th %d : rl rl %d : next %d tail %d\n", me, key,
-           qnode->sucInfo.atomicLoadNext(), tail.load());
+    _mm_pause();
   }
 
   if (qnode->sucInfo.atomicLoadNext() != (uint32_t)SentinelValue::None &&
+      qnode->sucInfo.atomicLoadNext() !=
+              (uint32_t)SentinelValue::NoSuccessor &&
       qnode->sucInfo.atomicLoadStype() == LockMode::Writer) {
     // put it in next_writer
     next_writer = (uint32_t)qnode->sucInfo.atomicLoadNext();
     // also tell successor it doesn't have pred any more
-    MQLNode *suc = &MQLNodeTable[next_writer][key];
+    MQLNode *suc = &MQLNodeTable[next_writer];
     expected = me;
     while (!suc->prev.compare_exchange_strong(
         expected, (uint32_t)SentinelValue::None, std::memory_order_acq_rel,
@@ -549,10 +548,10 @@ void MQLock::release_reader_lock(uint32_t me, unsigned int key) {
     }
   }
 
-  return finish_release_reader_lock(me, key);
+  return finish_release_reader_lock(me);
 }
 
-void MQLock::finish_release_reader_lock(uint32_t me, unsigned int key) {
+void MQLock::finish_release_reader_lock([[maybe_unused]] uint32_t me) {
   if (nreaders.fetch_sub(1) == 1) {
     // I'm the last reader, must handle the next writer.
     uint32_t nw = next_writer;
@@ -563,25 +562,25 @@ void MQLock::finish_release_reader_lock(uint32_t me, unsigned int key) {
                                             std::memory_order_acquire)) {
       for (;;) {
         uint32_t expected = (uint32_t)SentinelValue::None;
-        if (MQLNodeTable[nw][key].prev.compare_exchange_strong(
+        if (MQLNodeTable[nw].prev.compare_exchange_strong(
                 expected, (uint32_t)SentinelValue::Acquired,
                 std::memory_order_acq_rel, std::memory_order_acquire))
           break;
       }
-      MQLNodeTable[nw][key].granted.store(true, std::memory_order_release);
+      MQLNodeTable[nw].granted.store(true, std::memory_order_release);
     }
   }
 }
 
 MQL_RESULT
-MQLock::acquire_writer_lock(uint32_t me, unsigned int key, bool trylock) {
-  MQLNode *qnode = &MQLNodeTable[me][key];
+MQLock::acquire_writer_lock(uint32_t me, bool trylock) {
+  MQLNode *qnode = &MQLNodeTable[me];
   qnode->init(LockMode::Writer, (uint32_t)SentinelValue::None, false, false,
               LockMode::None, LockStatus::Waiting,
               (uint32_t)SentinelValue::None);
 
   uint32_t pred = tail.exchange(me);
-  MQLNode *p = &MQLNodeTable[pred][key];
+  MQLNode *p = &MQLNodeTable[pred];
   if (pred == (uint32_t)SentinelValue::None) {
     next_writer.store(me, std::memory_order_release);
     if (nreaders.load(std::memory_order_acquire) == 0 &&
@@ -590,14 +589,12 @@ MQLock::acquire_writer_lock(uint32_t me, unsigned int key, bool trylock) {
       return MQL_RESULT::Acquired;
     }
   } else {
-    // MQLNode *p = &MQLNodeTable[pred][key];
+    // MQLNode *p = &MQLNodeTable[pred];
     // spin until pred.stype is None and pred.next is NULL
     while (!(p->sucInfo.atomicLoadStype() == LockMode::None &&
              p->sucInfo.atomicLoadNext() == (uint32_t)SentinelValue::None)) {
-      printf("th %d : aq wl %d : p->stype %d p->next %d\n", me, key,
-             (int)p->sucInfo.atomicLoadStype(), p->sucInfo.atomicLoadNext());
+      _mm_pause();
     }
-    // printf("th %d : acquire wl %d\n", me, key);
     // register on pred.flags as a writer successor,
     // then fill in pred.next.id and wait
     // must register on pred.flags first
@@ -619,19 +616,19 @@ MQLock::acquire_writer_lock(uint32_t me, unsigned int key, bool trylock) {
       qnode->sucInfo.atomicStoreStatus(LockStatus::Granted);
       return MQL_RESULT::Acquired;
     } else {
-      return cancel_writer_lock(me, key);
+      return cancel_writer_lock(me);
     }
   }
 
   while (qnode->granted.load(std::memory_order_acquire) != true) {
-    printf("th %d : aq wl %d : infinite roop, pred %d\n", me, key, pred);
+    _mm_pause();
   }
   qnode->sucInfo.atomicStoreStatus(LockStatus::Granted);
   return MQL_RESULT::Acquired;
 }
 
-void MQLock::release_writer_lock(uint32_t me, unsigned int key) {
-  MQLNode *qnode = &MQLNodeTable[me][key];
+void MQLock::release_writer_lock(uint32_t me) {
+  MQLNode *qnode = &MQLNodeTable[me];
   qnode->sucInfo.atomicStoreBusy(true);
   // make sure successor can't leave
   while (qnode->sucInfo.atomicLoadNext() ==
@@ -639,7 +636,6 @@ void MQLock::release_writer_lock(uint32_t me, unsigned int key) {
     ;
 
   while (qnode->sucInfo.atomicLoadNext() == (uint32_t)SentinelValue::None) {
-    // printf("th %d : release wl %d\n", me, key);
     uint32_t expected, desired;
     expected = me;
     desired = (uint32_t)SentinelValue::None;
@@ -651,14 +647,13 @@ void MQLock::release_writer_lock(uint32_t me, unsigned int key) {
                   (uint32_t)SentinelValue::None);
       return;
     }
-    printf("th %d : rl wl %d : next %d tail %d\n", me, key,
-           qnode->sucInfo.atomicLoadNext(), tail.load());
+    _mm_pause();
   }
 
   MQLNode *suc;
   for (;;) {
     uint32_t expected(me), desired((uint32_t)SentinelValue::Acquired);
-    suc = &MQLNodeTable[qnode->sucInfo.atomicLoadNext()][key];
+    suc = &MQLNodeTable[qnode->sucInfo.atomicLoadNext()];
     if (suc->prev.compare_exchange_strong(expected, desired,
                                           std::memory_order_acq_rel,
                                           std::memory_order_acquire))
@@ -675,12 +670,11 @@ void MQLock::release_writer_lock(uint32_t me, unsigned int key) {
 }
 
 MQL_RESULT
-MQLock::cancel_writer_lock(uint32_t me, unsigned int key) {
-  NNN;
+MQLock::cancel_writer_lock(uint32_t me) {
 start_cancel:
-  MQLNode *qnode = &MQLNodeTable[me][key];
+  MQLNode *qnode = &MQLNodeTable[me];
   uint32_t pred = qnode->prev.exchange((uint32_t)SentinelValue::None);
-  MQLNode *p = &MQLNodeTable[pred][key];
+  MQLNode *p = &MQLNodeTable[pred];
   // if pred is a releasing writer and already dereference my id, it will CAS
   // me.pred.id to Acquired, so we do a final check here; there's no way back
   // after this point (unless pred is a reader and it's already gone). After my
@@ -705,7 +699,7 @@ start_cancel:
   // then put me on lock.nw
   if (qnode->prev.load(std::memory_order_acquire) ==
       (uint32_t)SentinelValue::None)
-    return cancel_writer_lock_no_pred(me, key);
+    return cancel_writer_lock_no_pred(me);
 
   for (;;) {
     // wait for cancelling pred to finish relink, note pred_block is updated
@@ -739,7 +733,7 @@ start_cancel:
       qnode->prev.store(pred, std::memory_order_release);
       pred = qnode->prev.exchange((uint32_t)SentinelValue::None);
       if (pred == (uint32_t)SentinelValue::None)
-        return cancel_writer_lock_no_pred(me, key);
+        return cancel_writer_lock_no_pred(me);
       else if (pred == (uint32_t)SentinelValue::Acquired) {
         while (qnode->granted.load(std::memory_order_acquire) != true)
           ;
@@ -768,7 +762,7 @@ start_cancel:
       p->sucInfo.atomicStoreNext((uint32_t)SentinelValue::None);
 
       // initialize
-      MQLNodeTable[qnode->sucInfo.atomicLoadNext()][key].prev.store(
+      MQLNodeTable[qnode->sucInfo.atomicLoadNext()].prev.store(
           (uint32_t)SentinelValue::None, std::memory_order_release);
       qnode->init(LockMode::None, (uint32_t)SentinelValue::None, false, false,
                   LockMode::None, LockStatus::Waiting,
@@ -790,7 +784,7 @@ retry:
   bool wakeup = false;
 
   if (p->type.load(std::memory_order_acquire) == LockMode::Reader &&
-      MQLNodeTable[qnode->sucInfo.atomicLoadNext()][key].type.load(
+      MQLNodeTable[qnode->sucInfo.atomicLoadNext()].type.load(
           std::memory_order_acquire) == LockMode::Reader &&
       p->sucInfo.atomicLoadStatus() == LockStatus::Granted) {
     // There is a time window which starts after the pred finishedits "acquired"
@@ -811,7 +805,7 @@ retry:
   // successor, we need to also set pred.next.id to NoSuccessor, which makes it
   // not safe for succ to spin on pred.next.id to wait for me finishing this
   // relink (pred might disappear any time because its next.id is NoSuccessor).
-  MQLNode *suc = &MQLNodeTable[qnode->sucInfo.atomicLoadNext()][key];
+  MQLNode *suc = &MQLNodeTable[qnode->sucInfo.atomicLoadNext()];
   if (wakeup) {
     nreaders++;
     suc->granted.store(true, std::memory_order_release);
@@ -832,7 +826,7 @@ retry:
     }
   }
 
-  MQLNodeTable[qnode->sucInfo.atomicLoadNext()][key].prev.store(
+  MQLNodeTable[qnode->sucInfo.atomicLoadNext()].prev.store(
       (uint32_t)SentinelValue::None, std::memory_order_release);
   qnode->init(LockMode::None, (uint32_t)SentinelValue::None, false, false,
               LockMode::None, LockStatus::Waiting,
@@ -841,9 +835,8 @@ retry:
 }
 
 MQL_RESULT
-MQLock::cancel_writer_lock_no_pred(uint32_t me, unsigned int key) {
-  NNN;
-  MQLNode *qnode = &MQLNodeTable[me][key];
+MQLock::cancel_writer_lock_no_pred(uint32_t me) {
+  MQLNode *qnode = &MQLNodeTable[me];
   while (!(next_writer != (uint32_t)SentinelValue::None ||
            qnode->granted.load(std::memory_order_acquire) == true))
     ;
@@ -865,7 +858,7 @@ MQLock::cancel_writer_lock_no_pred(uint32_t me, unsigned int key) {
       tail.compare_exchange_strong(localme, (uint32_t)SentinelValue::None,
                                    std::memory_order_acq_rel,
                                    std::memory_order_acquire)) {
-    MQLNodeTable[qnode->sucInfo.atomicLoadNext()][key].prev.store(
+    MQLNodeTable[qnode->sucInfo.atomicLoadNext()].prev.store(
         (uint32_t)SentinelValue::None, std::memory_order_release);
     qnode->init(LockMode::None, (uint32_t)SentinelValue::None, false, false,
                 LockMode::None, LockStatus::Waiting,
@@ -880,7 +873,7 @@ MQLock::cancel_writer_lock_no_pred(uint32_t me, unsigned int key) {
   //
   // because I don't have a pred, if next_id is a writer, I should put it in
   // lock.nw
-  MQLNode *suc = &MQLNodeTable[localnext][key];
+  MQLNode *suc = &MQLNodeTable[localnext];
   if (suc->type.load(std::memory_order_acquire) == LockMode::Writer) {
     // remaining readers will use CAS on lock.nw, so we blind write
     next_writer.store(localnext, std::memory_order_release);
@@ -903,7 +896,7 @@ MQLock::cancel_writer_lock_no_pred(uint32_t me, unsigned int key) {
         if (suc->prev.compare_exchange_strong(
                 forSentiNone, (uint32_t)SentinelValue::Acquired,
                 std::memory_order_acq_rel, std::memory_order_acquire))
-          ;
+          break;
       }
       suc->granted.store(true, std::memory_order_release);
     }
@@ -920,7 +913,7 @@ MQLock::cancel_writer_lock_no_pred(uint32_t me, unsigned int key) {
     suc->granted.store(true, std::memory_order_release);
   }
 
-  MQLNodeTable[qnode->sucInfo.atomicLoadNext()][key].prev.store(
+  MQLNodeTable[qnode->sucInfo.atomicLoadNext()].prev.store(
       (uint32_t)SentinelValue::None, std::memory_order_release);
   qnode->init(LockMode::None, (uint32_t)SentinelValue::None, false, false,
               LockMode::None, LockStatus::Waiting,
@@ -14,9 +14,12 @@
 #include "../include/backoff.hh"
 #include "../include/cpu.hh"
 #include "../include/debug.hh"
+#include "../include/driver.hh"
 #include "../include/int64byte.hh"
 #include "../include/masstree_wrapper.hh"
 #include "../include/result.hh"
+#include "../include/result_export.hh"
+#include "../include/sampler.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
 #include "../include/zipf.hh"
@@ -28,107 +31,102 @@
 
 using namespace std;
 
-void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
-  Xoroshiro128Plus rnd;
-  rnd.init();
-  TxExecutor trans(thid, &rnd, (Result *) &MoccResult[thid]);
-  FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
-  uint64_t epoch_timer_start, epoch_timer_stop;
-  Backoff backoff(FLAGS_clocks_per_us);
-  Result &myres = std::ref(MoccResult[thid]);
+/**
+ * @brief MOCC engine for the driver.
+ */
+class MoccEngine : public Engine<MoccEngine> {
+public:
+  MoccEngine(size_t thid, Result &myres)
+          : trans_(thid, &rnd_, &myres), myres_(myres),
+            backoff_(FLAGS_clocks_per_us) {
+    rnd_.init();
+    epoch_timer_start_ = rdtscp();
+  }
 
-#if MASSTREE_USE
-  MasstreeWrapper<Tuple>::thread_init(int(thid));
-#endif
+  std::vector<Procedure> &procedures() { return trans_.pro_set_; }
 
-#ifdef Linux
-  setThreadAffinity(thid);
-#endif  // Linux
+  INLINE void leaderWork() {
+    ::leaderWork(epoch_timer_start_, epoch_timer_stop_, myres_);
+    leaderBackoffWork(backoff_, MoccResult);
+  }
 
-  storeRelease(ready, 1);
-  while (!loadAcquire(start)) _mm_pause();
-  if (thid == 0) epoch_timer_start = rdtscp();
-  while (!loadAcquire(quit)) {
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
-                  FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false, thid, myres);
-RETRY:
-    if (thid == 0) {
-      leaderWork(epoch_timer_start, epoch_timer_stop, myres);
-      leaderBackoffWork(backoff, MoccResult);
-    }
-    if (loadAcquire(quit)) break;
-
-    trans.begin();
-    for (auto itr = trans.pro_set_.begin(); itr != trans.pro_set_.end();
-         ++itr) {
-      if ((*itr).ope_ == Ope::READ) {
-        trans.read((*itr).key_);
-      } else if ((*itr).ope_ == Ope::WRITE) {
-        trans.write((*itr).key_);
-      } else if ((*itr).ope_ == Ope::READ_MODIFY_WRITE) {
-        // trans.read((*itr).key_);
-        // trans.write((*itr).key_);
-        trans.read_write((*itr).key_);
-      } else {
-        ERR;
-      }
-
-      if (trans.status_ == TransactionStatus::aborted) {
-        trans.abort();
+  INLINE void begin() { trans_.begin(); }
+
+  INLINE void read(uint64_t key) { trans_.read(key); }
+
+  INLINE void write(uint64_t key) { trans_.write(key); }
+
+  INLINE void readWrite(uint64_t key) { trans_.read_write(key); }
+
+  INLINE bool aborted() const {
+    return trans_.status_ == TransactionStatus::aborted;
+  }
+
+  INLINE void earlyAbort() {
+    trans_.abort();
 #if ADD_ANALYSIS
-        ++myres.local_abort_by_operation_;
+    ++myres_.local_abort_by_operation_;
 #endif
-        goto RETRY;
-      }
-    }
+  }
 
-    if (!(trans.commit())) {
-      trans.abort();
+  INLINE bool commit() {
+    if (!trans_.commit()) return false;
+    trans_.writePhase();
+    return true;
+  }
+
+  INLINE void abort() {
+    trans_.abort();
 #if ADD_ANALYSIS
-      ++myres.local_abort_by_validation_;
+    ++myres_.local_abort_by_validation_;
 #endif
-      goto RETRY;
-    }
-
-    trans.writePhase();
-    /**
-     * local_commit_counts is used at ../include/backoff.hh to calcurate about
-     * backoff.
-     */
-    storeRelease(myres.local_commit_counts_,
-                 loadAcquire(myres.local_commit_counts_) + 1);
   }
 
-  return;
+private:
+  Xoroshiro128Plus rnd_;
+  TxExecutor trans_;
+  Result &myres_;
+  uint64_t epoch_timer_start_, epoch_timer_stop_;
+  Backoff backoff_;
+};
+
+void worker(size_t thid, Driver &driver) {
+  MoccEngine engine(thid, MoccResult[thid]);
+
+#if MASSTREE_USE
+  MasstreeWrapper<Tuple>::thread_init(int(thid));
+#endif
+
+#ifdef Linux
+  setThreadAffinity(thid);
+#endif  // Linux
+
+  driver.work(engine, thid);
 }
 
 int main(int argc, char *argv[]) try {
   gflags::SetUsageMessage("MOCC benchmark.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  setYcsbZipfSkew(
+          YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len),
+          FLAGS_zipf_skew);
+  ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
   chkArg();
   makeDB();
 
-  alignas(CACHE_LINE_SIZE) bool start = false;
-  alignas(CACHE_LINE_SIZE) bool quit = false;
   initResult();
-  std::vector<char> readys(FLAGS_thread_num);
-  std::vector<std::thread> thv;
-  for (size_t i = 0; i < FLAGS_thread_num; ++i)
-    thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                     std::ref(quit));
-  waitForReady(readys);
-  storeRelease(start, true);
-  for (size_t i = 0; i < FLAGS_extime; ++i) {
-    sleepMs(1000);
-  }
-  storeRelease(quit, true);
-  for (auto &th : thv) th.join();
-
-  for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-    MoccResult[0].addLocalAllResult(MoccResult[i]);
-  }
-  MoccResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime, FLAGS_thread_num);
-
+  Driver driver({FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
+                 FLAGS_rratio, FLAGS_rmw, false, FLAGS_ycsb, FLAGS_zipf_skew,
+                 FLAGS_arrival_rate, FLAGS_arrival_poisson,
+                 FLAGS_clocks_per_us, FLAGS_trace_record, FLAGS_trace_replay,
+                 YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist,
+                         FLAGS_scan_len)},
+                MoccResult);
+  driver.run(worker, FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
+
+  driver.display(FLAGS_extime);
+
+  result_export.write();
   return 0;
 } catch (bad_alloc) {
   ERR;
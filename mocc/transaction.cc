@@ -54,10 +54,8 @@ WriteElement<Tuple> *TxExecutor::searchWriteSet(uint64_t key) {
  */
 template<typename T>
 T *TxExecutor::searchRLL(uint64_t key) {
-  // will do : binary search
-  for (auto itr = RLL_.begin(); itr != RLL_.end(); ++itr) {
-    if ((*itr).key_ == key) return &(*itr);
-  }
+  auto itr = lowerBound(RLL_, key);
+  if (itr != RLL_.end() && (*itr).key_ == key) return &(*itr);
 
   return nullptr;
 }
@@ -70,15 +68,37 @@ T *TxExecutor::searchRLL(uint64_t key) {
  * @return void
  */
 void TxExecutor::removeFromCLL(uint64_t key) {
-  int ctr = 0;
-  for (auto itr = CLL_.begin(); itr != CLL_.end(); ++itr) {
-    if ((*itr).key_ == key)
-      break;
-    else
-      ctr++;
-  }
+  auto itr = lowerBound(CLL_, key);
+  if (itr != CLL_.end() && (*itr).key_ == key) CLL_.erase(itr);
+}
 
-  CLL_.erase(CLL_.begin() + ctr);
+/**
+ * @brief Whether the record is hot enough to be locked.
+ * @details The temperature of its page in EpotempAry filters cold records by
+ * one load. If the page is hot and TempSketch is enabled, the temperature of
+ * the record itself decides, so cold records in a hot page stay optimistic.
+ * @param [in] key The key of key-value.
+ */
+bool TxExecutor::isHot(uint64_t key) {
+  Epotemp loadepot;
+  loadepot.obj_ =
+          loadAcquire(EpotempAry[key * sizeof(Tuple) / FLAGS_per_xx_temp].obj_);
+  if (loadepot.temp < TEMP_THRESHOLD) return false;
+  if (!TempSketch.enabled()) return true;
+  return TempSketch.temp(key, loadAcquireGE().obj_) >= TEMP_THRESHOLD;
+}
+
+/**
+ * @brief Count a lock taken by temperature and whether it is a false
+ * positive, which is a lock on a record not genuinely hot.
+ * @param [in] key The key of key-value.
+ */
+void TxExecutor::lockedByTemperature([[maybe_unused]] uint64_t key) {
+#if ADD_ANALYSIS
+  ++mres_->local_temperature_locks_;
+  if (!RecordHeatAry.hot(key, loadAcquireGE().obj_))
+    ++mres_->local_temperature_false_locks_;
+#endif
 }
 
 /**
@@ -108,7 +128,6 @@ void TxExecutor::read(uint64_t key) {
   // Default constructor of these variable cause error (-fpermissive)
   // "crosses initialization of ..."
   // So it locate before first goto instruction.
-  Epotemp loadepot;
   Tidword expected, desired;
 
   /**
@@ -140,12 +159,6 @@ void TxExecutor::read(uint64_t key) {
   inRLL = searchRLL<LockElement<MQLock>>(key);
 #endif  // MQLOCK
 
-  /**
-   * Check corresponding temperature.
-   */
-  size_t epotemp_index;
-  epotemp_index = key * sizeof(Tuple) / FLAGS_per_xx_temp;
-  loadepot.obj_ = loadAcquire(EpotempAry[epotemp_index].obj_);
   bool needVerification;
   needVerification = true;
 
@@ -165,12 +178,12 @@ void TxExecutor::read(uint64_t key) {
        * Because it could acquire lock.
        */
     }
-  } else if (loadepot.temp >= TEMP_THRESHOLD) {
+  } else if (isHot(key)) {
     /**
      * This transaction is not after abort, 
      * however, it accesses high temperature record.
      */
-    // printf("key:\t%lu, temp:\t%lu\n", key, loadepot.temp_);
+    lockedByTemperature(key);
     lock(key, tuple, false);
     if (this->status_ == TransactionStatus::aborted) {
       /**
@@ -194,6 +207,9 @@ void TxExecutor::read(uint64_t key) {
 #ifdef RWLOCK
       while (tuple->rwlock_.ldAcqCounter() == W_LOCKED) {
 #endif  // RWLOCK
+#ifdef MQLOCK
+      while (tuple->mqlock_.writer_locked()) {
+#endif  // MQLOCK
       /* if you wait due to being write-locked, it may occur dead lock.
       // it need to guarantee that this parts definitely progress.
       // So it sholud wait expected.lock because it will be released
@@ -203,7 +219,7 @@ void TxExecutor::read(uint64_t key) {
       expected.obj_ = __atomic_load_n(&(tuple->tidword_.obj_),
       __ATOMIC_ACQUIRE);*/
 
-      if (key < CLL_.back().key_) {
+      if (!CLL_.empty() && key < CLL_.back().key_) {
         status_ = TransactionStatus::aborted;
         read_set_.emplace_back(key, tuple);
         goto FINISH_READ;
@@ -238,7 +254,7 @@ emplace_back(expected, key, tuple, return_val_
 
 FINISH_READ:
 #if ADD_ANALYSIS
-mres_->local_read_latency_ += rdtscp() - start;
+mres_->recordReadLatency(rdtscp() - start);
 #endif
 return;
 }
@@ -252,11 +268,6 @@ void TxExecutor::write(uint64_t key) {
   uint64_t start = rdtscp();
 #endif
 
-  // these variable cause error (-fpermissive)
-  // "crosses initialization of ..."
-  // So it locate before first goto instruction.
-  Epotemp loadepot;
-
   // tuple exists in write set.
   if (searchWriteSet(key)) goto FINISH_WRITE;
 
@@ -282,17 +293,13 @@ void TxExecutor::write(uint64_t key) {
 #endif
   }
 
-  /**
-   * Check corresponding temperature.
-   */
-  size_t epotemp_index;
-  epotemp_index = key * sizeof(Tuple) / FLAGS_per_xx_temp;
-  loadepot.obj_ = loadAcquire(EpotempAry[epotemp_index].obj_);
-
   /**
    * If this record has high temperature, use lock.
    */
-  if (loadepot.temp >= TEMP_THRESHOLD) lock(key, tuple, true);
+  if (isHot(key)) {
+    lockedByTemperature(key);
+    lock(key, tuple, true);
+  }
   /**
    * If it failed locking, it aborts.
    */
@@ -303,7 +310,8 @@ void TxExecutor::write(uint64_t key) {
   inRLL = searchRLL<LockElement<RWLock>>(key);
 #endif  // RWLOCK
 #ifdef MQLOCK
-  LockElement<MQLock> *inRLL = searchRLL<LockElement<MQLock>>(key);
+  LockElement<MQLock> *inRLL;
+  inRLL = searchRLL<LockElement<MQLock>>(key);
 #endif  // MQLOCK
   if (inRLL != nullptr) lock(key, tuple, true);
   if (this->status_ == TransactionStatus::aborted) goto FINISH_WRITE;
@@ -313,7 +321,7 @@ void TxExecutor::write(uint64_t key) {
 
 FINISH_WRITE:
 #if ADD_ANALYSIS
-  mres_->local_write_latency_ += rdtscp() - start;
+  mres_->recordWriteLatency(rdtscp() - start);
 #endif
   return;
 }
@@ -322,7 +330,6 @@ void TxExecutor::read_write(uint64_t key) {
   // Default constructor of these variable cause error (-fpermissive)
   // "crosses initialization of ..."
   // So it locate before first goto instruction.
-  Epotemp loadepot;
   Tidword expected, desired;
 
   Tuple *tuple;
@@ -356,12 +363,6 @@ void TxExecutor::read_write(uint64_t key) {
   inRLL = searchRLL<LockElement<MQLock>>(key);
 #endif  // MQLOCK
 
-  /**
-   * Check corresponding temperature.
-   */
-  size_t epotemp_index;
-  epotemp_index = key * sizeof(Tuple) / FLAGS_per_xx_temp;
-  loadepot.obj_ = loadAcquire(EpotempAry[epotemp_index].obj_);
   bool needVerification;
   needVerification = true;
 
@@ -372,9 +373,9 @@ void TxExecutor::read_write(uint64_t key) {
     } else {
       needVerification = false;
     }
-  } else if (loadepot.temp >= TEMP_THRESHOLD) {
-    // printf("key:\t%lu, temp:\t%lu\n", key, loadepot.temp_);
+  } else if (isHot(key)) {
     // this lock for write, so write-mode.
+    lockedByTemperature(key);
     lock(key, tuple, true);
     if (this->status_ == TransactionStatus::aborted) {
       goto FINISH_ALL;
@@ -389,6 +390,9 @@ void TxExecutor::read_write(uint64_t key) {
 #ifdef RWLOCK
       while (tuple->rwlock_.ldAcqCounter() == W_LOCKED) {
 #endif  // RWLOCK
+#ifdef MQLOCK
+      while (tuple->mqlock_.writer_locked()) {
+#endif  // MQLOCK
       /* if you wait due to being write-locked, it may occur dead lock.
       // it need to guarantee that this parts definitely progress.
       // So it sholud wait expected.lock because it will be released
@@ -398,7 +402,7 @@ void TxExecutor::read_write(uint64_t key) {
       expected.obj_ = __atomic_load_n(&(tuple->tidword_.obj_),
       __ATOMIC_ACQUIRE);*/
 
-      if (key < CLL_.back().key_) {
+      if (!CLL_.empty() && key < CLL_.back().key_) {
         status_ = TransactionStatus::aborted;
         read_set_.emplace_back(key, tuple);
         goto FINISH_READ;
@@ -443,43 +447,34 @@ return;
 
 void TxExecutor::lock(uint64_t key, Tuple *tuple, bool mode) {
   unsigned int vioctr = 0;
-  unsigned int threshold;
   bool upgrade = false;
 
 #ifdef RWLOCK
   LockElement<RWLock> *le = nullptr;
 #endif  // RWLOCK
+#ifdef MQLOCK
+  LockElement<MQLock> *le = nullptr;
+#endif  // MQLOCK
   // RWLOCK : アップグレードするとき，CLL_ ループで該当する
   // エレメントを記憶しておき，そのエレメントを更新するため．
-  // MQLOCK : アップグレード機能が無いので，不要．
+  // MQLOCK : アップグレード機能が無いので，
   // reader ロックを解放して，CLL_ から除去して，writer ロックをかける．
 
-  // lock exists in CLL_ (current lock list)
-  sort(CLL_.begin(), CLL_.end());
-  for (auto itr = CLL_.begin(); itr != CLL_.end(); ++itr) {
+  // CLL_ (current lock list) is sorted by key, so the violations, the locks
+  // whose keys are not less than key, are the tail from the lower bound.
+  auto vio = lowerBound(CLL_, key);
+  if (vio != CLL_.end() && (*vio).key_ == key) {
     // lock already exists in CLL_
     //    && its lock mode is equal to needed mode or it is stronger than needed
     //    mode.
-    if ((*itr).key_ == key) {
-      if (mode == (*itr).mode_ || mode < (*itr).mode_)
-        return;
-      else {
-#ifdef RWLOCK
-        le = &(*itr);
-#endif  // RWLOCK
-        upgrade = true;
-      }
-    }
-
-    // collect violation
-    if ((*itr).key_ >= key) {
-      if (vioctr == 0) threshold = (*itr).key_;
-
-      vioctr++;
+    if (mode == (*vio).mode_ || mode < (*vio).mode_)
+      return;
+    else {
+      le = &(*vio);
+      upgrade = true;
     }
   }
-
-  if (vioctr == 0) threshold = -1;
+  vioctr = CLL_.end() - vio;
 
   // if too many violations
   // i set my condition of too many because the original paper of mocc didn't
@@ -498,7 +493,7 @@ void TxExecutor::lock(uint64_t key, Tuple *tuple, bool mode) {
           return;
         }
       } else if (tuple->rwlock_.w_trylock()) {
-        CLL_.push_back(LockElement<RWLock>(key, &(tuple->rwlock_), true));
+        CLL_.emplace(vio, key, &(tuple->rwlock_), true);
         return;
       } else {
         this->status_ = TransactionStatus::aborted;
@@ -506,7 +501,7 @@ void TxExecutor::lock(uint64_t key, Tuple *tuple, bool mode) {
       }
     } else {
       if (tuple->rwlock_.r_trylock()) {
-        CLL_.push_back(LockElement<RWLock>(key, &(tuple->rwlock_), false));
+        CLL_.emplace(vio, key, &(tuple->rwlock_), false);
         return;
       } else {
         this->status_ = TransactionStatus::aborted;
@@ -515,43 +510,19 @@ void TxExecutor::lock(uint64_t key, Tuple *tuple, bool mode) {
     }
 #endif  // RWLOCK
 #ifdef MQLOCK
-    if (mode) {
-      if (upgrade) {
-        tuple->mqlock.release_reader_lock(this->locknum, key);
-        removeFromCLL(key);
-        if (tuple->mqlock.acquire_writer_lock(this->locknum, key, true) ==
-            MQL_RESULT::Acquired) {
-          CLL_.push_back(LockElement<MQLock>(key, &(tuple->mqlock), true));
-          return;
-        } else {
-          this->status = TransactionStatus::aborted;
-          return;
-        }
-      } else if (tuple->mqlock.acquire_writer_lock(this->locknum, key, true) ==
-                 MQL_RESULT::Acquired) {
-        CLL_.push_back(LockElement<MQLock>(key, &(tuple->mqlock), true));
-        return;
-      } else {
-        this->status = TransactionStatus::aborted;
-        return;
-      }
-    } else {
-      if (tuple->mqlock.acquire_reader_lock(this->locknum, key, true) ==
-          MQL_RESULT::Acquired) {
-        CLL_.push_back(LockElement<MQLock>(key, &(tuple->mqlock), false));
-        return;
-      } else {
-        this->status = TransactionStatus::aborted;
-        return;
-      }
+    if (upgrade) {
+      mqlRelease(*le);
+      removeFromCLL(key);
     }
+    if (!mqlAcquire(key, &(tuple->mqlock_), mode, true))
+      this->status_ = TransactionStatus::aborted;
+    return;
 #endif  // MQLOCK
   }
 
   if (vioctr != 0) {
     // not in canonical mode. restore.
-    for (auto itr = CLL_.begin() + (CLL_.size() - vioctr); itr != CLL_.end();
-         ++itr) {
+    for (auto itr = vio; itr != CLL_.end(); ++itr) {
 #ifdef RWLOCK
       if ((*itr).mode_)
         (*itr).lock_->w_unlock();
@@ -560,41 +531,31 @@ void TxExecutor::lock(uint64_t key, Tuple *tuple, bool mode) {
 #endif  // RWLOCK
 
 #ifdef MQLOCK
-      if ((*itr).mode_)
-        (*itr).lock_->release_writer_lock(this->locknum, key);
-      else
-        (*itr).lock_->release_reader_lock(this->locknum, key);
+      mqlRelease(*itr);
 #endif  // MQLOCK
     }
 
     // delete from CLL_
-    if (CLL_.size() == vioctr)
-      CLL_.clear();
-    else
-      CLL_.erase(CLL_.begin() + (CLL_.size() - vioctr), CLL_.end());
+    CLL_.erase(vio, CLL_.end());
   }
 
   // unconditional lock in canonical mode.
-  for (auto itr = RLL_.begin(); itr != RLL_.end(); ++itr) {
-    if ((*itr).key_ <= threshold) continue;
-    if ((*itr).key_ < key) {
+  // it takes the locks of RLL_ between the last lock of CLL_ and key, so CLL_
+  // stays sorted.
+  auto itr = CLL_.empty() ? RLL_.begin()
+                          : lowerBound(RLL_, (uint64_t) CLL_.back().key_ + 1);
+  for (; itr != RLL_.end() && (*itr).key_ < key; ++itr) {
 #ifdef RWLOCK
-      if ((*itr).mode_)
-        (*itr).lock_->w_lock();
-      else
-        (*itr).lock_->r_lock();
+    if ((*itr).mode_)
+      (*itr).lock_->w_lock();
+    else
+      (*itr).lock_->r_lock();
+    CLL_.emplace_back((*itr).key_, (*itr).lock_, (*itr).mode_);
 #endif  // RWLOCK
 
 #ifdef MQLOCK
-      if ((*itr).mode_)
-        (*itr).lock_->acquire_writer_lock(this->locknum, key);
-      else
-        (*itr).lock_->acquire_reader_lock(this->locknum, key);
+    mqlAcquire((*itr).key_, (*itr).lock_, (*itr).mode_, false);
 #endif  // MQLOCK
-
-      CLL_.emplace_back((*itr).key_, (*itr).lock_, (*itr).mode_);
-    } else
-      break;
   }
 
 #ifdef RWLOCK
@@ -607,15 +568,43 @@ void TxExecutor::lock(uint64_t key, Tuple *tuple, bool mode) {
 #endif  // RWLOCK
 
 #ifdef MQLOCK
-  if (mode)
-    tuple->mqlock.acquire_writer_lock(this->locknum, key, false);
-  else
-    tuple->mqlock.acquire_reader_lock(this->locknum, key, false);
-  CLL_.push_back(LockElement<MQLock>(key, tuple->mqlock, mode));
+  mqlAcquire(key, &(tuple->mqlock_), mode, false);
   return;
 #endif  // MQLOCK
 }
 
+#ifdef MQLOCK
+/**
+ * @brief Acquire MQL lock with a qnode from the pool.
+ * @return whether it is acquired. If so, it is inserted to CLL_ in key order.
+ */
+bool TxExecutor::mqlAcquire(uint64_t key, MQLock *lock, bool mode,
+                            bool trylock) {
+  uint32_t qnode = qnodes_.get();
+  MQL_RESULT result = mode ? lock->acquire_writer_lock(qnode, trylock)
+                           : lock->acquire_reader_lock(qnode, trylock);
+  if (result == MQL_RESULT::Acquired) {
+    CLL_.emplace(lowerBound(CLL_, key), key, lock, mode, qnode);
+    return true;
+  }
+  // the cancelled qnode is out of the queue.
+  qnodes_.put(qnode);
+  return false;
+}
+
+/**
+ * @brief Release MQL lock and return its qnode to the pool.
+ * @post The element is still in CLL_.
+ */
+void TxExecutor::mqlRelease(LockElement<MQLock> &le) {
+  if (le.mode_)
+    le.lock_->release_writer_lock(le.qnode_);
+  else
+    le.lock_->release_reader_lock(le.qnode_);
+  qnodes_.put(le.qnode_);
+}
+#endif  // MQLOCK
+
 void TxExecutor::construct_RLL() {
   RLL_.clear();
 
@@ -624,10 +613,11 @@ void TxExecutor::construct_RLL() {
     RLL_.emplace_back((*itr).key_, &((*itr).rcdptr_->rwlock_), true);
 #endif  // RWLOCK
 #ifdef MQLOCK
-    RLL_.push_back(
-        LockElement<MQLock>((*itr).key_, &(Table[(*itr).key_].mqlock), true));
+    RLL_.emplace_back((*itr).key_, &((*itr).rcdptr_->mqlock_), true);
 #endif  // MQLOCK
   }
+  // RLL_ is sorted by key, and the read locks are inserted in order.
+  sort(RLL_.begin(), RLL_.end());
 
   for (auto itr = read_set_.begin(); itr != read_set_.end(); ++itr) {
     // maintain temprature p
@@ -669,34 +659,32 @@ void TxExecutor::construct_RLL() {
                             desired.obj_))
           break;
       }
+
+      // the temperature of the record itself.
+      if (TempSketch.enabled())
+        TempSketch.heat((*itr).key_, loadAcquireGE().obj_, *rnd_);
+#if ADD_ANALYSIS
+      RecordHeatAry.heat((*itr).key_, loadAcquireGE().obj_);
+#endif
     }
 
     // check whether itr exists in RLL_
-#ifdef RWLOCK
-    if (searchRLL<LockElement<RWLock>>((*itr).key_) != nullptr) continue;
-#endif  // RWLOCK
-#ifdef MQLOCK
-    if (searchRLL<LockElement<MQLock>>((*itr).key_) != nullptr) continue;
-#endif  // MQLOCK
+    auto pos = lowerBound(RLL_, (*itr).key_);
+    if (pos != RLL_.end() && (*pos).key_ == (*itr).key_) continue;
 
     // r not in RLL_
     // if temprature >= threshold
     //  || r failed verification
-    Epotemp loadepot;
-    loadepot.obj_ = loadAcquire(EpotempAry[epotemp_index].obj_);
-    if (loadepot.temp >= TEMP_THRESHOLD || (*itr).failed_verification_) {
+    if ((*itr).failed_verification_ || isHot((*itr).key_)) {
 #ifdef RWLOCK
-      RLL_.emplace_back((*itr).key_, &((*itr).rcdptr_->rwlock_), false);
+      RLL_.emplace(pos, (*itr).key_, &((*itr).rcdptr_->rwlock_), false);
 #endif  // RWLOCK
 #ifdef MQLOCK
-      RLL_.push_back(
-          LockElement<MQLock>((*itr).key_, &((*itr).rcdptr_->mqlock_), false));
+      RLL_.emplace(pos, (*itr).key_, &((*itr).rcdptr_->mqlock_), false);
 #endif  // MQLOCK
     }
   }
 
-  sort(RLL_.begin(), RLL_.end());
-
   return;
 }
 
@@ -738,6 +726,10 @@ bool TxExecutor::commit() {
     if ((*itr).rcdptr_->rwlock_.ldAcqCounter() == W_LOCKED &&
         searchWriteSet((*itr).key_) == nullptr) {
 #endif  // RWLOCK
+#ifdef MQLOCK
+    if ((*itr).rcdptr_->mqlock_.writer_locked() &&
+        searchWriteSet((*itr).key_) == nullptr) {
+#endif  // MQLOCK
     // if the rwlock is already acquired and the owner isn't me, abort.
     (*itr).failed_verification_ = true;
     this->status_ = TransactionStatus::aborted;
@@ -768,8 +760,6 @@ void TxExecutor::abort() {
   read_set_.clear();
   write_set_.clear();
 
-  ++mres_->local_abort_counts_;
-
 #if BACK_OFF
 #if ADD_ANALYSIS
   uint64_t start(rdtscp());
@@ -797,11 +787,8 @@ void TxExecutor::unlockCLL() {
 #endif  // RWLOCK
 
 #ifdef MQLOCK
-    if ((*itr).mode_) {
-      (*itr).lock_->release_writer_lock(this->locknum, (*itr).key_);
-    } else
-      (*itr).lock_->release_reader_lock(this->locknum, (*itr).key_);
-#endif
+    mqlRelease(*itr);
+#endif  // MQLOCK
   }
   CLL_.clear();
 }
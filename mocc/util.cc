@@ -63,11 +63,9 @@ void chkArg() {
                      FLAGS_thread_num * sizeof(uint64_t_64byte)) != 0)
     ERR;
 #ifdef MQLOCK
-  // if (posix_memalign((void**)&MQLNodeList, 64, (FLAGS_thread_num + 3) *
-  // sizeof(MQLNode)) != 0) ERR;
-  MQLNodeTable = new MQLNode *[FLAGS_thread_num + 3];
-  for (unsigned int i = 0; i < FLAGS_thread_num + 3; ++i)
-    MQLNodeTable[i] = new MQLNode[FLAGS_tuple_num];
+  MQLNodeTable = new MQLNode[MQLNodePool::kIdBase +
+                             FLAGS_thread_num *
+                             MQLNodePool::slotNum(FLAGS_max_ope)];
 #endif  // MQLOCK
 
   for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
@@ -83,7 +81,9 @@ void displayDB() {
     cout << "----------" << endl;  // - is 10
     cout << "key: " << i << endl;
     cout << "val: " << tuple->val_ << endl;
+#ifdef RWLOCK
     cout << "lockctr: " << tuple->rwlock_.counter_ << endl;
+#endif  // RWLOCK
     cout << "TIDword: " << tuple->tidword_.obj_ << endl;
     cout << "bit: " << static_cast<bitset<64>>(tuple->tidword_.obj_) << endl;
     cout << endl;
@@ -95,6 +95,9 @@ void displayLockedTuple() {
 #ifdef RWLOCK
     if (Table[i].rwlock_.counter_.load(memory_order_relaxed) == -1) {
 #endif  // RWLOCK
+#ifdef MQLOCK
+    if (Table[i].mqlock_.writer_locked()) {
+#endif  // MQLOCK
     cout << "key : " << i << " is locked!." << endl;
   }
 }
@@ -102,16 +105,28 @@ void displayLockedTuple() {
 }
 
 void displayParameter() {
+  cout << "#FLAGS_arrival_poisson:\t" << FLAGS_arrival_poisson << endl;
+  cout << "#FLAGS_arrival_rate:\t" << FLAGS_arrival_rate << endl;
   cout << "#FLAGS_clocks_per_us:\t" << FLAGS_clocks_per_us << endl;
   cout << "#FLAGS_epoch_time:\t" << FLAGS_epoch_time << endl;
   cout << "#FLAGS_extime:\t\t" << FLAGS_extime << endl;
   cout << "#FLAGS_max_ope:\t\t" << FLAGS_max_ope << endl;
   cout << "#FLAGS_per_xx_temp\t" << FLAGS_per_xx_temp << endl;
+  cout << "#FLAGS_request_dist:\t" << FLAGS_request_dist << endl;
+  cout << "#FLAGS_result_file:\t" << FLAGS_result_file << endl;
+  cout << "#FLAGS_result_format:\t" << FLAGS_result_format << endl;
   cout << "#FLAGS_rmw:\t\t" << FLAGS_rmw << endl;
   cout << "#FLAGS_rratio:\t\t" << FLAGS_rratio << endl;
+  cout << "#FLAGS_sample_interval:\t" << FLAGS_sample_interval << endl;
+  cout << "#FLAGS_scan_len:\t" << FLAGS_scan_len << endl;
+  cout << "#FLAGS_temp_sketch_width:\t" << FLAGS_temp_sketch_width << endl;
   cout << "#FLAGS_thread_num:\t" << FLAGS_thread_num << endl;
+  cout << "#FLAGS_trace_record:\t" << FLAGS_trace_record << endl;
+  cout << "#FLAGS_trace_replay:\t" << FLAGS_trace_replay << endl;
   cout << "#FLAGS_tuple_num:\t" << FLAGS_tuple_num << endl;
+  cout << "#FLAGS_warmup:\t\t" << FLAGS_warmup << endl;
   cout << "#FLAGS_ycsb:\t\t" << FLAGS_ycsb << endl;
+  cout << "#FLAGS_ycsb_workload:\t" << FLAGS_ycsb_workload << endl;
   cout << "#FLAGS_zipf_skew:\t" << FLAGS_zipf_skew << endl;
 }
 
@@ -139,6 +154,9 @@ void partTableInit([[maybe_unused]] size_t thid, uint64_t start, uint64_t end) {
 }
 
 void makeDB() {
+#if MASSTREE_USE
+  MT.reserve(FLAGS_tuple_num);
+#endif
   if (posix_memalign((void **) &Table, PAGE_SIZE, FLAGS_tuple_num * sizeof(Tuple)) !=
       0)
     ERR;
@@ -152,6 +170,10 @@ void makeDB() {
   if (posix_memalign((void **) &EpotempAry, PAGE_SIZE,
                      epotemp_length * sizeof(Epotemp)) != 0)
     ERR;
+  TempSketch.init(FLAGS_temp_sketch_width);
+#if ADD_ANALYSIS
+  RecordHeatAry.init(FLAGS_tuple_num);
+#endif
 
   size_t maxthread = decideParallelBuildNumber(FLAGS_tuple_num);
   std::vector<std::thread> thv;
@@ -202,6 +224,7 @@ void leaderWork(uint64_t &epoch_timer_start, uint64_t &epoch_timer_stop,
 void ShowOptParameters() {
   cout << "#ShowOptParameters() "
        << ": ADD_ANALYSIS " << ADD_ANALYSIS << ": BACK_OFF " << BACK_OFF
+       << ": HASH_INDEX_USE " << HASH_INDEX_USE
        << ": MASSTREE_USE " << MASSTREE_USE << ": KEY_SIZE " << KEY_SIZE
        << ": KEY_SORT " << KEY_SORT << ": TEMPERATURE_RESET_OPT "
        << TEMPERATURE_RESET_OPT << ": VAL_SIZE " << VAL_SIZE << endl;
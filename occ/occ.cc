@@ -23,11 +23,14 @@
 #include "../include/backoff.hh"
 #include "../include/cpu.hh"
 #include "../include/debug.hh"
+#include "../include/driver.hh"
 #include "../include/fileio.hh"
 #include "../include/masstree_wrapper.hh"
 #include "../include/random.hh"
 #include "../include/result.hh"
+#include "../include/result_export.hh"
 #include "../include/rwlock.hh"
+#include "../include/sampler.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
 #include "../include/zipf.hh"
@@ -37,16 +40,20 @@ using namespace std;
 RWLock global_lock;
 extern vector<int> progress;
 
-void worker(size_t thid, char& ready, const bool& start, const bool& quit) {
-  Result& myres = std::ref(OccResult[thid]);
-  Xoroshiro128Plus rnd;
-  rnd.init();
-  TxnExecutor trans(thid, (Result*)&myres);
-  FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
+/**
+ * @brief OCC engine for the driver.
+ * @details The validation and write phase are serialized by global_lock.
+ * commit() keeps holding it when the validation fails, and abort() releases
+ * it.
+ */
+class OccEngine : public Engine<OccEngine> {
+public:
+  OccEngine(size_t thid, Result& myres)
+          : trans_(thid, &myres)
 #if BACK_OFF
-  Backoff backoff(FLAGS_clocks_per_us);
+          , backoff_(FLAGS_clocks_per_us)
 #endif
-
+  {
 #if WAL
 /**
  * Edit it appropriately when you enable log persistence.
@@ -62,115 +69,99 @@ void worker(size_t thid, char& ready, const bool& start, const bool& quit) {
   }
   std::string logpath("/tmp/ccbench");
   */
-  std::string logpath;
-  genLogFile(logpath, thid);
-  trans.logfile_.open(logpath, O_CREAT | O_TRUNC | O_WRONLY, 0644);
-  trans.logfile_.ftruncate(10 ^ 9);
+    std::string logpath;
+    genLogFile(logpath, thid);
+    trans_.logfile_.open(logpath, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    trans_.logfile_.ftruncate(10 ^ 9);
 #endif
 #endif
+  }
 
-#ifdef Linux
-  setThreadAffinity(thid);
-#endif
-
-#if MASSTREE_USE
-  MasstreeWrapper<Tuple>::thread_init(int(thid));
-#endif
-
-  storeRelease(ready, 1);
-  while (!loadAcquire(start)) _mm_pause();
-  while (!loadAcquire(quit)) {
-#if PARTITION_TABLE
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope,
-                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, true,
-                  thid, myres);
-#else
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope,
-                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false,
-                  thid, myres);
-#endif
+  std::vector<Procedure>& procedures() { return trans_.pro_set_; }
 
+  INLINE void prepare() {
 #if PROCEDURE_SORT
-    sort(trans.pro_set_.begin(), trans.pro_set_.end());
+    sort(trans_.pro_set_.begin(), trans_.pro_set_.end());
 #endif
+  }
 
-  RETRY:
-    if (thid == 0) {
-      leaderWork();
+  INLINE void leaderWork() {
+    ::leaderWork();
 #if BACK_OFF
-      leaderBackoffWork(backoff, Result);
+    leaderBackoffWork(backoff_, OccResult);
 #endif
-      // printf("Thread #%d: on CPU %d\n", thid, sched_getcpu());
-    }
+  }
 
-    if (loadAcquire(quit)) break;
-
-    trans.begin();
-    for (auto itr = trans.pro_set_.begin(); itr != trans.pro_set_.end();
-         ++itr) {
-      if ((*itr).ope_ == Ope::READ) {
-        trans.read((*itr).key_);
-      } else if ((*itr).ope_ == Ope::WRITE) {
-        trans.write((*itr).key_);
-      } else if ((*itr).ope_ == Ope::READ_MODIFY_WRITE) {
-        trans.read((*itr).key_);
-        trans.write((*itr).key_);
-      } else {
-        ERR;
-      }
-    }
+  INLINE void begin() { trans_.begin(); }
+
+  INLINE void read(uint64_t key) { trans_.read(key); }
+
+  INLINE void write(uint64_t key) { trans_.write(key); }
 
+  INLINE bool commit() {
     global_lock.w_lock();
-    if (trans.validationPhase()) {
-      trans.writePhase();
-      global_lock.w_unlock();
-      /**
-       * local_commit_counts is used at ../include/backoff.hh to calcurate about
-       * backoff.
-       */
-      storeRelease(myres.local_commit_counts_,
-                   loadAcquire(myres.local_commit_counts_) + 1);
-    } else {
-      trans.abort();
-      ++myres.local_abort_counts_;
-      global_lock.w_unlock();
-      goto RETRY;
-    }
+    if (!trans_.validationPhase()) return false;
+    trans_.writePhase();
+    global_lock.w_unlock();
+    return true;
+  }
+
+  INLINE void abort() {
+    trans_.abort();
+    global_lock.w_unlock();
   }
 
-  return;
+private:
+  TxnExecutor trans_;
+#if BACK_OFF
+  Backoff backoff_;
+#endif
+};
+
+void worker(size_t thid, Driver& driver) {
+  OccEngine engine(thid, OccResult[thid]);
+
+#ifdef Linux
+  setThreadAffinity(thid);
+#endif
+
+#if MASSTREE_USE
+  MasstreeWrapper<Tuple>::thread_init(int(thid));
+#endif
+
+  driver.work(engine, thid);
 }
 
 int main(int argc, char* argv[]) try {
   gflags::SetUsageMessage("K&R OCC benchmark.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  setYcsbZipfSkew(
+          YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len),
+          FLAGS_zipf_skew);
+  ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
   chkArg();
   makeDB();
   progress.resize(FLAGS_thread_num);
 
-  alignas(CACHE_LINE_SIZE) bool start = false;
-  alignas(CACHE_LINE_SIZE) bool quit = false;
   initResult();
-  std::vector<char> readys(FLAGS_thread_num);
-  std::vector<std::thread> thv;
-  for (size_t i = 0; i < FLAGS_thread_num; ++i)
-    thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                     std::ref(quit));
-  waitForReady(readys);
-  storeRelease(start, true);
-  for (size_t i = 0; i < FLAGS_extime; ++i) {
-    sleepMs(1000);
-  }
-  storeRelease(quit, true);
-  for (auto& th : thv) th.join();
+#if PARTITION_TABLE
+  constexpr bool partition = true;
+#else
+  constexpr bool partition = false;
+#endif
+  Driver driver({FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
+                 FLAGS_rratio, FLAGS_rmw, partition, FLAGS_ycsb,
+                 FLAGS_zipf_skew, FLAGS_arrival_rate, FLAGS_arrival_poisson,
+                 FLAGS_clocks_per_us, FLAGS_trace_record, FLAGS_trace_replay,
+                 YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist,
+                         FLAGS_scan_len)},
+                OccResult);
+  driver.run(worker, FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
 
-  for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-    OccResult[0].addLocalAllResult(OccResult[i]);
-  }
   ShowOptParameters();
-  OccResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime,
-                                 FLAGS_thread_num);
+  driver.display(FLAGS_extime);
 
+  result_export.write();
   return 0;
 } catch (bad_alloc) {
   ERR;
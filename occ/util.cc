@@ -78,14 +78,25 @@ void displayDB() {
 }
 
 void displayParameter() {
+  cout << "#FLAGS_arrival_poisson:\t" << FLAGS_arrival_poisson << endl;
+  cout << "#FLAGS_arrival_rate:\t" << FLAGS_arrival_rate << endl;
   cout << "#FLAGS_clocks_per_us:\t" << FLAGS_clocks_per_us << endl;
   cout << "#FLAGS_extime:\t\t" << FLAGS_extime << endl;
   cout << "#FLAGS_max_ope:\t\t" << FLAGS_max_ope << endl;
+  cout << "#FLAGS_request_dist:\t" << FLAGS_request_dist << endl;
+  cout << "#FLAGS_result_file:\t" << FLAGS_result_file << endl;
+  cout << "#FLAGS_result_format:\t" << FLAGS_result_format << endl;
   cout << "#FLAGS_rmw:\t\t" << FLAGS_rmw << endl;
   cout << "#FLAGS_rratio:\t\t" << FLAGS_rratio << endl;
+  cout << "#FLAGS_sample_interval:\t" << FLAGS_sample_interval << endl;
+  cout << "#FLAGS_scan_len:\t" << FLAGS_scan_len << endl;
   cout << "#FLAGS_thread_num:\t" << FLAGS_thread_num << endl;
+  cout << "#FLAGS_trace_record:\t" << FLAGS_trace_record << endl;
+  cout << "#FLAGS_trace_replay:\t" << FLAGS_trace_replay << endl;
   cout << "#FLAGS_tuple_num:\t" << FLAGS_tuple_num << endl;
+  cout << "#FLAGS_warmup:\t\t" << FLAGS_warmup << endl;
   cout << "#FLAGS_ycsb:\t\t" << FLAGS_ycsb << endl;
+  cout << "#FLAGS_ycsb_workload:\t" << FLAGS_ycsb_workload << endl;
   cout << "#FLAGS_zipf_skew:\t" << FLAGS_zipf_skew << endl;
 }
 
@@ -116,26 +116,3 @@ void GarbageCollection::gcVersion([[maybe_unused]] Result *sres_) {
 
   return;
 }
-
-#ifdef CCTR_ON
-void GarbageCollection::gcTMTElements([[maybe_unused]] Result *sres_) {
-  uint32_t threshold = getGcThreshold();
-
-  for (;;) {
-    TransactionTable *tmt = gcq_for_TMT_.front();
-    if (tmt == nullptr) {
-      return;
-    }
-    if (tmt->txid_ < threshold) {
-      gcq_for_TMT_.pop_front();
-      reuse_TMT_element_from_gc_.emplace_back(tmt);
-#if ADD_ANALYSIS
-      ++sres_->local_gc_TMT_elements_counts_;
-#endif
-    } else
-      break;
-  }
-
-  return;
-}
-#endif  // CCTR_ON
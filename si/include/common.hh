@@ -5,6 +5,7 @@
 
 #include "../../include/cache_line_size.hh"
 #include "../../include/int64byte.hh"
+#include "../../include/hash_index.hh"
 #include "../../include/masstree_wrapper.hh"
 #include "transaction_table.hh"
 #include "tuple.hh"
@@ -15,49 +16,94 @@
 #ifdef GLOBAL_VALUE_DEFINE
 #define GLOBAL
 alignas(CACHE_LINE_SIZE) GLOBAL std::atomic<uint64_t> CCtr(0);
+alignas(CACHE_LINE_SIZE) GLOBAL std::atomic<uint32_t> LastCstamp(0);
 #if MASSTREE_USE
+#if HASH_INDEX_USE
+alignas(CACHE_LINE_SIZE) GLOBAL HashIndexWrapper<Tuple> MT;
+#else
 alignas(CACHE_LINE_SIZE) GLOBAL MasstreeWrapper<Tuple> MT;
 #endif
+#endif
 #else
 #define GLOBAL extern
 alignas(CACHE_LINE_SIZE) GLOBAL std::atomic<uint64_t> CCtr;
+alignas(CACHE_LINE_SIZE) GLOBAL std::atomic<uint32_t> LastCstamp;
 #if MASSTREE_USE
+#if HASH_INDEX_USE
+alignas(CACHE_LINE_SIZE) GLOBAL HashIndexWrapper<Tuple> MT;
+#else
 alignas(CACHE_LINE_SIZE) GLOBAL MasstreeWrapper<Tuple> MT;
 #endif
 #endif
+#endif
 
 #ifdef GLOBAL_VALUE_DEFINE
+DEFINE_bool(arrival_poisson, true,
+            "True means Poisson arrivals of the open loop, false means "
+            "fixed intervals.");
+DEFINE_uint64(arrival_rate, 0,
+              "Offered load of all the worker threads[tps]. 0 means the "
+              "closed loop.");
 DEFINE_uint64(clocks_per_us, 2100,
               "CPU_MHz. Use this info for measuring time.");
 DEFINE_uint64(extime, 3, "Execution time[sec].");
 DEFINE_uint64(gc_inter_us, 10, "GC interval[us].");
 DEFINE_uint64(max_ope, 10,
               "Total number of operations per single transaction.");
-DEFINE_uint64(
-    pre_reserve_tmt_element, 100,
-    "Pre-allocating memory for the transaction mapping table elements.");
 DEFINE_uint64(pre_reserve_version, 10000,
               "Pre-allocating memory for the version.");
+DEFINE_string(request_dist, "",
+              "uniform, zipfian, latest or hotspot. It overrides the "
+              "distribution of ycsb_workload.");
+DEFINE_string(result_file, "",
+              "File which the result is appended to in result_format.");
+DEFINE_string(result_format, "",
+              "Format of the exported result, json or csv. Empty means no "
+              "export.");
 DEFINE_bool(rmw, false,
             "True means read modify write, false means blind write.");
 DEFINE_uint64(rratio, 50, "read ratio of single transaction.");
+DEFINE_uint64(sample_interval, 0,
+              "Interval of sampling the throughput[msec]. 0 disables the time "
+              "series.");
+DEFINE_uint64(scan_len, 100,
+              "maximum number of records of a scan of ycsb_workload.");
 DEFINE_uint64(thread_num, 10, "Total number of worker threads.");
+DEFINE_string(trace_record, "",
+              "path prefix of the workload traces to record.");
+DEFINE_string(trace_replay, "",
+              "path prefix of the workload traces to replay.");
 DEFINE_uint64(tuple_num, 1000000, "Total number of records.");
+DEFINE_uint64(warmup, 0,
+              "Warm-up time[sec] before the measured extime. It is excluded "
+              "from the result.");
 DEFINE_bool(ycsb, true,
             "True uses zipf_skew, false uses faster random generator.");
+DEFINE_string(ycsb_workload, "",
+              "YCSB core workload a ~ f. It overrides rratio and rmw.");
 DEFINE_double(zipf_skew, 0, "zipf skew. 0 ~ 0.999...");
 #else
+DECLARE_bool(arrival_poisson);
+DECLARE_uint64(arrival_rate);
 DECLARE_uint64(clocks_per_us);
 DECLARE_uint64(extime);
 DECLARE_uint64(gc_inter_us);
 DECLARE_uint64(max_ope);
-DECLARE_uint64(pre_reserve_tmt_element);
 DECLARE_uint64(pre_reserve_version);
+DECLARE_string(request_dist);
+DECLARE_string(result_file);
+DECLARE_string(result_format);
 DECLARE_bool(rmw);
 DECLARE_uint64(rratio);
+DECLARE_uint64(sample_interval);
+DECLARE_uint64(scan_len);
 DECLARE_uint64(thread_num);
+DECLARE_string(trace_record);
+DECLARE_string(trace_replay);
 DECLARE_uint64(tuple_num);
+DECLARE_uint64(warmup);
 DECLARE_bool(ycsb);
+DECLARE_string(ycsb_workload);
 DECLARE_double(zipf_skew);
 #endif
 
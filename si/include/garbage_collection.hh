@@ -23,10 +23,6 @@ private:
 public:
   // deque を使うのは，どこまでサイズが肥大するか不明瞭であるから．
   // vector のリサイズは要素の全コピーが発生するなどして重いから．
-#ifdef CCTR_ON
-  std::deque<TransactionTable *> gcq_for_TMT_;
-  std::deque<TransactionTable *> reuse_TMT_element_from_gc_;
-#endif  // CCTR_ON
   std::deque <GCElement<Tuple>> gcq_for_versions_;
   std::deque<Version *> reuse_version_from_gc_;
   uint8_t thid_;
@@ -61,10 +57,6 @@ public:
 
   // for worker thread
   void gcVersion(Result *sres_);
-
-#ifdef CCTR_ON
-  void gcTMTElements(Result *sres_);
-#endif  // CCTR_ON
   // -----
 };
 
@@ -14,10 +14,13 @@
 #include "../include/backoff.hh"
 #include "../include/cpu.hh"
 #include "../include/debug.hh"
+#include "../include/driver.hh"
 #include "../include/int64byte.hh"
 #include "../include/procedure.hh"
 #include "../include/random.hh"
 #include "../include/result.hh"
+#include "../include/result_export.hh"
+#include "../include/sampler.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
 #include "../include/zipf.hh"
@@ -29,14 +32,56 @@
 
 using namespace std;
 
-void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
-  Result &myres = std::ref(SIResult[thid]);
-  TxExecutor trans(thid, FLAGS_max_ope, (Result *) &myres);
-  Xoroshiro128Plus rnd;
-  rnd.init();
-  FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
-  GarbageCollection gcob;
-  Backoff backoff(FLAGS_clocks_per_us);
+/**
+ * @brief SI engine for the driver.
+ */
+class SIEngine : public Engine<SIEngine> {
+public:
+  SIEngine(size_t thid, Result &myres)
+          : trans_(thid, FLAGS_max_ope, &myres),
+            backoff_(FLAGS_clocks_per_us) {
+    if (thid == 0) gcob_.decideFirstRange();
+    trans_.gcstart_ = rdtscp();
+  }
+
+  std::vector<Procedure> &procedures() { return trans_.pro_set_; }
+
+  INLINE void leaderWork() {
+    ::leaderWork(gcob_);
+    leaderBackoffWork(backoff_, SIResult);
+  }
+
+  INLINE void begin() { trans_.tbegin(); }
+
+  INLINE void read(uint64_t key) { trans_.tread(key); }
+
+  INLINE void write(uint64_t key) { trans_.twrite(key); }
+
+  INLINE bool aborted() const {
+    return trans_.status_ == TransactionStatus::aborted;
+  }
+
+  INLINE bool commit() {
+    trans_.commit();
+    return true;
+  }
+
+  INLINE void abort() { trans_.abort(); }
+
+  INLINE void committed() {
+    // maintenance phase
+    // garbage collection
+    trans_.mainte();
+  }
+
+private:
+  TxExecutor trans_;
+  GarbageCollection gcob_;
+  Backoff backoff_;
+};
+
+void worker(size_t thid, Driver &driver) {
+  SIEngine engine(thid, SIResult[thid]);
 
 #if MASSTREE_USE
   MasstreeWrapper<Tuple>::thread_init(int(thid));
@@ -49,86 +94,33 @@ void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
   // sysconf(_SC_NPROCESSORS_CONF));
 #endif  // Linux
 
-  if (thid == 0) gcob.decideFirstRange();
-  storeRelease(ready, 1);
-  while (!loadAcquire(start)) _mm_pause();
-  trans.gcstart_ = rdtscp();
-  while (!loadAcquire(quit)) {
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope,
-                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false,
-                  thid, myres);
-RETRY:
-    if (thid == 0) {
-      leaderWork(std::ref(gcob));
-      leaderBackoffWork(backoff, SIResult);
-    }
-    if (loadAcquire(quit)) break;
-
-    trans.tbegin();
-    for (auto itr = trans.pro_set_.begin(); itr != trans.pro_set_.end();
-         ++itr) {
-      if ((*itr).ope_ == Ope::READ) {
-        trans.tread((*itr).key_);
-      } else if ((*itr).ope_ == Ope::WRITE) {
-        trans.twrite((*itr).key_);
-      } else if ((*itr).ope_ == Ope::READ_MODIFY_WRITE) {
-        trans.tread((*itr).key_);
-        trans.twrite((*itr).key_);
-      } else {
-        ERR;
-      }
-
-      if (trans.status_ == TransactionStatus::aborted) {
-        trans.abort();
-        goto RETRY;
-      }
-    }
-
-    trans.commit();
-    /**
-     * local_commit_counts is used at ../include/backoff.hh to calcurate about
-     * backoff.
-     */
-    storeRelease(myres.local_commit_counts_,
-                 loadAcquire(myres.local_commit_counts_) + 1);
-
-    // maintenance phase
-    // garbage collection
-    trans.mainte();
-  }
-
-  return;
+  driver.work(engine, thid);
 }
 
 int main(int argc, char *argv[]) try {
   gflags::SetUsageMessage("SI benchmark.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  setYcsbZipfSkew(
+          YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len),
+          FLAGS_zipf_skew);
+  ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
   chkArg();
   makeDB();
 
-  alignas(CACHE_LINE_SIZE) bool start = false;
-  alignas(CACHE_LINE_SIZE) bool quit = false;
   initResult();
-  std::vector<char> readys(FLAGS_thread_num);
-  std::vector<std::thread> thv;
-  for (size_t i = 0; i < FLAGS_thread_num; ++i)
-    thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                     std::ref(quit));
-  waitForReady(readys);
-  storeRelease(start, true);
-  for (size_t i = 0; i < FLAGS_extime; ++i) {
-    sleepMs(1000);
-  }
-  storeRelease(quit, true);
-  for (auto &th : thv) th.join();
+  Driver driver({FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
+                 FLAGS_rratio, FLAGS_rmw, false, FLAGS_ycsb, FLAGS_zipf_skew,
+                 FLAGS_arrival_rate, FLAGS_arrival_poisson,
+                 FLAGS_clocks_per_us, FLAGS_trace_record, FLAGS_trace_replay,
+                 YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist,
+                         FLAGS_scan_len)},
+                SIResult);
+  driver.run(worker, FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
 
-  for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-    SIResult[0].addLocalAllResult(SIResult[i]);
-  }
   ShowOptParameters();
-  SIResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime,
-                               FLAGS_thread_num);
+  driver.display(FLAGS_extime);
 
+  result_export.write();
   return 0;
 } catch (bad_alloc) {
   ERR;
@@ -52,64 +52,13 @@ inline SetElement<Tuple> *TxExecutor::searchWriteSet(uint64_t key) {
  */
 void TxExecutor::tbegin() {
 #ifdef CCTR_ON
-  TransactionTable *newElement, *tmt;
-
-  tmt = loadAcquire(TMT[thid_]);
-  uint32_t lastcstamp;
-  if (this->status_ == TransactionStatus::aborted) {
-    /**
-     * If this transaction is retry by abort,
-     * its lastcstamp is last one.
-     */
-    lastcstamp = this->txid_ = tmt->lastcstamp_.load(std::memory_order_acquire);
-  } else {
-    /**
-     * If this transaction is after committed transaction,
-     * its lastcstamp is that's one.
-     */
-    lastcstamp = this->txid_ = cstamp_;
-  }
-
-  if (gcobject_.reuse_TMT_element_from_gc_.empty()) {
-    /**
-     * If no cache,
-     */
-    newElement = new TransactionTable(0, lastcstamp);
-#if ADD_ANALYSIS
-    ++sres_->local_TMT_element_malloc_;
-#endif
-  } else {
-    /**
-     * If it has cache, this transaction use it.
-     */
-    newElement = gcobject_.reuse_TMT_element_from_gc_.back();
-    gcobject_.reuse_TMT_element_from_gc_.pop_back();
-    newElement->set(0, lastcstamp);
-#if ADD_ANALYSIS
-    ++sres_->local_TMT_element_reuse_;
-#endif
-  }
-
-  /**
-   * Check the latest commit timestamp.
-   */
-  for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-    do {
-      tmt = loadAcquire(TMT[i]);
-    } while (tmt == nullptr);
-    this->txid_ = max(this->txid_, tmt->lastcstamp_.load(memory_order_acquire));
-  }
-  this->txid_ += 1;
-  newElement->txid_ = this->txid_;
-
-  /**
-   * Old object becomes cache object.
-   */
-  gcobject_.gcq_for_TMT_.emplace_back(loadAcquire(TMT[thid_]));
   /**
-   * New object is registerd to transaction mapping table.
+   * Take the latest commit timestamp which committers publish to LastCstamp,
+   * instead of checking those of all the worker threads in the transaction
+   * mapping table. It is not less than the last one of this thread.
    */
-  storeRelease(TMT[thid_], newElement);
+  this->txid_ = LastCstamp.load(std::memory_order_acquire) + 1;
+  TMT[thid_]->txid_.store(this->txid_, std::memory_order_release);
 #endif  // CCTR_ON
 
 #ifdef CCTR_TW
@@ -180,7 +129,7 @@ void TxExecutor::tread(uint64_t key) {
 
 FINISH_TREAD:
 #if ADD_ANALYSIS
-  sres_->local_read_latency_ += rdtscp() - start;
+  sres_->recordReadLatency(rdtscp() - start);
 #endif
   return;
 }
@@ -309,7 +258,7 @@ void TxExecutor::twrite(uint64_t key) {
 FINISH_WRITE:
 
 #if ADD_ANALYSIS
-  sres_->local_write_latency_ += rdtscp() - start;
+  sres_->recordWriteLatency(rdtscp() - start);
 #endif
   return;
 }
@@ -350,10 +299,18 @@ void TxExecutor::commit() {
   read_set_.clear();
   write_set_.clear();
 
+#ifdef CCTR_ON
   /**
-   * update lastcstamp.
+   * publish the commit timestamp if it is the latest one.
    */
-  TMT[thid_]->lastcstamp_.store(this->cstamp_, std::memory_order_release);
+  uint32_t expected = LastCstamp.load(std::memory_order_acquire);
+  while (expected < this->cstamp_) {
+    if (LastCstamp.compare_exchange_weak(expected, this->cstamp_,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire))
+      break;
+  }
+#endif  // CCTR_ON
 #if ADD_ANALYSIS
   sres_->local_commit_latency_ += rdtscp() - start;
 #endif
@@ -383,7 +340,6 @@ void TxExecutor::abort() {
 
   read_set_.clear();
   write_set_.clear();
-  ++sres_->local_abort_counts_;
 
 #if BACK_OFF
 #if ADD_ANALYSIS
@@ -426,11 +382,8 @@ void TxExecutor::mainte() {
       gcobject_.gcVersion(sres_);
       pre_gc_threshold_ = load_threshold;
       gcstart_ = gcstop_;
-#ifdef CCTR_ON
-      gcobject_.gcTMTElements(sres_);
-#endif
 #if ADD_ANALYSIS
-      sres_->local_gc_latency_ += rdtscp() - start;
+      sres_->recordGCLatency(rdtscp() - start);
 #endif
     }
   }
@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+
+#include "include/atomic_tool.hh"
+#include "include/checkpointer.hh"
+#include "include/common.hh"
+#include "include/logger.hh"
+#include "include/tuple.hh"
+
+#include "../include/atomic_wrapper.hh"
+#include "../include/debug.hh"
+#include "../include/fileio.hh"
+#include "../include/tsc.hh"
+#include "../include/util.hh"
+
+using std::cout;
+using std::endl;
+
+Checkpointer SiloCheckpointer;
+
+uint64_t Checkpointer::writePart(const std::string &path, uint64_t start,
+                                 uint64_t end) {
+  File file;
+  if (!file.open(path, O_CREAT | O_TRUNC | O_WRONLY, 0644)) ERR;
+
+  const std::size_t capacity = (1UL << 20) / sizeof(CheckpointRecord);
+  std::vector<CheckpointRecord> buf(capacity);
+  std::size_t num = 0;
+  uint64_t byte_count = 0;
+  for (uint64_t key = start; key < end; ++key) {
+    Tuple *tuple = &Table[key];
+    CheckpointRecord &rec = buf[num];
+    Tidword expected, check;
+
+    // read a committed value in the same way as the read phase.
+    expected.obj_ = loadAcquire(tuple->tidword_.obj_);
+    for (;;) {
+      while (expected.lock) {
+        expected.obj_ = loadAcquire(tuple->tidword_.obj_);
+      }
+      memcpy(rec.val_, tuple->val(), VAL_SIZE);
+      check.obj_ = loadAcquire(tuple->tidword_.obj_);
+      if (expected == check) break;
+      expected = check;
+    }
+    rec.tid_ = expected.obj_;
+
+    if (++num == capacity) {
+      file.write((void *) buf.data(), sizeof(CheckpointRecord) * num);
+      byte_count += sizeof(CheckpointRecord) * num;
+      num = 0;
+    }
+  }
+  file.write((void *) buf.data(), sizeof(CheckpointRecord) * num);
+  byte_count += sizeof(CheckpointRecord) * num;
+  file.fdatasync();
+  return byte_count;
+}
+
+bool Checkpointer::checkpoint(const bool &quit) {
+  /**
+   * The global epoch advances only after all the workers have loaded the
+   * current one, so the transactions of (global epoch - 2) or older have
+   * already been completed.
+   */
+  const uint64_t replay_epoch = atomicLoadGE() - 1;
+  if (replay_epoch <= last_replay_epoch_) return true;
+
+  uint64_t start = rdtscp();
+  const std::string dir = checkpointDir(replay_epoch);
+  boost::filesystem::create_directories(dir);
+
+  const std::size_t part_num = FLAGS_checkpoint_thread_num;
+  std::vector<uint64_t> byte_counts(part_num);
+  std::vector<std::thread> thv;
+  for (std::size_t i = 0; i < part_num; ++i) {
+    thv.emplace_back([&, i] {
+      byte_counts[i] = writePart(
+              checkpointPartFile(replay_epoch, i),
+              checkpointPartStart(FLAGS_tuple_num, part_num, i),
+              checkpointPartStart(FLAGS_tuple_num, part_num, i + 1));
+    });
+  }
+  for (auto &th : thv) th.join();
+
+  CheckpointMeta meta;
+  meta.replay_epoch_ = replay_epoch;
+  meta.end_epoch_ = atomicLoadGE();
+  meta.tuple_num_ = FLAGS_tuple_num;
+  meta.part_num_ = part_num;
+
+#if WAL
+  /**
+   * The checkpoint may include values of non-durable epochs. It is published
+   * after the durable epoch reaches the epoch at its end.
+   */
+  while (loadAcquire(DurableEpoch.obj_) < meta.end_epoch_) {
+    if (loadAcquire(quit)) {
+      boost::filesystem::remove_all(dir);
+      return false;
+    }
+    sleepMs(1);
+  }
+#else
+  (void) quit;
+#endif
+
+  // publish the checkpoint atomically by rename.
+  {
+    File file;
+    if (!file.open("checkpoint/latest.tmp", O_CREAT | O_TRUNC | O_WRONLY,
+                   0644))
+      ERR;
+    file.write((void *) &meta, sizeof(CheckpointMeta));
+    file.fdatasync();
+  }
+  if (::rename("checkpoint/latest.tmp", "checkpoint/latest") != 0)
+    throw LibcError(errno, "rename failed: ");
+
+  if (last_replay_epoch_ != 0)
+    boost::filesystem::remove_all(checkpointDir(last_replay_epoch_));
+  last_replay_epoch_ = replay_epoch;
+
+#if WAL
+  truncateLog(replay_epoch);
+#endif
+
+  ++checkpoint_count_;
+  for (auto &count : byte_counts) byte_count_ += count;
+  clocks_ += rdtscp() - start;
+  return true;
+}
+
+void Checkpointer::worker(const bool &start, const bool &quit) {
+  while (!loadAcquire(start)) _mm_pause();
+  for (;;) {
+    for (uint64_t i = 0; i < FLAGS_checkpoint_interval; ++i) {
+      if (loadAcquire(quit)) return;
+      sleepMs(1);
+    }
+    if (!checkpoint(quit)) return;
+  }
+}
+
+void initCheckpointer() {
+  if (FLAGS_checkpoint_thread_num == 0 ||
+      FLAGS_checkpoint_thread_num > FLAGS_tuple_num)
+    ERR;
+  SiloCheckpointer = Checkpointer();
+
+  // a checkpoint of the previous run doesn't match the new log.
+  const boost::filesystem::path dir_path("checkpoint");
+  boost::filesystem::remove_all(dir_path);
+  boost::system::error_code error;
+  const bool result = boost::filesystem::create_directory(dir_path, error);
+  if (!result || error) ERR;
+}
+
+void checkpointerWorker(const bool &start, const bool &quit) {
+  SiloCheckpointer.worker(start, quit);
+}
+
+void displayCheckpointResult() {
+  cout << "checkpoint_counts:\t" << SiloCheckpointer.checkpoint_count_ << endl;
+  cout << "checkpoint_bytes:\t" << SiloCheckpointer.byte_count_ << endl;
+  if (SiloCheckpointer.checkpoint_count_ == 0) return;
+  double sec = (double) SiloCheckpointer.clocks_ /
+               ((double) FLAGS_clocks_per_us * 1000 * 1000);
+  cout << std::fixed << std::setprecision(4);
+  cout << "checkpoint_latency[s]:\t"
+       << sec / (double) SiloCheckpointer.checkpoint_count_ << endl;
+  cout << "checkpoint_throughput[MB/s]:\t"
+       << (double) SiloCheckpointer.byte_count_ / sec / (1UL << 20) << endl;
+  cout << std::defaultfloat;
+}
@@ -0,0 +1,53 @@
+#include <algorithm>
+
+#include "../include/debug.hh"
+#include "../include/result.hh"
+#include "../include/tsc.hh"
+#include "include/atomic_tool.hh"
+#include "include/common.hh"
+#include "include/garbage_collection.hh"
+
+Tuple *GarbageCollection::newRecord([[maybe_unused]] Result *sres) {
+  if (reuse_record_from_gc_.empty()) {
+#if ADD_ANALYSIS
+    ++sres->local_version_malloc_;
+#endif
+    return new Tuple();
+  }
+  Tuple *tuple = reuse_record_from_gc_.back();
+  reuse_record_from_gc_.pop_back();
+#if ADD_ANALYSIS
+  ++sres->local_version_reuse_;
+#endif
+  return tuple;
+}
+
+void GarbageCollection::gcRecord([[maybe_unused]] Result *sres) {
+  if (gcq_for_record_.empty()) return;
+  // the own local epoch is a cheap upper bound of the smallest one.
+  if (gcq_for_record_.front().first + 1 >=
+      loadAcquire(ThLocalEpoch[thid_].obj_))
+    return;
+
+#if ADD_ANALYSIS
+  uint64_t start = rdtscp();
+  ++sres->local_gc_counts_;
+#endif
+  uint64_t min_epoch = UINT64_MAX;
+  for (unsigned int i = 0; i < FLAGS_thread_num; ++i)
+    min_epoch = std::min(min_epoch, loadAcquire(ThLocalEpoch[i].obj_));
+
+  while (!gcq_for_record_.empty() &&
+         gcq_for_record_.front().first + 1 < min_epoch) {
+    Tuple *tuple = gcq_for_record_.front().second;
+    tuple->freeVal(*SlabAllocators[thid_]);
+    reuse_record_from_gc_.emplace_back(tuple);
+    gcq_for_record_.pop_front();
+#if ADD_ANALYSIS
+    ++sres->local_gc_version_counts_;
+#endif
+  }
+#if ADD_ANALYSIS
+  sres->recordGCLatency(rdtscp() - start);
+#endif
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief A record of a checkpoint file.
+ * @details Its key is implicit. The file of a partition is the array of the
+ * records of the keys in the partition.
+ */
+class CheckpointRecord {
+public:
+  uint64_t tid_;
+  char val_[VAL_SIZE];
+};
+
+/**
+ * @brief Metadata of a published checkpoint, stored in checkpoint/latest.
+ * @details Recovery loads the checkpoint and replays log records whose epoch
+ * is replay_epoch_ or later. All the transactions of older epochs had been
+ * completed before the checkpointer started to read Table. The checkpoint was
+ * published after the durable epoch reached end_epoch_.
+ */
+class CheckpointMeta {
+public:
+  uint64_t replay_epoch_ = 0;
+  uint64_t end_epoch_ = 0;
+  uint64_t tuple_num_ = 0;
+  uint64_t part_num_ = 0;
+};
+
+inline std::string checkpointDir(uint64_t replay_epoch) {
+  return "checkpoint/" + std::to_string(replay_epoch);
+}
+
+inline std::string checkpointPartFile(uint64_t replay_epoch,
+                                      std::size_t part) {
+  return checkpointDir(replay_epoch) + "/part" + std::to_string(part);
+}
+
+/**
+ * @brief The first key of the partition. The partition ends at the first
+ * key of the next partition.
+ */
+inline uint64_t checkpointPartStart(uint64_t tuple_num, uint64_t part_num,
+                                    std::size_t part) {
+  return tuple_num * part / part_num;
+}
+
+/**
+ * @brief Background checkpointer.
+ * @details It takes a fuzzy checkpoint of Table every checkpoint_interval
+ * msec while the workers keep running, in the style of Silo's checkpointer.
+ * checkpoint_thread_num threads write the partitions to their own files in
+ * parallel. Each value is read in the same way as the read phase, so it is a
+ * committed value. Replaying the log from the replay epoch over it gives a
+ * consistent state, so the log older than the replay epoch is truncated.
+ */
+class Checkpointer {
+public:
+  uint64_t last_replay_epoch_ = 0;
+
+  // for analysis
+  uint64_t checkpoint_count_ = 0;
+  uint64_t byte_count_ = 0;
+  uint64_t clocks_ = 0;
+
+  void worker(const bool &start, const bool &quit);
+
+  /**
+   * @brief take one checkpoint.
+   * @return false if it is abandoned by quit.
+   */
+  bool checkpoint(const bool &quit);
+
+  /**
+   * @brief write the partition [start, end) of Table to the file.
+   * @return the number of written bytes.
+   */
+  static uint64_t writePart(const std::string &path, uint64_t start,
+                            uint64_t end);
+};
+
+extern Checkpointer SiloCheckpointer;
+
+extern void initCheckpointer();
+
+extern void checkpointerWorker(const bool &start, const bool &quit);
+
+extern void displayCheckpointResult();
@@ -3,13 +3,18 @@
 #include <pthread.h>
 #include <atomic>
 #include <iostream>
+#include <memory>
 #include <queue>
+#include <vector>
 
 #include "tuple.hh"
 
 #include "../../include/cache_line_size.hh"
 #include "../../include/int64byte.hh"
+#include "../../include/hash_index.hh"
 #include "../../include/masstree_wrapper.hh"
+#include "../../include/slab.hh"
+#include "../../include/value_size.hh"
 
 #include "gflags/gflags.h"
 #include "glog/logging.h"
@@ -17,42 +22,136 @@
 #ifdef GLOBAL_VALUE_DEFINE
 #define GLOBAL
 alignas(CACHE_LINE_SIZE) GLOBAL uint64_t_64byte GlobalEpoch(1);
+alignas(CACHE_LINE_SIZE) GLOBAL uint64_t_64byte DurableEpoch(0);
+alignas(CACHE_LINE_SIZE) GLOBAL ValueSize ValueSizes(VAL_SIZE, "");
 #if MASSTREE_USE
+#if HASH_INDEX_USE
+alignas(CACHE_LINE_SIZE) GLOBAL HashIndexWrapper<Tuple> MT;
+#else
 alignas(CACHE_LINE_SIZE) GLOBAL MasstreeWrapper<Tuple> MT;
 #endif
+#endif
 #else
 #define GLOBAL extern
 alignas(CACHE_LINE_SIZE) GLOBAL uint64_t_64byte GlobalEpoch;
+alignas(CACHE_LINE_SIZE) GLOBAL uint64_t_64byte DurableEpoch;
+alignas(CACHE_LINE_SIZE) GLOBAL ValueSize ValueSizes;
 #if MASSTREE_USE
+#if HASH_INDEX_USE
+alignas(CACHE_LINE_SIZE) GLOBAL HashIndexWrapper<Tuple> MT;
+#else
 alignas(CACHE_LINE_SIZE) GLOBAL MasstreeWrapper<Tuple> MT;
 #endif
 #endif
+#endif
 
 #ifdef GLOBAL_VALUE_DEFINE
+DEFINE_bool(arrival_poisson, true,
+            "True means Poisson arrivals of the open loop, false means "
+            "fixed intervals.");
+DEFINE_uint64(arrival_rate, 0,
+              "Offered load of all the worker threads[tps]. 0 means the "
+              "closed loop.");
+DEFINE_uint64(buffer_num, 8, "Number of log buffers per worker thread.");
+DEFINE_uint64(buffer_size, 512, "Size of a log buffer[KiB].");
+DEFINE_uint64(checkpoint_interval, 0,
+              "Interval of checkpoints[msec]. 0 disables the checkpointer.");
+DEFINE_uint64(checkpoint_thread_num, 1,
+              "Number of checkpointer threads. Each writes one partition.");
 DEFINE_uint64(clocks_per_us, 2100,
               "CPU_MHz. Use this info for measuring time.");
 DEFINE_uint64(epoch_time, 40, "Epoch interval[msec].");
 DEFINE_uint64(extime, 3, "Execution time[sec].");
+DEFINE_uint64(logger_num, 1,
+              "Total number of logger threads. It is used when WAL is on.");
 DEFINE_uint64(max_ope, 10,
               "Total number of operations per single transaction.");
+DEFINE_string(request_dist, "",
+              "uniform, zipfian, latest or hotspot. It overrides the "
+              "distribution of ycsb_workload.");
+DEFINE_string(result_file, "",
+              "File which the result is appended to in result_format.");
+DEFINE_string(result_format, "",
+              "Format of the exported result, json or csv. Empty means no "
+              "export.");
 DEFINE_bool(rmw, false,
             "True means read modify write, false means blind write.");
 DEFINE_uint64(rratio, 50, "read ratio of single transaction.");
+DEFINE_uint64(sample_interval, 0,
+              "Interval of sampling the throughput[msec]. 0 disables the time "
+              "series.");
+DEFINE_uint64(scan_len, 100,
+              "maximum number of records of a scan of ycsb_workload.");
+DEFINE_string(snapshot, "",
+              "Path of the snapshot of the loaded table. If it matches, the "
+              "table is loaded from it instead of being built, otherwise the "
+              "built table is written to it.");
+DEFINE_bool(snapshot_hugepage, false,
+            "True reads the snapshot into memory backed by huge pages.");
+DEFINE_bool(snapshot_populate, true,
+            "True prefaults the mapped snapshot by MAP_POPULATE.");
+DEFINE_string(sweep_max_ope, "",
+              "comma separated list of max_ope for a sweep.");
+DEFINE_string(sweep_rratio, "", "comma separated list of rratio for a sweep.");
+DEFINE_string(sweep_thread_num, "",
+              "comma separated list of thread_num for a sweep.");
+DEFINE_string(sweep_zipf_skew, "",
+              "comma separated list of zipf_skew for a sweep.");
 DEFINE_uint64(thread_num, 10, "Total number of worker threads.");
+DEFINE_string(trace_record, "",
+              "path prefix of the workload traces to record.");
+DEFINE_string(trace_replay, "",
+              "path prefix of the workload traces to replay.");
 DEFINE_uint64(tuple_num, 1000000, "Total number of records.");
+DEFINE_uint64(val_size, VAL_SIZE,
+              "Size of a value[byte] of the fixed val_size_dist. VAL_SIZE is "
+              "the default.");
+DEFINE_string(val_size_dist, "",
+              "Distribution of the value sizes of the keys: fixed, "
+              "uniform:MIN:MAX or bimodal:SMALL:LARGE:PERCENT.");
+DEFINE_uint64(warmup, 0,
+              "Warm-up time[sec] before the measured extime. It is excluded "
+              "from the result.");
 DEFINE_bool(ycsb, true,
             "True uses zipf_skew, false uses faster random generator.");
+DEFINE_string(ycsb_workload, "",
+              "YCSB core workload a ~ f. It overrides rratio and rmw.");
 DEFINE_double(zipf_skew, 0, "zipf skew. 0 ~ 0.999...");
 #else
+DECLARE_bool(arrival_poisson);
+DECLARE_uint64(arrival_rate);
+DECLARE_uint64(buffer_num);
+DECLARE_uint64(buffer_size);
+DECLARE_uint64(checkpoint_interval);
+DECLARE_uint64(checkpoint_thread_num);
 DECLARE_uint64(clocks_per_us);
 DECLARE_uint64(epoch_time);
 DECLARE_uint64(extime);
+DECLARE_uint64(logger_num);
 DECLARE_uint64(max_ope);
+DECLARE_string(request_dist);
+DECLARE_string(result_file);
+DECLARE_string(result_format);
 DECLARE_bool(rmw);
 DECLARE_uint64(rratio);
+DECLARE_uint64(sample_interval);
+DECLARE_uint64(scan_len);
+DECLARE_string(snapshot);
+DECLARE_bool(snapshot_hugepage);
+DECLARE_bool(snapshot_populate);
+DECLARE_string(sweep_max_ope);
+DECLARE_string(sweep_rratio);
+DECLARE_string(sweep_thread_num);
+DECLARE_string(sweep_zipf_skew);
 DECLARE_uint64(thread_num);
+DECLARE_string(trace_record);
+DECLARE_string(trace_replay);
 DECLARE_uint64(tuple_num);
+DECLARE_uint64(val_size);
+DECLARE_string(val_size_dist);
+DECLARE_uint64(warmup);
 DECLARE_bool(ycsb);
+DECLARE_string(ycsb_workload);
 DECLARE_double(zipf_skew);
 #endif
 
@@ -60,3 +159,5 @@ alignas(CACHE_LINE_SIZE) GLOBAL uint64_t_64byte *ThLocalEpoch;
 alignas(CACHE_LINE_SIZE) GLOBAL uint64_t_64byte *CTIDW;
 
 alignas(CACHE_LINE_SIZE) GLOBAL Tuple *Table;
+// values of the records. A loader and a worker use that of its thread id.
+GLOBAL std::vector<std::unique_ptr<SlabAllocator>> SlabAllocators;
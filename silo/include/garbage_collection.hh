@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+#include "../../include/inline.hh"
+#include "../../include/result.hh"
+#include "tuple.hh"
+
+/**
+ * @brief Epoch-based reclamation of the records removed from the index.
+ * @details A record removed in epoch e may still be used by a transaction
+ * which found it before the removal. Such a transaction has the local epoch
+ * e or less until its validation phase, which loads at most e + 1, because
+ * the global epoch does not advance beyond the smallest local epoch + 1. So
+ * the record is reclaimed when every local epoch is larger than e + 1. A
+ * reclaimed record is reused by the next insert of the worker.
+ */
+class GarbageCollection {
+public:
+  std::deque<std::pair<uint64_t, Tuple *>> gcq_for_record_;
+  std::deque<Tuple *> reuse_record_from_gc_;
+  unsigned int thid_;
+
+  explicit GarbageCollection(unsigned int thid) : thid_(thid) {}
+
+  /**
+   * @brief reclaim the record after the epoch.
+   */
+  INLINE void retire(Tuple *tuple, uint64_t epoch) {
+    gcq_for_record_.emplace_back(epoch, tuple);
+  }
+
+  /**
+   * @brief a record for an insert, reused if possible.
+   */
+  Tuple *newRecord(Result *sres);
+
+  /**
+   * @brief reclaim the records nobody uses anymore.
+   */
+  void gcRecord(Result *sres);
+};
@@ -4,6 +4,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+
+/**
+ * @brief the file of the durable epoch. The loggers write it before they
+ * acknowledge commits, and recovery replays the log records up to it.
+ */
+inline std::string durableEpochFile() { return "log/pepoch"; }
 
 class LogHeader {
 public:
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../include/atomic_wrapper.hh"
+#include "../../include/cache_line_size.hh"
+#include "../../include/debug.hh"
+#include "../../include/fileio.hh"
+#include "../../include/result.hh"
+#include "log.hh"
+#include "silo_op_element.hh"
+
+class Logger;
+
+class LogBufferPool;
+
+/**
+ * @brief Fixed size buffer of log records.
+ * @details A worker fills it and hands it to its logger. The logger writes
+ * it to the log file and returns it to the pool of the worker.
+ */
+class LogBuffer {
+public:
+  LogHeader header_;
+  std::unique_ptr<LogRecord[]> records_;
+  std::size_t capacity_ = 0;
+  // all the records in a buffer belong to this epoch.
+  uint64_t epoch_ = 0;
+  LogBufferPool *pool_ = nullptr;
+
+  void init(std::size_t capacity, LogBufferPool *pool);
+
+  bool empty() { return header_.logRecNum_ == 0; }
+
+  bool full() { return header_.logRecNum_ == capacity_; }
+
+  void push(uint64_t tid, unsigned int key, char *val) {
+    LogRecord *rec = &records_[header_.logRecNum_];
+    new(rec) LogRecord(tid, key, val);
+    header_.chkSum_ += rec->computeChkSum();
+    ++header_.logRecNum_;
+  }
+
+  /**
+   * @brief write header and records to the file.
+   * @pre it is called by the logger thread.
+   */
+  void write(File &logfile);
+};
+
+/**
+ * @brief Per-worker set of log buffers.
+ * @details flushed_epoch_ is the epoch such that all log records of this
+ * worker whose epoch is less than it have already been handed to the logger.
+ * The logger uses it to compute the durable epoch.
+ */
+class LogBufferPool {
+public:
+  alignas(CACHE_LINE_SIZE) uint64_t flushed_epoch_ = 1;
+  LogBuffer *current_ = nullptr;
+  uint64_t current_epoch_ = 0;
+  Logger *logger_ = nullptr;
+
+  std::unique_ptr<LogBuffer[]> buffers_;
+  std::mutex mtx_;
+  std::vector<LogBuffer *> free_;
+
+  void init(Logger *logger, std::size_t buffer_num, std::size_t capacity);
+
+  /**
+   * @brief append log records of the write set of a committing transaction.
+   * @details If the epoch changed, the current buffer is handed to the logger
+   * first, so the logger can make the older epoch durable.
+   */
+  template<typename WriteSet>
+  void add(uint64_t ctid, uint64_t epoch, WriteSet &write_set, char *val) {
+    advanceEpoch(epoch);
+    for (auto itr = write_set.begin(); itr != write_set.end(); ++itr) {
+      // recovery and checkpoints cover the records of Table only. chkArg
+      // refuses ycsb_workload with inserts or deletes, and a trace with them
+      // stops here.
+      if ((*itr).op_ != OpType::UPDATE) {
+        std::cout << "WAL does not support insert and delete." << std::endl;
+        ERR;
+      }
+      if (current_->full()) publish();
+      current_->epoch_ = epoch;
+      current_->push(ctid, (*itr).key_, val);
+    }
+  }
+
+  /**
+   * @brief hand the current buffer to the logger if it includes records of
+   * the older epoch, and publish the epoch.
+   */
+  void advanceEpoch(uint64_t epoch);
+
+  /**
+   * @brief hand the current buffer to the logger and take a free buffer.
+   * @details If there is no free buffer, it waits for the logger.
+   */
+  void publish();
+
+  /**
+   * @brief the logger returns the written buffer.
+   */
+  void release(LogBuffer *buffer);
+
+  /**
+   * @brief hand the rest to the logger at the end of the worker.
+   */
+  void terminate();
+};
+
+/**
+ * @brief Archived log file.
+ */
+class LogSegment {
+public:
+  std::string path_;
+  uint64_t max_epoch_;
+
+  LogSegment(std::string path, uint64_t max_epoch)
+          : path_(std::move(path)), max_epoch_(max_epoch) {}
+};
+
+/**
+ * @brief Logger thread context.
+ * @details Each logger owns the log buffer pools of the workers whose
+ * (thid % logger_num) equals its id, and writes their buffers to its own log
+ * file. It calls fdatasync once per advance of the epoch and publishes its
+ * durable epoch. The global durable epoch is the minimum of those.
+ * When a checkpoint is published, the log file is archived as
+ * log<id>.<segment id> and the archived files whose records are all older
+ * than the replay epoch of the checkpoint are removed.
+ */
+class Logger {
+public:
+  alignas(CACHE_LINE_SIZE) uint64_t durable_epoch_ = 0;
+  std::size_t id_;
+  File logfile_;
+  std::vector<LogBufferPool *> pools_;
+
+  std::mutex mtx_;
+  std::deque<LogBuffer *> queue_;
+
+  // requested by the checkpointer.
+  alignas(CACHE_LINE_SIZE) uint64_t truncate_epoch_ = 0;
+  uint64_t truncated_epoch_ = 0;
+  std::string logpath_;
+  uint64_t segment_id_ = 0;
+  uint64_t segment_max_epoch_ = 0;
+  std::deque<LogSegment> segments_;
+
+  // for analysis
+  uint64_t byte_count_ = 0;
+  uint64_t flush_count_ = 0;
+  uint64_t removed_segment_count_ = 0;
+
+  explicit Logger(std::size_t id) : id_(id) {}
+
+  void enqueue(LogBuffer *buffer) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    queue_.emplace_back(buffer);
+  }
+
+  uint64_t minFlushedEpoch();
+
+  void worker();
+
+  /**
+   * @brief write the queued buffers and return them to the pools.
+   * @return true if it wrote some buffers.
+   */
+  bool writeQueuedBuffers();
+
+  /**
+   * @brief archive the log file and remove the archived files older than
+   * the epoch.
+   */
+  void truncate(uint64_t epoch);
+};
+
+/**
+ * @brief The time when the durable epoch reached each epoch.
+ * @details The logger which advances the durable epoch records the time of
+ * the new durable epochs before it publishes them, so a worker computes the
+ * durable latency of a commit by that time whenever it acknowledges it. It is
+ * a ring indexed by the epoch, and an overwritten epoch has no time.
+ */
+class DurableClock {
+public:
+  static constexpr std::size_t kSize = 1024;
+
+  /**
+   * @brief record the time of the epochs in (from, to].
+   */
+  void record(uint64_t from, uint64_t to, uint64_t now) {
+    for (uint64_t epoch = from + 1; epoch <= to && epoch - from <= kSize;
+         ++epoch) {
+      Slot &slot = slots_[epoch % kSize];
+      storeRelease(slot.time_, now);
+      storeRelease(slot.epoch_, epoch);
+    }
+  }
+
+  /**
+   * @return the time when the epoch became durable, or now if it is unknown.
+   */
+  uint64_t at(uint64_t epoch, uint64_t now) {
+    Slot &slot = slots_[epoch % kSize];
+    if (loadAcquire(slot.epoch_) != epoch) return now;
+    return loadAcquire(slot.time_);
+  }
+
+private:
+  class Slot {
+  public:
+    uint64_t epoch_ = 0;
+    uint64_t time_ = 0;
+  };
+
+  Slot slots_[kSize];
+};
+
+extern DurableClock SiloDurableClock;
+
+/**
+ * @brief Committed transactions waiting for the durable epoch.
+ * @details Silo acknowledges a commit only after the durable epoch reaches
+ * the epoch of the transaction. Consecutive commits in the same epoch are
+ * merged into one element, so pushing is O(1) and the memory is O(epochs).
+ * The latency of a commit ends when its epoch became durable, not when it is
+ * acknowledged, so it doesn't depend on how often the worker checks.
+ */
+class PendingCommitQueue {
+public:
+  class Element {
+  public:
+    uint64_t epoch_;
+    uint64_t count_;
+    uint64_t start_sum_;
+
+    Element(uint64_t epoch, uint64_t start)
+            : epoch_(epoch), count_(1), start_sum_(start) {}
+  };
+
+  std::deque<Element> queue_;
+
+  void push(uint64_t epoch, uint64_t txn_start) {
+    if (!queue_.empty() && queue_.back().epoch_ == epoch) {
+      ++queue_.back().count_;
+      queue_.back().start_sum_ += txn_start;
+    } else {
+      queue_.emplace_back(epoch, txn_start);
+    }
+  }
+
+  /**
+   * @brief acknowledge commits whose epoch is durable.
+   */
+  void ack(uint64_t durable_epoch, uint64_t now, Result &res) {
+    while (!queue_.empty() && queue_.front().epoch_ <= durable_epoch) {
+      Element &elem = queue_.front();
+      uint64_t durable = SiloDurableClock.at(elem.epoch_, now);
+      res.local_durable_commit_counts_ += elem.count_;
+      res.local_durable_latency_ += elem.count_ * durable - elem.start_sum_;
+      queue_.pop_front();
+    }
+  }
+};
+
+extern std::vector<std::unique_ptr<Logger>> SiloLoggers;
+extern std::vector<std::unique_ptr<LogBufferPool>> SiloLogBufferPools;
+
+extern void initLogger();
+
+extern void loggerWorker(std::size_t logger_id);
+
+/**
+ * @brief request the loggers to truncate the log older than the epoch.
+ */
+extern void truncateLog(uint64_t epoch);
+
+extern void displayLoggerResult();
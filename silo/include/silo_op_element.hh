@@ -4,16 +4,21 @@
 
 #include "../../include/op_element.hh"
 
+enum class OpType : uint8_t {
+  UPDATE,
+  INSERT,  // the record is the placeholder installed by the insert.
+  DELETE,
+};
+
 template<typename T>
 class ReadElement : public OpElement<T> {
 public:
   using OpElement<T>::OpElement;
 
 
-  ReadElement(uint64_t key, T *rcdptr, char *val, Tidword tidword)
+  ReadElement(uint64_t key, T *rcdptr, Tidword tidword)
           : OpElement<T>::OpElement(key, rcdptr) {
     tidword_.obj_ = tidword.obj_;
-    memcpy(this->val_, val, VAL_SIZE);
   }
 
   bool operator<(const ReadElement &right) const {
@@ -26,7 +31,6 @@ public:
 
 private:
   Tidword tidword_;
-  char val_[VAL_SIZE];
 };
 
 template<typename T>
@@ -34,8 +38,11 @@ class WriteElement : public OpElement<T> {
 public:
   using OpElement<T>::OpElement;
 
-  WriteElement(uint64_t key, T *rcdptr, std::string_view val)
-          : OpElement<T>::OpElement(key, rcdptr) {
+  OpType op_;
+
+  WriteElement(uint64_t key, T *rcdptr, std::string_view val,
+               OpType op = OpType::UPDATE)
+          : OpElement<T>::OpElement(key, rcdptr), op_(op) {
     static_assert(std::string_view("").size() == 0, "Expected behavior was broken.");
     if (val.size() != 0) {
       val_ptr_ = std::make_unique<char[]>(val.size());
@@ -10,12 +10,12 @@
 #include "../../include/result.hh"
 #include "../../include/string.hh"
 #include "common.hh"
+#include "garbage_collection.hh"
 #include "log.hh"
+#include "logger.hh"
 #include "silo_op_element.hh"
 #include "tuple.hh"
 
-#define LOGSET_SIZE 1000
-
 enum class TransactionStatus : uint8_t {
   kInFlight,
   kCommitted,
@@ -27,9 +27,12 @@ public:
   std::vector<ReadElement<Tuple>> read_set_;
   std::vector<WriteElement<Tuple>> write_set_;
   std::vector<Procedure> pro_set_;
+#if MASSTREE_USE
+  decltype(MT)::node_set_type node_set_;
+  std::vector<std::pair<std::uint64_t, Tuple *>> scan_buf_;
+#endif
 
-  std::vector<LogRecord> log_set_;
-  LogHeader latest_log_header_;
+  GarbageCollection gc_;
 
   TransactionStatus status_;
   unsigned int thid_;
@@ -38,14 +41,15 @@ public:
    */
   Result *sres_;
 
-  File logfile_;
+  LogBufferPool *log_buffer_pool_ = nullptr;
 
   Tidword mrctid_;
   Tidword max_rset_, max_wset_;
 
-  char write_val_[VAL_SIZE];
+  // buffers of the largest value size.
+  std::unique_ptr<char[]> write_val_;
   // used by fast approach for benchmark
-  char return_val_[VAL_SIZE];
+  std::unique_ptr<char[]> return_val_;
 
   TxnExecutor(int thid, Result *sres);
 
@@ -59,13 +63,29 @@ public:
 
   void begin();
 
+  /**
+   * @brief Transaction delete function.
+   * @details The record is marked absent and removed from masstree in the
+   * write phase, and reclaimed by the epoch-based garbage collection.
+   * Deleting a missing key does nothing.
+   * @param [in] key The key of key-value
+   */
   void tx_delete(std::uint64_t key);
 
   void displayWriteSet();
 
   Tuple *get_tuple(Tuple *table, std::uint64_t key) { return &table[key]; }
 
-  void insert([[maybe_unused]]std::uint64_t key, [[maybe_unused]]std::string_view val = ""); // NOLINT
+  /**
+   * @brief Transaction insert function.
+   * @details It installs an absent placeholder into masstree in the read
+   * phase, so concurrent inserts of the key conflict. The placeholder is
+   * locked and published in the write phase like a write, or removed by
+   * abort(). If the key is present, the insert fails and the record is read.
+   * If it is absent (being inserted or deleted), the transaction aborts.
+   * @param [in] key The key of key-value
+   */
+  void insert(std::uint64_t key, std::string_view val = ""); // NOLINT
 
   void lockWriteSet();
 
@@ -75,6 +95,21 @@ public:
    */
   void read(std::uint64_t key);
 
+  /**
+   * @brief read the record in the read phase and append it to the read set.
+   */
+  void readRecord(std::uint64_t key, Tuple *tuple);
+
+  /**
+   * @brief Transaction scan function.
+   * @details It reads the records of the keys in [lkey, rkey] like read().
+   * With masstree, the leaves it visits are validated at commit, so the scan
+   * is serializable against inserts and removes in the range.
+   * @param [in] lkey the smallest key of the range.
+   * @param [in] rkey the largest key of the range.
+   */
+  void scan(std::uint64_t lkey, std::uint64_t rkey);
+
   /**
    * @brief Search xxx set
    * @detail Search element of local set corresponding to given key.
@@ -103,6 +138,12 @@ public:
 
   bool validationPhase();
 
+  /**
+   * @brief Append log records of the write set to the log buffer.
+   * @details The logger thread writes the buffer and makes it durable at
+   * the end of the epoch of ctid.
+   * @param [in] ctid The commit tid.
+   */
   void wal(std::uint64_t ctid);
 
   /**
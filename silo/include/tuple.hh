@@ -7,6 +7,8 @@
 #include <cstdint>
 
 #include "../../include/cache_line_size.hh"
+#include "../../include/inline.hh"
+#include "../../include/slab.hh"
 
 struct Tidword {
   union {
@@ -31,7 +33,48 @@ struct Tidword {
 
 class Tuple {
 public:
+  /**
+   * a value up to this size is in the cache line of the tuple. val_size_ is
+   * padded to the alignment of val_ptr_.
+   */
+  static constexpr std::size_t kInlineValSize =
+          CACHE_LINE_SIZE - sizeof(Tidword) - sizeof(char *);
+
   alignas(CACHE_LINE_SIZE) Tidword tidword_;
+  uint32_t val_size_;
+  union {
+    char val_inline_[kInlineValSize];
+    char *val_ptr_;  // a larger value in the slab arena.
+  };
+
+  INLINE char *val() {
+    return val_size_ <= kInlineValSize ? val_inline_ : val_ptr_;
+  }
 
-  char val_[VAL_SIZE];
+  /**
+   * @brief give the tuple a value of the size.
+   */
+  INLINE void allocateVal(uint32_t size, SlabAllocator &slab) {
+    val_size_ = size;
+    if (size > kInlineValSize) val_ptr_ = slab.allocate(size);
+  }
+
+  INLINE void freeVal(SlabAllocator &slab) {
+    if (val_size_ > kInlineValSize) slab.deallocate(val_ptr_, val_size_);
+    val_size_ = 0;
+  }
 };
+
+static_assert(sizeof(Tuple) == CACHE_LINE_SIZE, "a tuple is a cache line");
+
+/**
+ * @brief copy a value of the size.
+ * @details A value of VAL_SIZE, the default size, is copied by the inlined
+ * copy of the constant size instead of the call of memcpy.
+ */
+INLINE void copyVal(char *dst, const char *src, std::size_t size) {
+  if (size == VAL_SIZE)
+    memcpy(dst, src, VAL_SIZE);
+  else
+    memcpy(dst, src, size);
+}
@@ -10,10 +10,14 @@ extern void displayParameter();
 
 extern void genLogFile(std::string &logpath, const int thid);
 
+extern void initEpoch();
+
 extern void leaderWork(uint64_t &epoch_timer_start, uint64_t &epoch_timer_stop);
 
 extern void makeDB();
 
+extern void makeSlabAllocators(size_t num);
+
 extern void partTableInit([[maybe_unused]] size_t thid, uint64_t start,
                           uint64_t end);
 
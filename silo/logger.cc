@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "boost/filesystem.hpp"
+
+#include "include/atomic_tool.hh"
+#include "include/common.hh"
+#include "include/logger.hh"
+#include "include/util.hh"
+
+#include "../include/atomic_wrapper.hh"
+#include "../include/debug.hh"
+#include "../include/fileio.hh"
+#include "../include/tsc.hh"
+
+using std::cout;
+using std::endl;
+
+std::vector<std::unique_ptr<Logger>> SiloLoggers;
+std::vector<std::unique_ptr<LogBufferPool>> SiloLogBufferPools;
+DurableClock SiloDurableClock;
+
+static File DurableEpochFile;
+static std::mutex DurableEpochMutex;
+
+void LogBuffer::init(std::size_t capacity, LogBufferPool *pool) {
+  header_.init();
+  records_ = std::make_unique<LogRecord[]>(capacity);
+  capacity_ = capacity;
+  pool_ = pool;
+}
+
+void LogBuffer::write(File &logfile) {
+  header_.convertChkSumIntoComplementOnTwo();
+  logfile.write((void *) &header_, sizeof(LogHeader));
+  logfile.write((void *) records_.get(),
+                sizeof(LogRecord) * header_.logRecNum_);
+  header_.init();
+}
+
+void LogBufferPool::init(Logger *logger, std::size_t buffer_num,
+                         std::size_t capacity) {
+  logger_ = logger;
+  buffers_ = std::make_unique<LogBuffer[]>(buffer_num);
+  free_.reserve(buffer_num);
+  for (std::size_t i = 0; i < buffer_num; ++i) {
+    buffers_[i].init(capacity, this);
+    free_.emplace_back(&buffers_[i]);
+  }
+  current_ = free_.back();
+  free_.pop_back();
+}
+
+void LogBufferPool::advanceEpoch(uint64_t epoch) {
+  if (epoch <= current_epoch_) return;
+  if (!current_->empty()) publish();
+  current_epoch_ = epoch;
+  storeRelease(flushed_epoch_, epoch);
+}
+
+void LogBufferPool::publish() {
+  logger_->enqueue(current_);
+  current_ = nullptr;
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (!free_.empty()) {
+        current_ = free_.back();
+        free_.pop_back();
+        return;
+      }
+    }
+    _mm_pause();
+  }
+}
+
+void LogBufferPool::release(LogBuffer *buffer) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  free_.emplace_back(buffer);
+}
+
+void LogBufferPool::terminate() {
+  if (!current_->empty()) publish();
+  storeRelease(flushed_epoch_, std::numeric_limits<uint64_t>::max());
+}
+
+uint64_t Logger::minFlushedEpoch() {
+  uint64_t min_epoch = std::numeric_limits<uint64_t>::max();
+  for (auto &pool : pools_) {
+    min_epoch = std::min(min_epoch, loadAcquire(pool->flushed_epoch_));
+  }
+  return min_epoch;
+}
+
+bool Logger::writeQueuedBuffers() {
+  std::deque<LogBuffer *> queue;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    queue.swap(queue_);
+  }
+  if (queue.empty()) return false;
+
+  for (auto &buffer : queue) {
+    segment_max_epoch_ = std::max(segment_max_epoch_, buffer->epoch_);
+    byte_count_ +=
+            sizeof(LogHeader) + sizeof(LogRecord) * buffer->header_.logRecNum_;
+    buffer->write(logfile_);
+    buffer->pool_->release(buffer);
+  }
+  return true;
+}
+
+/**
+ * @brief write the durable epoch to its file and fdatasync it.
+ */
+static void persistDurableEpoch(uint64_t epoch) {
+  if (::pwrite(DurableEpochFile.fd(), &epoch, sizeof(epoch), 0) !=
+      sizeof(epoch))
+    throw LibcError(errno, "pwrite failed: ");
+  DurableEpochFile.fdatasync();
+}
+
+/**
+ * @brief update the global durable epoch by the minimum of loggers.
+ * @details Like the pepoch file of SiloR, the durable epoch is persisted
+ * before commits are acknowledged, so recovery replays exactly the
+ * acknowledged epochs.
+ */
+static void updateDurableEpoch() {
+  std::lock_guard<std::mutex> lock(DurableEpochMutex);
+  uint64_t min_epoch = std::numeric_limits<uint64_t>::max();
+  for (auto &logger : SiloLoggers) {
+    min_epoch = std::min(min_epoch, loadAcquire(logger->durable_epoch_));
+  }
+
+  uint64_t expected = loadAcquire(DurableEpoch.obj_);
+  if (expected >= min_epoch) return;
+  // after all the loggers finished, every log record is durable, and no
+  // record is newer than the global epoch.
+  persistDurableEpoch(std::min(min_epoch, atomicLoadGE()));
+  SiloDurableClock.record(expected, min_epoch, rdtscp());
+  storeRelease(DurableEpoch.obj_, min_epoch);
+}
+
+void Logger::truncate(uint64_t epoch) {
+  logfile_.fdatasync();
+  ++flush_count_;
+  logfile_.close();
+  std::string segment_path = logpath_ + "." + std::to_string(segment_id_++);
+  if (::rename(logpath_.c_str(), segment_path.c_str()) != 0)
+    throw LibcError(errno, "rename failed: ");
+  segments_.emplace_back(segment_path, segment_max_epoch_);
+  segment_max_epoch_ = 0;
+  if (!logfile_.open(logpath_, O_CREAT | O_TRUNC | O_WRONLY, 0644)) ERR;
+
+  /**
+   * Segments are archived in order, but a slow worker can hand a buffer of
+   * an old epoch later, so each segment is checked by its own max epoch.
+   */
+  for (auto itr = segments_.begin(); itr != segments_.end();) {
+    if (itr->max_epoch_ < epoch) {
+      if (::unlink(itr->path_.c_str()) != 0)
+        throw LibcError(errno, "unlink failed: ");
+      ++removed_segment_count_;
+      itr = segments_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+  truncated_epoch_ = epoch;
+}
+
+void Logger::worker() {
+  for (;;) {
+    uint64_t truncate_epoch = loadAcquire(truncate_epoch_);
+    if (truncate_epoch > truncated_epoch_) truncate(truncate_epoch);
+
+    /**
+     * It must read the flushed epochs before it takes the queue. Workers
+     * enqueue buffers before they publish the new flushed epoch.
+     */
+    uint64_t min_epoch = minFlushedEpoch();
+    bool wrote = writeQueuedBuffers();
+
+    if (min_epoch == std::numeric_limits<uint64_t>::max()) {
+      // all the workers finished and all their buffers were written.
+      if (wrote) {
+        logfile_.fdatasync();
+        ++flush_count_;
+      }
+      storeRelease(durable_epoch_, min_epoch);
+      // the last logger makes every commit durable.
+      updateDurableEpoch();
+      return;
+    }
+
+    if (min_epoch - 1 > durable_epoch_) {
+      // group commit. one fdatasync per advance of the epoch.
+      logfile_.fdatasync();
+      ++flush_count_;
+      storeRelease(durable_epoch_, min_epoch - 1);
+      updateDurableEpoch();
+    } else if (!wrote) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+}
+
+void initLogger() {
+  if (FLAGS_logger_num == 0 || FLAGS_logger_num > FLAGS_thread_num) ERR;
+  // the loggers of the previous point of a sweep.
+  SiloLogBufferPools.clear();
+  SiloLoggers.clear();
+  // every commit of the previous point is durable.
+  storeRelease(DurableEpoch.obj_, atomicLoadGE() - 1);
+
+  const boost::filesystem::path log_dir_path("log");
+  if (!boost::filesystem::exists(log_dir_path)) {
+    boost::system::error_code error;
+    const bool result =
+            boost::filesystem::create_directory(log_dir_path, error);
+    if (!result || error) ERR;
+  }
+  DurableEpochFile.close();
+  if (!DurableEpochFile.open(durableEpochFile(), O_CREAT | O_TRUNC | O_WRONLY,
+                             0644))
+    ERR;
+  persistDurableEpoch(loadAcquire(DurableEpoch.obj_));
+
+  std::size_t capacity = FLAGS_buffer_size * 1024 / sizeof(LogRecord);
+  if (capacity == 0 || FLAGS_buffer_num == 0) ERR;
+
+  for (std::size_t i = 0; i < FLAGS_logger_num; ++i) {
+    SiloLoggers.emplace_back(std::make_unique<Logger>(i));
+    std::string &logpath = SiloLoggers[i]->logpath_;
+    genLogFile(logpath, i);
+    if (!SiloLoggers[i]->logfile_.open(logpath, O_CREAT | O_TRUNC | O_WRONLY,
+                                       0644))
+      ERR;
+  }
+
+  for (std::size_t i = 0; i < FLAGS_thread_num; ++i) {
+    Logger *logger = SiloLoggers[i % FLAGS_logger_num].get();
+    SiloLogBufferPools.emplace_back(std::make_unique<LogBufferPool>());
+    SiloLogBufferPools[i]->init(logger, FLAGS_buffer_num, capacity);
+    logger->pools_.emplace_back(SiloLogBufferPools[i].get());
+  }
+}
+
+void loggerWorker(std::size_t logger_id) { SiloLoggers[logger_id]->worker(); }
+
+void truncateLog(uint64_t epoch) {
+  for (auto &logger : SiloLoggers) storeRelease(logger->truncate_epoch_, epoch);
+}
+
+void displayLoggerResult() {
+  uint64_t byte_count = 0;
+  uint64_t flush_count = 0;
+  uint64_t removed_segment_count = 0;
+  for (auto &logger : SiloLoggers) {
+    byte_count += logger->byte_count_;
+    flush_count += logger->flush_count_;
+    removed_segment_count += logger->removed_segment_count_;
+  }
+  cout << "log_bytes:\t" << byte_count << endl;
+  cout << "fdatasync_counts:\t" << flush_count << endl;
+  cout << "removed_log_segments:\t" << removed_segment_count << endl;
+}
@@ -0,0 +1,363 @@
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define GLOBAL_VALUE_DEFINE
+
+#include "include/checkpointer.hh"
+#include "include/common.hh"
+#include "include/log.hh"
+#include "include/tuple.hh"
+#include "include/util.hh"
+
+#include "../include/cache_line_size.hh"
+#include "../include/config.hh"
+#include "../include/debug.hh"
+#include "../include/fileio.hh"
+#include "../include/masstree_wrapper.hh"
+#include "../include/util.hh"
+
+using std::cout;
+using std::endl;
+
+/**
+ * @brief A pair of a log header and its log records in a mapped log file.
+ */
+class LogBlock {
+public:
+  const LogHeader *header_;
+  const LogRecord *records_;
+  bool valid_ = false;
+
+  LogBlock(const LogHeader *header, const LogRecord *records)
+          : header_(header), records_(records) {}
+};
+
+/**
+ * @brief Log file mapped into the memory.
+ */
+class MappedLogFile {
+public:
+  std::string path_;
+  std::size_t logger_id_;
+  int fd_ = -1;
+  char *addr_ = nullptr;
+  std::size_t size_ = 0;
+  std::vector<LogBlock> blocks_;
+  // blocks_[0, valid_blocks_) are valid. The rest is a torn tail.
+  std::size_t valid_blocks_ = 0;
+
+  MappedLogFile(std::string path, std::size_t logger_id)
+          : path_(std::move(path)), logger_id_(logger_id) {}
+
+  ~MappedLogFile() {
+    if (addr_ != nullptr) ::munmap(addr_, size_);
+    if (fd_ >= 0) ::close(fd_);
+  }
+
+  void map() {
+    fd_ = ::open(path_.c_str(), O_RDONLY);
+    if (fd_ < 0) throw LibcError(errno, "open failed: ");
+    struct stat st;
+    if (::fstat(fd_, &st) < 0) throw LibcError(errno, "fstat failed: ");
+    size_ = st.st_size;
+    if (size_ == 0) return;
+    void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE | MAP_POPULATE,
+                        fd_, 0);
+    if (addr == MAP_FAILED) throw LibcError(errno, "mmap failed: ");
+    addr_ = static_cast<char *>(addr);
+    ::madvise(addr_, size_, MADV_SEQUENTIAL);
+  }
+
+  /**
+   * @brief find the boundaries of blocks by hopping over headers.
+   * @details It stops at an incomplete block, which is a torn write.
+   */
+  void splitBlocks() {
+    std::size_t offset = 0;
+    while (offset + sizeof(LogHeader) <= size_) {
+      const LogHeader *header =
+              reinterpret_cast<const LogHeader *>(addr_ + offset);
+      std::size_t len = sizeof(LogRecord) * header->logRecNum_;
+      if (header->len_val_ != VAL_SIZE ||
+          offset + sizeof(LogHeader) + len > size_)
+        break;
+      blocks_.emplace_back(header, reinterpret_cast<const LogRecord *>(
+              addr_ + offset + sizeof(LogHeader)));
+      offset += sizeof(LogHeader) + len;
+    }
+  }
+};
+
+/**
+ * @brief validate the checksum of the block.
+ * @details The header has the two's complement of the sum of records, so the
+ * total is zero if the block is not broken.
+ */
+static void validateBlock(LogBlock &block) {
+  int chkSum = block.header_->chkSum_;
+  for (unsigned int i = 0; i < block.header_->logRecNum_; ++i) {
+    const int *itr = reinterpret_cast<const int *>(&block.records_[i]);
+    for (unsigned int j = 0; j < sizeof(LogRecord) / sizeof(int); ++j) {
+      chkSum += itr[j];
+    }
+  }
+  block.valid_ = (chkSum == 0);
+}
+
+class Stopwatch {
+public:
+  std::chrono::steady_clock::time_point start_ =
+          std::chrono::steady_clock::now();
+
+  double lap() {
+    auto now = std::chrono::steady_clock::now();
+    double sec = std::chrono::duration<double>(now - start_).count();
+    start_ = now;
+    return sec;
+  }
+};
+
+/**
+ * @brief find the archived segments log<logger_id>.<segment id>.
+ */
+static std::vector<std::string> findLogSegments(const std::string &logpath) {
+  std::vector<std::string> segments;
+  std::size_t pos = logpath.find_last_of('/');
+  std::string dir = logpath.substr(0, pos);
+  std::string prefix = logpath.substr(pos + 1) + ".";
+  DIR *dp = ::opendir(dir.c_str());
+  if (dp == nullptr) return segments;
+  while (struct dirent *ent = ::readdir(dp)) {
+    std::string name(ent->d_name);
+    if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0)
+      segments.emplace_back(dir + "/" + name);
+  }
+  ::closedir(dp);
+  return segments;
+}
+
+/**
+ * @brief load the latest checkpoint.
+ * @return false if there is no checkpoint.
+ */
+static bool loadCheckpointMeta(CheckpointMeta &meta) {
+  File file;
+  if (!file.open("checkpoint/latest", O_RDONLY)) return false;
+  file.read((void *) &meta, sizeof(CheckpointMeta));
+  return true;
+}
+
+static void loadCheckpointPart(const CheckpointMeta &meta, std::size_t part) {
+  uint64_t start =
+          checkpointPartStart(meta.tuple_num_, meta.part_num_, part);
+  uint64_t end =
+          checkpointPartStart(meta.tuple_num_, meta.part_num_, part + 1);
+  File file(checkpointPartFile(meta.replay_epoch_, part), O_RDONLY);
+  const std::size_t capacity = (1UL << 20) / sizeof(CheckpointRecord);
+  std::vector<CheckpointRecord> buf(capacity);
+  for (uint64_t key = start; key < end;) {
+    std::size_t num = std::min<uint64_t>(capacity, end - key);
+    file.read((void *) buf.data(), sizeof(CheckpointRecord) * num);
+    for (std::size_t i = 0; i < num; ++i, ++key) {
+      Table[key].tidword_.obj_ = buf[i].tid_;
+      memcpy(Table[key].val(), buf[i].val_, VAL_SIZE);
+    }
+  }
+}
+
+template<typename Func>
+static void runParallel(std::size_t thread_num, Func func) {
+  std::vector<std::thread> thv;
+  for (std::size_t i = 0; i < thread_num; ++i) thv.emplace_back(func, i);
+  for (auto &th : thv) th.join();
+}
+
+int main(int argc, char *argv[]) try {
+  gflags::SetUsageMessage(
+          "Silo recovery. It rebuilds the database from checkpoint/ and "
+          "log/log*.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  const std::size_t thread_num = FLAGS_thread_num;
+  const uint64_t tuple_num = FLAGS_tuple_num;
+  if (thread_num == 0 || tuple_num < thread_num) ERR;
+  cout << "#FLAGS_thread_num:\t" << FLAGS_thread_num << endl;
+  cout << "#FLAGS_tuple_num:\t" << FLAGS_tuple_num << endl;
+
+  Stopwatch total_sw, sw;
+
+  CheckpointMeta meta;
+  const bool has_checkpoint = loadCheckpointMeta(meta);
+  if (has_checkpoint && meta.tuple_num_ != tuple_num) ERR;
+
+  // map all the log files and archived segments written by loggers.
+  std::vector<std::unique_ptr<MappedLogFile>> files;
+  for (int i = 0;; ++i) {
+    std::string logpath;
+    genLogFileName(logpath, i);
+    struct stat st;
+    if (::stat(logpath.c_str(), &st) != 0) break;
+    files.emplace_back(std::make_unique<MappedLogFile>(logpath, i));
+    for (auto &segment : findLogSegments(logpath))
+      files.emplace_back(std::make_unique<MappedLogFile>(segment, i));
+  }
+  runParallel(files.size(), [&](std::size_t i) {
+    files[i]->map();
+    files[i]->splitBlocks();
+  });
+  double map_time = sw.lap();
+
+  std::vector<LogBlock *> blocks;
+  uint64_t log_bytes = 0;
+  for (auto &file : files) {
+    log_bytes += file->size_;
+    for (auto &block : file->blocks_) blocks.emplace_back(&block);
+  }
+
+  // validate checksums in parallel.
+  runParallel(thread_num, [&](std::size_t thid) {
+    for (std::size_t i = thid; i < blocks.size(); i += thread_num)
+      validateBlock(*blocks[i]);
+  });
+
+  // blocks after a broken block are not durable.
+  std::size_t invalid_blocks = 0;
+  for (auto &file : files) {
+    while (file->valid_blocks_ < file->blocks_.size() &&
+           file->blocks_[file->valid_blocks_].valid_)
+      ++file->valid_blocks_;
+    invalid_blocks += file->blocks_.size() - file->valid_blocks_;
+  }
+  /**
+   * The loggers persisted the durable epoch before they acknowledged the
+   * commits of it, so newer records were never acknowledged.
+   */
+  uint64_t durable_epoch = 0;
+  {
+    File file;
+    if (file.open(durableEpochFile(), O_RDONLY))
+      file.read((void *) &durable_epoch, sizeof(durable_epoch));
+  }
+  // the checkpoint was published after its end epoch became durable.
+  if (has_checkpoint) durable_epoch = std::max(durable_epoch, meta.end_epoch_);
+  // older records are included in the checkpoint.
+  const uint64_t replay_epoch = has_checkpoint ? meta.replay_epoch_ : 0;
+
+  blocks.clear();
+  for (auto &file : files) {
+    for (std::size_t i = 0; i < file->valid_blocks_; ++i)
+      blocks.emplace_back(&file->blocks_[i]);
+  }
+  double validate_time = sw.lap();
+
+  /**
+   * Partition records by key range. buckets[thid][range] is written only by
+   * thid, and it refers the mapped records without copying.
+   */
+  std::vector<std::vector<std::vector<const LogRecord *>>> buckets(
+          thread_num, std::vector<std::vector<const LogRecord *>>(thread_num));
+  std::vector<uint64_t_64byte> record_counts(thread_num);
+  auto range_of = [&](uint64_t key) {
+    return static_cast<std::size_t>(key * thread_num / tuple_num);
+  };
+  runParallel(thread_num, [&](std::size_t thid) {
+    uint64_t count = 0;
+    for (std::size_t i = thid; i < blocks.size(); i += thread_num) {
+      const LogBlock &block = *blocks[i];
+      for (unsigned int j = 0; j < block.header_->logRecNum_; ++j) {
+        const LogRecord *rec = &block.records_[j];
+        Tidword tidw;
+        tidw.obj_ = rec->tid_;
+        ++count;
+        if (tidw.epoch > durable_epoch || tidw.epoch < replay_epoch) continue;
+        if (rec->key_ >= tuple_num) ERR;
+        buckets[thid][range_of(rec->key_)].emplace_back(rec);
+      }
+    }
+    record_counts[thid].obj_ = count;
+  });
+  double partition_time = sw.lap();
+
+  // rebuild Table and index. Each thread owns one key range.
+  if (posix_memalign((void **) &Table, PAGE_SIZE, tuple_num * sizeof(Tuple)) !=
+      0)
+    ERR;
+  makeSlabAllocators(thread_num);
+  runParallel(thread_num, [&](std::size_t thid) {
+    uint64_t start = (tuple_num * thid + thread_num - 1) / thread_num;
+    uint64_t end = (tuple_num * (thid + 1) + thread_num - 1) / thread_num;
+    if (start < end) partTableInit(thid, start, end - 1);
+  });
+  double init_time = sw.lap();
+
+  // overwrite Table by the checkpoint. Each thread loads some partitions.
+  if (has_checkpoint) {
+    runParallel(thread_num, [&](std::size_t thid) {
+      for (std::size_t i = thid; i < meta.part_num_; i += thread_num)
+        loadCheckpointPart(meta, i);
+    });
+  }
+  double checkpoint_time = sw.lap();
+
+  std::vector<uint64_t_64byte> applied_counts(thread_num);
+  runParallel(thread_num, [&](std::size_t thid) {
+    uint64_t count = 0;
+    for (std::size_t i = 0; i < thread_num; ++i) {
+      for (auto rec : buckets[i][thid]) {
+        Tuple *tuple = &Table[rec->key_];
+        if (tuple->tidword_.obj_ < rec->tid_) {
+          tuple->tidword_.obj_ = rec->tid_;
+          memcpy(tuple->val(), rec->val_, VAL_SIZE);
+        }
+        ++count;
+      }
+    }
+    applied_counts[thid].obj_ = count;
+  });
+  double install_time = sw.lap();
+  double total_time = total_sw.lap();
+
+  uint64_t log_records = 0, applied_records = 0;
+  for (std::size_t i = 0; i < thread_num; ++i) {
+    log_records += record_counts[i].obj_;
+    applied_records += applied_counts[i].obj_;
+  }
+
+  cout << "log_files:\t" << files.size() << endl;
+  cout << "log_bytes:\t" << log_bytes << endl;
+  cout << "log_records:\t" << log_records << endl;
+  cout << "invalid_blocks:\t" << invalid_blocks << endl;
+  cout << "durable_epoch:\t" << durable_epoch << endl;
+  cout << "checkpoint_replay_epoch:\t" << replay_epoch << endl;
+  cout << "recovered_records:\t" << applied_records << endl;
+  cout << "discarded_records:\t" << log_records - applied_records << endl;
+  cout << std::fixed << std::setprecision(4);
+  cout << "map_time[s]:\t" << map_time << endl;
+  cout << "validate_time[s]:\t" << validate_time << endl;
+  cout << "partition_time[s]:\t" << partition_time << endl;
+  cout << "init_time[s]:\t" << init_time << endl;
+  cout << "checkpoint_time[s]:\t" << checkpoint_time << endl;
+  cout << "install_time[s]:\t" << install_time << endl;
+  cout << "recovery_time[s]:\t" << total_time << endl;
+  cout << "recovery_throughput[GB/s]:\t"
+       << (double) log_bytes / total_time / (1UL << 30) << endl;
+  cout << "recovery_throughput[records/s]:\t"
+       << (uint64_t)((double) log_records / total_time) << endl;
+
+  return 0;
+} catch (std::bad_alloc &) {
+  ERR;
+}
@@ -8,4 +8,7 @@ using namespace std;
 
 alignas(CACHE_LINE_SIZE) std::vector<Result> SiloResult;
 
-void initResult() { SiloResult.resize(FLAGS_thread_num); }
+void initResult() {
+  SiloResult.clear();
+  SiloResult.resize(FLAGS_thread_num);
+}
@@ -9,13 +9,18 @@
 #include <unistd.h>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <limits>
+#include <thread>
 
 #include "boost/filesystem.hpp"
 
 #define GLOBAL_VALUE_DEFINE
 
 #include "include/atomic_tool.hh"
+#include "include/checkpointer.hh"
 #include "include/common.hh"
+#include "include/logger.hh"
 #include "include/result.hh"
 #include "include/transaction.hh"
 #include "include/util.hh"
@@ -24,45 +29,159 @@
 #include "../include/backoff.hh"
 #include "../include/cpu.hh"
 #include "../include/debug.hh"
+#include "../include/driver.hh"
 #include "../include/fileio.hh"
 #include "../include/masstree_wrapper.hh"
 #include "../include/random.hh"
 #include "../include/result.hh"
+#include "../include/result_export.hh"
+#include "../include/sampler.hh"
+#include "../include/sweep.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
 #include "../include/zipf.hh"
 
 using namespace std;
 
-void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
-  Result &myres = std::ref(SiloResult[thid]);
-  Xoroshiro128Plus rnd;
-  rnd.init();
-  TxnExecutor trans(thid, (Result *) &myres);
-  FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
-  uint64_t epoch_timer_start, epoch_timer_stop;
+/**
+ * @brief Silo engine for the driver.
+ */
+class SiloEngine : public Engine<SiloEngine> {
+public:
+  static constexpr bool kInsert = MASSTREE_USE;
+  static constexpr bool kScan = !HASH_INDEX_USE;
+  static constexpr bool kDelete = MASSTREE_USE;
+
+  SiloEngine(size_t thid, Result &myres)
+          : trans_(thid, &myres), myres_(myres)
+#if BACK_OFF
+          , backoff_(FLAGS_clocks_per_us)
+#endif
+  {
+    epoch_timer_start_ = rdtscp();
+#if WAL
+    trans_.log_buffer_pool_ = SiloLogBufferPools[thid].get();
+#endif
+  }
+
+  std::vector<Procedure> &procedures() { return trans_.pro_set_; }
+
+  INLINE void prepare() {
+#if PROCEDURE_SORT
+    sort(trans_.pro_set_.begin(), trans_.pro_set_.end());
+#endif
+#if WAL
+    txn_start_ = rdtscp();
+#endif
+  }
+
+  INLINE void leaderWork() {
+    ::leaderWork(epoch_timer_start_, epoch_timer_stop_);
 #if BACK_OFF
-  Backoff backoff(FLAGS_clocks_per_us);
+    leaderBackoffWork(backoff_, SiloResult);
+#endif
+  }
+
+  INLINE void begin() { trans_.begin(); }
+
+  INLINE void read(uint64_t key) { trans_.read(key); }
+
+  INLINE void write(uint64_t key) { trans_.write(key); }
+
+  INLINE void insert(uint64_t key) { trans_.insert(key); }
+
+  INLINE void scan(uint64_t key, uint32_t scan_len) {
+    trans_.scan(key, key + scan_len - 1);
+  }
+
+  INLINE void remove(uint64_t key) { trans_.tx_delete(key); }
+
+  INLINE bool aborted() const {
+    return trans_.status_ == TransactionStatus::kAborted;
+  }
+
+  INLINE bool commit() {
+    if (!trans_.validationPhase()) return false;
+    trans_.writePhase();
+    return true;
+  }
+
+  INLINE void abort() {
+    trans_.abort();
+#if WAL
+    ackDurableCommits();
+#endif
+  }
+
+  INLINE void committed() {
+#if WAL
+    /**
+     * The commit is acknowledged after the durable epoch reaches the epoch
+     * of the transaction.
+     */
+    pending_commits_.push(trans_.mrctid_.epoch, txn_start_);
+    ackDurableCommits();
+#endif
+#if MASSTREE_USE
+    trans_.gc_.gcRecord(&myres_);
+#endif
+  }
+
+  INLINE void warmedUp() {
+#if WAL
+    // the commits of warm-up are not acknowledged.
+    pending_commits_.queue_.clear();
+#endif
+  }
+
+  /**
+   * A waiting worker moves to the current epoch, so it holds back neither
+   * the epoch nor the durable epoch.
+   */
+  INLINE void idle() {
+    atomicStoreThLocalEpoch(trans_.thid_, atomicLoadGE());
+#if WAL
+    trans_.log_buffer_pool_->advanceEpoch(atomicLoadGE());
+    ackDurableCommits();
+#endif
+  }
+
+  void finish() {
+#if WAL
+    trans_.log_buffer_pool_->terminate();
+    /**
+     * The last commits are acknowledged when the loggers have written
+     * everything, which makes the durable epoch the max.
+     */
+    while (loadAcquire(DurableEpoch.obj_) !=
+           std::numeric_limits<uint64_t>::max())
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    ackDurableCommits();
 #endif
+  }
 
+private:
 #if WAL
-  /*
-  const boost::filesystem::path log_dir_path("/tmp/ccbench");
-  if (boost::filesystem::exists(log_dir_path)) {
-  } else {
-    boost::system::error_code error;
-    const bool result = boost::filesystem::create_directory(log_dir_path,
-  error); if (!result || error) { ERR;
-    }
+  INLINE void ackDurableCommits() {
+    pending_commits_.ack(loadAcquire(DurableEpoch.obj_), rdtscp(), myres_);
   }
-  std::string logpath("/tmp/ccbench");
-  */
-  std::string logpath;
-  genLogFile(logpath, thid);
-  trans.logfile_.open(logpath, O_CREAT | O_TRUNC | O_WRONLY, 0644);
-  trans.logfile_.ftruncate(10 ^ 9);
 #endif
 
+  TxnExecutor trans_;
+  [[maybe_unused]] Result &myres_;
+  uint64_t epoch_timer_start_, epoch_timer_stop_;
+#if BACK_OFF
+  Backoff backoff_;
+#endif
+#if WAL
+  PendingCommitQueue pending_commits_;
+  uint64_t txn_start_;
+#endif
+};
+
+void worker(size_t thid, Driver &driver) {
+  SiloEngine engine(thid, SiloResult[thid]);
+
 #ifdef Linux
   setThreadAffinity(thid);
   // printf("Thread #%d: on CPU %d\n", res.thid_, sched_getcpu());
@@ -74,97 +193,79 @@ void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
   MasstreeWrapper<Tuple>::thread_init(int(thid));
 #endif
 
-  storeRelease(ready, 1);
-  while (!loadAcquire(start)) _mm_pause();
-  if (thid == 0) epoch_timer_start = rdtscp();
-  while (!loadAcquire(quit)) {
+  driver.work(engine, thid);
+}
+
+/**
+ * @param [in,out] key_space the keys inserted by the previous points of the
+ * sweep are in the table, so it is shared by the points.
+ */
+void run(KeySpace &key_space) {
+  initEpoch();
+  initResult();
 #if PARTITION_TABLE
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope,
-                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, true,
-                  thid, myres);
+  constexpr bool partition = true;
 #else
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope,
-                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false,
-                  thid, myres);
+  constexpr bool partition = false;
 #endif
-
-#if PROCEDURE_SORT
-    sort(trans.pro_set_.begin(), trans.pro_set_.end());
+  Driver driver({FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
+                 FLAGS_rratio, FLAGS_rmw, partition, FLAGS_ycsb,
+                 FLAGS_zipf_skew, FLAGS_arrival_rate, FLAGS_arrival_poisson,
+                 FLAGS_clocks_per_us, FLAGS_trace_record, FLAGS_trace_replay,
+                 YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist,
+                         FLAGS_scan_len)},
+                SiloResult, &key_space);
+#if WAL
+  initLogger();
+  std::vector<std::thread> lthv;
+  for (size_t i = 0; i < FLAGS_logger_num; ++i)
+    lthv.emplace_back(loggerWorker, i);
 #endif
-
-RETRY:
-    if (thid == 0) {
-      leaderWork(epoch_timer_start, epoch_timer_stop);
-#if BACK_OFF
-      leaderBackoffWork(backoff, SiloResult);
-#endif
-      // printf("Thread #%d: on CPU %d\n", thid, sched_getcpu());
-    }
-
-    if (loadAcquire(quit)) break;
-
-    trans.begin();
-    for (auto itr = trans.pro_set_.begin(); itr != trans.pro_set_.end();
-         ++itr) {
-      if ((*itr).ope_ == Ope::READ) {
-        trans.read((*itr).key_);
-      } else if ((*itr).ope_ == Ope::WRITE) {
-        trans.write((*itr).key_);
-      } else if ((*itr).ope_ == Ope::READ_MODIFY_WRITE) {
-        trans.read((*itr).key_);
-        trans.write((*itr).key_);
-      } else {
-        ERR;
-      }
-    }
-
-    if (trans.validationPhase()) {
-      trans.writePhase();
-      /**
-       * local_commit_counts is used at ../include/backoff.hh to calcurate about
-       * backoff.
-       */
-      storeRelease(myres.local_commit_counts_,
-                   loadAcquire(myres.local_commit_counts_) + 1);
-    } else {
-      trans.abort();
-      ++myres.local_abort_counts_;
-      goto RETRY;
-    }
+  std::thread cpth;
+  if (FLAGS_checkpoint_interval != 0) {
+    initCheckpointer();
+    cpth = std::thread(checkpointerWorker, std::ref(driver.start_),
+                       std::ref(driver.quit_));
   }
+  driver.run(worker, FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
+  if (cpth.joinable()) cpth.join();
+#if WAL
+  for (auto &th : lthv) th.join();
+#endif
 
-  return;
+  ShowOptParameters();
+  driver.display(FLAGS_extime);
+#if WAL
+  displayLoggerResult();
+#endif
+  if (FLAGS_checkpoint_interval != 0) displayCheckpointResult();
 }
 
 int main(int argc, char *argv[]) try {
   gflags::SetUsageMessage("Silo benchmark.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  setYcsbZipfSkew(
+          YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len),
+          FLAGS_zipf_skew);
+  ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
+  std::vector<SweepPoint> points = makeSweepPoints(
+          FLAGS_sweep_thread_num, FLAGS_sweep_zipf_skew, FLAGS_sweep_rratio,
+          FLAGS_sweep_max_ope,
+          {FLAGS_thread_num, FLAGS_zipf_skew, FLAGS_rratio, FLAGS_max_ope});
+  // the per-thread arrays are allocated for the largest point.
+  FLAGS_thread_num = maxSweepThreadNum(points);
   chkArg();
   makeDB();
+  KeySpace key_space(FLAGS_tuple_num);
 
-  alignas(CACHE_LINE_SIZE) bool start = false;
-  alignas(CACHE_LINE_SIZE) bool quit = false;
-  initResult();
-  std::vector<char> readys(FLAGS_thread_num);
-  std::vector<std::thread> thv;
-  for (size_t i = 0; i < FLAGS_thread_num; ++i)
-    thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                     std::ref(quit));
-  waitForReady(readys);
-  storeRelease(start, true);
-  for (size_t i = 0; i < FLAGS_extime; ++i) {
-    sleepMs(1000);
+  for (auto &point : points) {
+    FLAGS_thread_num = point.thread_num_;
+    FLAGS_zipf_skew = point.zipf_skew_;
+    FLAGS_rratio = point.rratio_;
+    FLAGS_max_ope = point.max_ope_;
+    run(key_space);
+    result_export.write();
   }
-  storeRelease(quit, true);
-  for (auto &th : thv) th.join();
-
-  for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-    SiloResult[0].addLocalAllResult(SiloResult[i]);
-  }
-  ShowOptParameters();
-  SiloResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime,
-                                 FLAGS_thread_num);
-
   return 0;
 } catch (bad_alloc) {
   ERR;
@@ -8,23 +8,50 @@
 
 extern void displayDB();
 
-TxnExecutor::TxnExecutor(int thid, Result *sres) : thid_(thid), sres_(sres) {
+TxnExecutor::TxnExecutor(int thid, Result *sres)
+        : gc_(thid), thid_(thid), sres_(sres) {
   read_set_.reserve(FLAGS_max_ope);
   write_set_.reserve(FLAGS_max_ope);
   pro_set_.reserve(FLAGS_max_ope);
-  // log_set_.reserve(LOGSET_SIZE);
-
-  // latest_log_header_.init();
 
   max_rset_.obj_ = 0;
   max_wset_.obj_ = 0;
 
-  genStringRepeatedNumber(write_val_, VAL_SIZE, thid);
+  write_val_ = std::make_unique<char[]>(ValueSizes.max());
+  return_val_ = std::make_unique<char[]>(ValueSizes.max());
+  genStringRepeatedNumber(write_val_.get(), ValueSizes.max(), thid);
 }
 
 void TxnExecutor::abort() {
+#if MASSTREE_USE
+  /**
+   * Remove the placeholders. They are marked not latest first, so
+   * transactions which read them abort in the validation phase.
+   */
+  for (auto &we : write_set_) {
+    if (we.op_ != OpType::INSERT) continue;
+    Tidword tidw;
+    tidw.obj_ = loadAcquire(we.rcdptr_->tidword_.obj_);
+    tidw.latest = 0;
+    storeRelease(we.rcdptr_->tidword_.obj_, tidw.obj_);
+    MT.remove_value(we.key_);
+    gc_.retire(we.rcdptr_, atomicLoadGE());
+  }
+#endif
+
   read_set_.clear();
   write_set_.clear();
+#if MASSTREE_USE
+  node_set_.clear();
+#endif
+
+#if WAL
+  /**
+   * The next commit of this worker belongs to the current epoch or later, so
+   * it can let the logger make the older epochs durable while it retries.
+   */
+  log_buffer_pool_->advanceEpoch(atomicLoadGE());
+#endif
 
 #if BACK_OFF
 #if ADD_ANALYSIS
@@ -53,8 +80,50 @@ void TxnExecutor::displayWriteSet() {
   }
 }
 
-void TxnExecutor::insert([[maybe_unused]] std::uint64_t key, [[maybe_unused]] std::string_view val) { // NOLINT
+void TxnExecutor::insert(std::uint64_t key, std::string_view val) { // NOLINT
+#if MASSTREE_USE
+  if (searchWriteSet(key)) return;
+
+  Tuple *tuple = gc_.newRecord(sres_);
+  tuple->allocateVal(ValueSizes.of(key), *SlabAllocators[thid_]);
+  Tidword tidw;
+  tidw.absent = 1;
+  tidw.latest = 1;
+  tuple->tidword_.obj_ = tidw.obj_;
+  if (MT.insert_value(key, tuple, &node_set_)) {
+#if ADD_ANALYSIS
+    ++sres_->local_tree_traversal_;
+#endif
+    write_set_.emplace_back(key, tuple, val, OpType::INSERT);
+    return;
+  }
+  tuple->freeVal(*SlabAllocators[thid_]);
+  gc_.reuse_record_from_gc_.emplace_back(tuple);
 
+  /**
+   * The key exists.
+   */
+  if (searchReadSet(key)) return;
+  tuple = MT.get_value(key);
+  if (tuple != nullptr) {
+    tidw.obj_ = loadAcquire(tuple->tidword_.obj_);
+    if (!tidw.absent) {
+      readRecord(key, tuple);
+      return;
+    }
+  }
+  /**
+   * The other transaction is inserting or deleting it, or it is removed just
+   * now.
+   */
+#if ADD_ANALYSIS
+  ++sres_->local_absent_aborts_;
+#endif
+  status_ = TransactionStatus::kAborted;
+#else
+  // the array table has the fixed keys.
+  ERR;
+#endif
 }
 
 void TxnExecutor::lockWriteSet() {
@@ -92,11 +161,6 @@ void TxnExecutor::read(std::uint64_t key) {
   std::uint64_t start = rdtscp();
 #endif
 
-  // these variable cause error (-fpermissive)
-  // "crosses initialization of ..."
-  // So it locate before first goto instruction.
-  Tidword expected, check;
-
   /**
    * read-own-writes or re-read from local read set.
    */
@@ -107,14 +171,29 @@ void TxnExecutor::read(std::uint64_t key) {
    */
   Tuple *tuple;
 #if MASSTREE_USE
-  tuple = MT.get_value(key);
+  tuple = MT.get_value(key, &node_set_);
 #if ADD_ANALYSIS
   ++sres_->local_tree_traversal_;
 #endif
+  // not found. The node set detects its insert.
+  if (tuple == nullptr) goto FINISH_READ;
 #else
   tuple = get_tuple(Table, key);
 #endif
 
+  readRecord(key, tuple);
+
+FINISH_READ:
+
+#if ADD_ANALYSIS
+  sres_->recordReadLatency(rdtscp() - start);
+#endif
+  return;
+}
+
+void TxnExecutor::readRecord(std::uint64_t key, Tuple *tuple) {
+  Tidword expected, check;
+
   //(a) reads the TID word, spinning until the lock is clear
 
   expected.obj_ = loadAcquire(tuple->tidword_.obj_);
@@ -130,7 +209,11 @@ void TxnExecutor::read(std::uint64_t key) {
     // omit. because this is implemented by single version
 
     //(c) reads the data
-    memcpy(return_val_, tuple->val_, VAL_SIZE);
+    // An absent record (the placeholder of the other insert or a deleted
+    // record) is not found and has no value. It stays in the read set, so the
+    // validation phase aborts if it is published or removed.
+    if (!expected.absent)
+      copyVal(return_val_.get(), tuple->val(), tuple->val_size_);
 
     //(d) performs a memory fence
     // don't need.
@@ -145,23 +228,91 @@ void TxnExecutor::read(std::uint64_t key) {
 #endif
   }
 
-  read_set_.emplace_back(key, tuple, return_val_, expected);
+  read_set_.emplace_back(key, tuple, expected);
   // emplace is often better performance than push_back.
 
 #if SLEEP_READ_PHASE
   sleepTics(SLEEP_READ_PHASE);
 #endif
+}
 
-FINISH_READ:
+void TxnExecutor::scan(std::uint64_t lkey, std::uint64_t rkey) {
+#if ADD_ANALYSIS
+  std::uint64_t start = rdtscp();
+#endif
 
+#if MASSTREE_USE
+  /**
+   * The leaves are recorded in node set, and validationPhase checks that
+   * nothing is inserted into or removed from the range.
+   */
+  scan_buf_.clear();
+  MT.scan(lkey, rkey, scan_buf_, &node_set_);
 #if ADD_ANALYSIS
-  sres_->local_read_latency_ += rdtscp() - start;
+  ++sres_->local_tree_traversal_;
+#endif
+  for (auto &kv : scan_buf_) {
+    if (searchReadSet(kv.first) || searchWriteSet(kv.first)) continue;
+    readRecord(kv.first, kv.second);
+  }
+#else
+  /**
+   * The array has every key in [0, tuple_num) and no other, so there is no
+   * phantom.
+   */
+  if (rkey >= FLAGS_tuple_num) rkey = FLAGS_tuple_num - 1;
+  for (std::uint64_t key = lkey; key <= rkey; ++key) {
+    if (searchReadSet(key) || searchWriteSet(key)) continue;
+    readRecord(key, get_tuple(Table, key));
+  }
+#endif
+
+#if ADD_ANALYSIS
+  sres_->recordReadLatency(rdtscp() - start);
 #endif
-  return;
 }
 
-void tx_delete([[maybe_unused]]std::uint64_t key) {
+void TxnExecutor::tx_delete(std::uint64_t key) {
+  WriteElement<Tuple> *we = searchWriteSet(key);
+  if (we) {
+    if (we->op_ == OpType::UPDATE) we->op_ = OpType::DELETE;
+#if MASSTREE_USE
+    if (we->op_ == OpType::INSERT) {
+      /**
+       * Undo the own insert like abort(), so the key is not found again.
+       * The placeholder is marked not latest first, so transactions which
+       * read it abort in the validation phase.
+       */
+      Tidword tidw;
+      tidw.obj_ = loadAcquire(we->rcdptr_->tidword_.obj_);
+      tidw.latest = 0;
+      storeRelease(we->rcdptr_->tidword_.obj_, tidw.obj_);
+      MT.remove_value(key, &node_set_);
+      gc_.retire(we->rcdptr_, atomicLoadGE());
+      write_set_.erase(write_set_.begin() + (we - write_set_.data()));
+    }
+#endif
+    return;
+  }
+
+#if MASSTREE_USE
+  Tuple *tuple;
+  ReadElement<Tuple> *re = searchReadSet(key);
+  if (re) {
+    tuple = re->rcdptr_;
+  } else {
+    tuple = MT.get_value(key, &node_set_);
+#if ADD_ANALYSIS
+    ++sres_->local_tree_traversal_;
+#endif
+    if (tuple == nullptr) return;
+  }
 
+  write_set_.emplace_back(key, tuple, "", OpType::DELETE);
+#else
+  // the array table has the fixed keys.
+  ERR;
+#endif
 }
 
 ReadElement<Tuple> *TxnExecutor::searchReadSet(std::uint64_t key) {
@@ -216,6 +367,27 @@ bool TxnExecutor::validationPhase() {
   if (this->status_ == TransactionStatus::kAborted) return false;
 #endif
 
+#if MASSTREE_USE
+  /**
+   * A record to update or delete may have been deleted, or be the
+   * placeholder of the other insert.
+   */
+  for (auto &we : write_set_) {
+    if (we.op_ == OpType::INSERT) continue;
+    Tidword tidw;
+    tidw.obj_ = loadAcquire(we.rcdptr_->tidword_.obj_);
+    if (tidw.absent || !tidw.latest) {
+#if ADD_ANALYSIS
+      ++sres_->local_absent_aborts_;
+      sres_->recordValiLatency(rdtscp() - start);
+#endif
+      this->status_ = TransactionStatus::kAborted;
+      unlockWriteSet();
+      return false;
+    }
+  }
+#endif
+
   asm volatile("":: : "memory");
   atomicStoreThLocalEpoch(thid_, atomicLoadGE());
   asm volatile("":: : "memory");
@@ -223,7 +395,8 @@ bool TxnExecutor::validationPhase() {
   /* Phase 2 abort if any condition of below is satisfied.
    * 1. tid of read_set_ changed from it that was got in Read Phase.
    * 2. not latest version
-   * 3. the tuple is locked and it isn't included by its write set.*/
+   * 3. the tuple is locked and it isn't included by its write set.
+   * 4. the node set changed.*/
 
   Tidword check;
   for (auto itr = read_set_.begin(); itr != read_set_.end(); ++itr) {
@@ -232,19 +405,27 @@ bool TxnExecutor::validationPhase() {
     if ((*itr).get_tidword().epoch != check.epoch ||
         (*itr).get_tidword().tid != check.tid) {
 #if ADD_ANALYSIS
-      sres_->local_vali_latency_ += rdtscp() - start;
+      sres_->recordValiLatency(rdtscp() - start);
 #endif
       this->status_ = TransactionStatus::kAborted;
       unlockWriteSet();
       return false;
     }
     // 2
-    // if (!check.latest) return false;
+    // a removed record or placeholder.
+    if (!check.latest) {
+#if ADD_ANALYSIS
+      sres_->recordValiLatency(rdtscp() - start);
+#endif
+      this->status_ = TransactionStatus::kAborted;
+      unlockWriteSet();
+      return false;
+    }
 
     // 3
     if (check.lock && !searchWriteSet((*itr).key_)) {
 #if ADD_ANALYSIS
-      sres_->local_vali_latency_ += rdtscp() - start;
+      sres_->recordValiLatency(rdtscp() - start);
 #endif
       this->status_ = TransactionStatus::kAborted;
       unlockWriteSet();
@@ -253,41 +434,30 @@ bool TxnExecutor::validationPhase() {
     max_rset_ = std::max(max_rset_, check);
   }
 
+#if MASSTREE_USE
+  // 4. a leaf visited by a scan changed, which may be a phantom.
+  if (!decltype(MT)::validate_node_set(node_set_)) {
+#if ADD_ANALYSIS
+    sres_->recordValiLatency(rdtscp() - start);
+#endif
+    this->status_ = TransactionStatus::kAborted;
+    unlockWriteSet();
+    return false;
+  }
+#endif
+
   // goto Phase 3
 #if ADD_ANALYSIS
-  sres_->local_vali_latency_ += rdtscp() - start;
+  sres_->recordValiLatency(rdtscp() - start);
 #endif
   this->status_ = TransactionStatus::kCommitted;
   return true;
 }
 
 void TxnExecutor::wal(std::uint64_t ctid) {
-  for (auto itr = write_set_.begin(); itr != write_set_.end(); ++itr) {
-    LogRecord log(ctid, (*itr).key_, write_val_);
-    log_set_.emplace_back(log);
-    latest_log_header_.chkSum_ += log.computeChkSum();
-    ++latest_log_header_.logRecNum_;
-  }
-
-  if (log_set_.size() > LOGSET_SIZE / 2) {
-    // prepare write header
-    latest_log_header_.convertChkSumIntoComplementOnTwo();
-
-    // write header
-    logfile_.write((void *) &latest_log_header_, sizeof(LogHeader));
-
-    // write log record
-    // for (auto itr = log_set_.begin(); itr != log_set_.end(); ++itr)
-    //  logfile_.write((void *)&(*itr), sizeof(LogRecord));
-    logfile_.write((void *) &(log_set_[0]),
-                   sizeof(LogRecord) * latest_log_header_.logRecNum_);
-
-    // logfile_.fdatasync();
-
-    // clear for next transactions.
-    latest_log_header_.init();
-    log_set_.clear();
-  }
+  Tidword tidw;
+  tidw.obj_ = ctid;
+  log_buffer_pool_->add(ctid, tidw.epoch, write_set_, write_val_.get());
 }
 
 void TxnExecutor::write(std::uint64_t key, std::string_view val) {
@@ -307,10 +477,12 @@ void TxnExecutor::write(std::uint64_t key, std::string_view val) {
     tuple = re->rcdptr_;
   } else {
 #if MASSTREE_USE
-    tuple = MT.get_value(key);
+    tuple = MT.get_value(key, &node_set_);
 #if ADD_ANALYSIS
     ++sres_->local_tree_traversal_;
 #endif
+    // not found. The node set detects its insert.
+    if (tuple == nullptr) goto FINISH_WRITE;
 #else
     tuple = get_tuple(Table, key);
 #endif
@@ -321,7 +493,7 @@ void TxnExecutor::write(std::uint64_t key, std::string_view val) {
 FINISH_WRITE:
 
 #if ADD_ANALYSIS
-  sres_->local_write_latency_ += rdtscp() - start;
+  sres_->recordWriteLatency(rdtscp() - start);
 #endif
   return;
 }
@@ -351,6 +523,8 @@ void TxnExecutor::writePhase() {
   Tidword maxtid = std::max({tid_a, tid_b, tid_c});
   maxtid.lock = 0;
   maxtid.latest = 1;
+  // the tid of a placeholder in the write set has it.
+  maxtid.absent = 0;
   mrctid_ = maxtid;
 
 #if WAL
@@ -359,17 +533,40 @@ void TxnExecutor::writePhase() {
 
   // write(record, commit-tid)
   for (auto itr = write_set_.begin(); itr != write_set_.end(); ++itr) {
-    // update and unlock
+#if MASSTREE_USE
+    if ((*itr).op_ == OpType::DELETE) {
+      // remove and unlock. It is not the latest record of the key anymore.
+      MT.remove_value((*itr).key_);
+      Tidword tidw = maxtid;
+      tidw.absent = 1;
+      tidw.latest = 0;
+      storeRelease((*itr).rcdptr_->tidword_.obj_, tidw.obj_);
+      gc_.retire((*itr).rcdptr_, atomicLoadGE());
+#if ADD_ANALYSIS
+      ++sres_->local_delete_counts_;
+#endif
+      continue;
+    }
+#if ADD_ANALYSIS
+    if ((*itr).op_ == OpType::INSERT) ++sres_->local_insert_counts_;
+#endif
+#endif
+    // update or publish the insert, and unlock
+    Tuple *tuple = (*itr).rcdptr_;
     if ((*itr).get_val_length() == 0) {
       // fast approach for benchmark
-      memcpy((*itr).rcdptr_->val_, write_val_, VAL_SIZE);
+      copyVal(tuple->val(), write_val_.get(), tuple->val_size_);
     } else {
-      memcpy((*itr).rcdptr_->val_, (*itr).get_val_ptr(), (*itr).get_val_length());
+      memcpy(tuple->val(), (*itr).get_val_ptr(),
+             std::min<std::size_t>((*itr).get_val_length(), tuple->val_size_));
     }
     storeRelease((*itr).rcdptr_->tidword_.obj_, maxtid.obj_);
   }
 
   read_set_.clear();
   write_set_.clear();
+#if MASSTREE_USE
+  node_set_.clear();
+#endif
 }
 
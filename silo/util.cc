@@ -4,6 +4,7 @@
 #include <sys/types.h>  // syscall(SYS_gettid),
 #include <unistd.h>     // syscall(SYS_gettid),
 
+#include <algorithm>
 #include <bitset>
 #include <cstdint>
 #include <fstream>
@@ -25,8 +26,10 @@
 #include "../include/masstree_wrapper.hh"
 #include "../include/procedure.hh"
 #include "../include/random.hh"
+#include "../include/snapshot.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
+#include "../include/ycsb.hh"
 #include "../include/zipf.hh"
 
 void chkArg() {
@@ -41,6 +44,28 @@ void chkArg() {
     ERR;
   }
 
+  ValueSizes = ValueSize(FLAGS_val_size, FLAGS_val_size_dist);
+  // log records and checkpoints have values of VAL_SIZE bytes.
+  if ((WAL || FLAGS_checkpoint_interval != 0) &&
+      !(ValueSizes.fixed() && FLAGS_val_size == VAL_SIZE)) {
+    cout << "WAL and checkpoints need the fixed val_size of VAL_SIZE." << endl;
+    ERR;
+  }
+  // log records, checkpoints and recovery cover the records of Table only.
+  const YcsbMix mix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len);
+  if ((WAL || FLAGS_checkpoint_interval != 0) &&
+      (mix.insert_ != 0 || mix.delete_ != 0)) {
+    cout << "WAL and checkpoints do not support the insert and delete of "
+            "ycsb_workload." << endl;
+    ERR;
+  }
+  // a snapshot is the image of Table, which has no pointer to a value.
+  if (!FLAGS_snapshot.empty() && ValueSizes.max() > Tuple::kInlineValSize) {
+    cout << "snapshot needs values up to " << Tuple::kInlineValSize
+         << " bytes." << endl;
+    ERR;
+  }
+
   if (posix_memalign((void **) &ThLocalEpoch, CACHE_LINE_SIZE,
                      FLAGS_thread_num * sizeof(uint64_t_64byte)) != 0)
     ERR;
@@ -66,13 +91,20 @@ bool chkEpochLoaded() {
   return true;
 }
 
+void initEpoch() {
+  // GlobalEpoch is kept across the points of a sweep, because the TIDs of the
+  // records contain it.
+  for (unsigned int i = 0; i < FLAGS_thread_num; ++i)
+    atomicStoreThLocalEpoch(i, atomicLoadGE());
+}
+
 void displayDB() {
   Tuple *tuple;
   for (unsigned int i = 0; i < FLAGS_tuple_num; ++i) {
     tuple = &Table[i];
     cout << "------------------------------" << endl;  //-は30個
     cout << "key: " << i << endl;
-    cout << "val: " << tuple->val_ << endl;
+    cout << "val: " << tuple->val() << endl;
     cout << "TIDword: " << tuple->tidword_.obj_ << endl;
     cout << "bit: " << tuple->tidword_.obj_ << endl;
     cout << endl;
@@ -80,15 +112,41 @@ void displayDB() {
 }
 
 void displayParameter() {
+  cout << "#FLAGS_arrival_poisson:\t" << FLAGS_arrival_poisson << endl;
+  cout << "#FLAGS_arrival_rate:\t" << FLAGS_arrival_rate << endl;
+  cout << "#FLAGS_buffer_num:\t" << FLAGS_buffer_num << endl;
+  cout << "#FLAGS_buffer_size:\t" << FLAGS_buffer_size << endl;
+  cout << "#FLAGS_checkpoint_interval:\t" << FLAGS_checkpoint_interval << endl;
+  cout << "#FLAGS_checkpoint_thread_num:\t" << FLAGS_checkpoint_thread_num
+       << endl;
   cout << "#FLAGS_clocks_per_us:\t" << FLAGS_clocks_per_us << endl;
   cout << "#FLAGS_epoch_time:\t" << FLAGS_epoch_time << endl;
   cout << "#FLAGS_extime:\t\t" << FLAGS_extime << endl;
+  cout << "#FLAGS_logger_num:\t" << FLAGS_logger_num << endl;
   cout << "#FLAGS_max_ope:\t\t" << FLAGS_max_ope << endl;
+  cout << "#FLAGS_request_dist:\t" << FLAGS_request_dist << endl;
+  cout << "#FLAGS_result_file:\t" << FLAGS_result_file << endl;
+  cout << "#FLAGS_result_format:\t" << FLAGS_result_format << endl;
   cout << "#FLAGS_rmw:\t\t" << FLAGS_rmw << endl;
   cout << "#FLAGS_rratio:\t\t" << FLAGS_rratio << endl;
+  cout << "#FLAGS_sample_interval:\t" << FLAGS_sample_interval << endl;
+  cout << "#FLAGS_scan_len:\t" << FLAGS_scan_len << endl;
+  cout << "#FLAGS_snapshot:\t" << FLAGS_snapshot << endl;
+  cout << "#FLAGS_snapshot_hugepage:\t" << FLAGS_snapshot_hugepage << endl;
+  cout << "#FLAGS_snapshot_populate:\t" << FLAGS_snapshot_populate << endl;
+  cout << "#FLAGS_sweep_max_ope:\t" << FLAGS_sweep_max_ope << endl;
+  cout << "#FLAGS_sweep_rratio:\t" << FLAGS_sweep_rratio << endl;
+  cout << "#FLAGS_sweep_thread_num:\t" << FLAGS_sweep_thread_num << endl;
+  cout << "#FLAGS_sweep_zipf_skew:\t" << FLAGS_sweep_zipf_skew << endl;
   cout << "#FLAGS_thread_num:\t" << FLAGS_thread_num << endl;
+  cout << "#FLAGS_trace_record:\t" << FLAGS_trace_record << endl;
+  cout << "#FLAGS_trace_replay:\t" << FLAGS_trace_replay << endl;
   cout << "#FLAGS_tuple_num:\t" << FLAGS_tuple_num << endl;
+  cout << "#FLAGS_val_size:\t" << FLAGS_val_size << endl;
+  cout << "#FLAGS_val_size_dist:\t" << FLAGS_val_size_dist << endl;
+  cout << "#FLAGS_warmup:\t\t" << FLAGS_warmup << endl;
   cout << "#FLAGS_ycsb:\t\t" << FLAGS_ycsb << endl;
+  cout << "#FLAGS_ycsb_workload:\t" << FLAGS_ycsb_workload << endl;
   cout << "#FLAGS_zipf_skew:\t" << FLAGS_zipf_skew << endl;
 }
 
@@ -97,19 +155,27 @@ void genLogFile(std::string &logpath, const int thid) {
   createEmptyFile(logpath);
 }
 
-void partTableInit([[maybe_unused]] size_t thid, uint64_t start, uint64_t end) {
+void makeSlabAllocators(size_t num) {
+  while (SlabAllocators.size() < num)
+    SlabAllocators.emplace_back(std::make_unique<SlabAllocator>());
+}
+
+void partTableInit(size_t thid, uint64_t start, uint64_t end) {
 #if MASSTREE_USE
   MasstreeWrapper<Tuple>::thread_init(thid);
 #endif
 
+  SlabAllocator &slab = *SlabAllocators[thid];
   for (auto i = start; i <= end; ++i) {
     Tuple *tmp;
     tmp = &Table[i];
+    tmp->tidword_.obj_ = 0;
     tmp->tidword_.epoch = 1;
     tmp->tidword_.latest = 1;
     tmp->tidword_.lock = 0;
-    tmp->val_[0] = 'a';
-    tmp->val_[1] = '\0';
+    tmp->allocateVal(ValueSizes.of(i), slab);
+    tmp->val()[0] = 'a';
+    if (tmp->val_size_ > 1) tmp->val()[1] = '\0';
 
 #if MASSTREE_USE
     MT.insert_value(i, tmp);
@@ -117,7 +183,38 @@ void partTableInit([[maybe_unused]] size_t thid, uint64_t start, uint64_t end) {
   }
 }
 
+#if MASSTREE_USE
+static void partIndexInit(size_t thid, uint64_t start, uint64_t end) {
+  MasstreeWrapper<Tuple>::thread_init(thid);
+  for (auto i = start; i <= end; ++i) MT.insert_value(i, &Table[i]);
+}
+#endif
+
 void makeDB() {
+#if MASSTREE_USE
+  MT.reserve(FLAGS_tuple_num);
+#endif
+  makeSlabAllocators(std::max<size_t>(
+          decideParallelBuildNumber(FLAGS_tuple_num), FLAGS_thread_num));
+
+  if (!FLAGS_snapshot.empty()) {
+    Table = loadTableSnapshot<Tuple>(FLAGS_snapshot, FLAGS_tuple_num,
+                                     FLAGS_snapshot_populate,
+                                     FLAGS_snapshot_hugepage);
+    if (Table != nullptr) {
+#if MASSTREE_USE
+      // masstree consists of pointers, so it is rebuilt on the mapped table.
+      size_t maxthread = decideParallelBuildNumber(FLAGS_tuple_num);
+      std::vector<std::thread> thv;
+      for (size_t i = 0; i < maxthread; ++i)
+        thv.emplace_back(partIndexInit, i, i * (FLAGS_tuple_num / maxthread),
+                         (i + 1) * (FLAGS_tuple_num / maxthread) - 1);
+      for (auto &th : thv) th.join();
+#endif
+      return;
+    }
+  }
+
   if (posix_memalign((void **) &Table, PAGE_SIZE,
                      (FLAGS_tuple_num) * sizeof(Tuple)) != 0)
     ERR;
@@ -134,6 +231,9 @@ void makeDB() {
     thv.emplace_back(partTableInit, i, i * (FLAGS_tuple_num / maxthread),
                      (i + 1) * (FLAGS_tuple_num / maxthread) - 1);
   for (auto &th : thv) th.join();
+
+  if (!FLAGS_snapshot.empty())
+    writeTableSnapshot(FLAGS_snapshot, Table, FLAGS_tuple_num);
 }
 
 void leaderWork(uint64_t &epoch_timer_start, uint64_t &epoch_timer_stop) {
@@ -149,7 +249,8 @@ void leaderWork(uint64_t &epoch_timer_start, uint64_t &epoch_timer_stop) {
 void ShowOptParameters() {
   cout << "#ShowOptParameters()"
        << ": ADD_ANALYSIS " << ADD_ANALYSIS << ": BACK_OFF " << BACK_OFF
-       << ": KEY_SIZE " << KEY_SIZE << ": MASSTREE_USE " << MASSTREE_USE
+       << ": KEY_SIZE " << KEY_SIZE << ": HASH_INDEX_USE " << HASH_INDEX_USE
+       << ": MASSTREE_USE " << MASSTREE_USE
        << ": NO_WAIT_LOCKING_IN_VALIDATION " << NO_WAIT_LOCKING_IN_VALIDATION
        << ": PARTITION_TABLE " << PARTITION_TABLE << ": PROCEDURE_SORT "
        << PROCEDURE_SORT << ": SLEEP_READ_PHASE " << SLEEP_READ_PHASE
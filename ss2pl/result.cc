@@ -8,4 +8,7 @@ using namespace std;
 
 alignas(CACHE_LINE_SIZE) std::vector<Result> SS2PLResult;
 
-void initResult() { SS2PLResult.resize(FLAGS_thread_num); }
+void initResult() {
+  SS2PLResult.clear();
+  SS2PLResult.resize(FLAGS_thread_num);
+}
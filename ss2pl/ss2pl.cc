@@ -17,12 +17,16 @@
 #include "../include/backoff.hh"
 #include "../include/cpu.hh"
 #include "../include/debug.hh"
+#include "../include/driver.hh"
 #include "../include/fence.hh"
 #include "../include/int64byte.hh"
 #include "../include/masstree_wrapper.hh"
 #include "../include/procedure.hh"
 #include "../include/random.hh"
 #include "../include/result.hh"
+#include "../include/result_export.hh"
+#include "../include/sampler.hh"
+#include "../include/sweep.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
 #include "../include/zipf.hh"
@@ -31,13 +35,44 @@
 #include "include/transaction.hh"
 #include "include/util.hh"
 
-void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
-  Result &myres = std::ref(SS2PLResult[thid]);
-  Xoroshiro128Plus rnd;
-  rnd.init();
-  TxExecutor trans(thid, (Result *) &myres);
-  FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
-  Backoff backoff(FLAGS_clocks_per_us);
+/**
+ * @brief SS2PL engine for the driver.
+ */
+class SS2PLEngine : public Engine<SS2PLEngine> {
+public:
+  SS2PLEngine(size_t thid, Result &myres)
+          : trans_(thid, &myres), backoff_(FLAGS_clocks_per_us) {}
+
+  std::vector<Procedure> &procedures() { return trans_.pro_set_; }
+
+  INLINE void leaderWork() { leaderBackoffWork(backoff_, SS2PLResult); }
+
+  INLINE void begin() { trans_.begin(); }
+
+  INLINE void read(uint64_t key) { trans_.read(key); }
+
+  INLINE void write(uint64_t key) { trans_.write(key); }
+
+  INLINE void readWrite(uint64_t key) { trans_.readWrite(key); }
+
+  INLINE bool aborted() const {
+    return trans_.status_ == TransactionStatus::aborted;
+  }
+
+  INLINE bool commit() {
+    trans_.commit();
+    return true;
+  }
+
+  INLINE void abort() { trans_.abort(); }
+
+private:
+  TxExecutor trans_;
+  Backoff backoff_;
+};
+
+void worker(size_t thid, Driver &driver) {
+  SS2PLEngine engine(thid, SS2PLResult[thid]);
 
 #if MASSTREE_USE
   MasstreeWrapper<Tuple>::thread_init(int(thid));
@@ -50,74 +85,46 @@ void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
   // sysconf(_SC_NPROCESSORS_CONF));
 #endif  // Linux
 
-  storeRelease(ready, 1);
-  while (!loadAcquire(start)) _mm_pause();
-  while (!loadAcquire(quit)) {
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
-                  FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false, thid, myres);
-RETRY:
-    if (loadAcquire(quit)) break;
-    if (thid == 0) leaderBackoffWork(backoff, SS2PLResult);
-
-    trans.begin();
-    for (auto itr = trans.pro_set_.begin(); itr != trans.pro_set_.end();
-         ++itr) {
-      if ((*itr).ope_ == Ope::READ) {
-        trans.read((*itr).key_);
-      } else if ((*itr).ope_ == Ope::WRITE) {
-        trans.write((*itr).key_);
-      } else if ((*itr).ope_ == Ope::READ_MODIFY_WRITE) {
-        trans.readWrite((*itr).key_);
-      } else {
-        ERR;
-      }
-
-      if (trans.status_ == TransactionStatus::aborted) {
-        trans.abort();
-        goto RETRY;
-      }
-    }
-
-    trans.commit();
-    /**
-     * local_commit_counts is used at ../include/backoff.hh to calcurate about
-     * backoff.
-     */
-    storeRelease(myres.local_commit_counts_,
-                 loadAcquire(myres.local_commit_counts_) + 1);
-  }
+  driver.work(engine, thid);
+}
 
-  return;
+void run() {
+  initResult();
+  Driver driver({FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
+                 FLAGS_rratio, FLAGS_rmw, false, FLAGS_ycsb, FLAGS_zipf_skew,
+                 FLAGS_arrival_rate, FLAGS_arrival_poisson,
+                 FLAGS_clocks_per_us, FLAGS_trace_record, FLAGS_trace_replay,
+                 YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist,
+                         FLAGS_scan_len)},
+                SS2PLResult);
+  driver.run(worker, FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
+
+  ShowOptParameters();
+  driver.display(FLAGS_extime);
 }
 
 int main(int argc, char *argv[]) try {
   gflags::SetUsageMessage("2PL benchmark.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  setYcsbZipfSkew(
+          YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len),
+          FLAGS_zipf_skew);
+  ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
+  std::vector<SweepPoint> points = makeSweepPoints(
+          FLAGS_sweep_thread_num, FLAGS_sweep_zipf_skew, FLAGS_sweep_rratio,
+          FLAGS_sweep_max_ope,
+          {FLAGS_thread_num, FLAGS_zipf_skew, FLAGS_rratio, FLAGS_max_ope});
   chkArg();
   makeDB();
 
-  alignas(CACHE_LINE_SIZE) bool start = false;
-  alignas(CACHE_LINE_SIZE) bool quit = false;
-  initResult();
-  std::vector<char> readys(FLAGS_thread_num);
-  std::vector<std::thread> thv;
-  for (size_t i = 0; i < FLAGS_thread_num; ++i)
-    thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                     std::ref(quit));
-  waitForReady(readys);
-  storeRelease(start, true);
-  for (size_t i = 0; i < FLAGS_extime; ++i) {
-    sleepMs(1000);
-  }
-  storeRelease(quit, true);
-  for (auto &th : thv) th.join();
-
-  for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-    SS2PLResult[0].addLocalAllResult(SS2PLResult[i]);
+  for (auto &point : points) {
+    FLAGS_thread_num = point.thread_num_;
+    FLAGS_zipf_skew = point.zipf_skew_;
+    FLAGS_rratio = point.rratio_;
+    FLAGS_max_ope = point.max_ope_;
+    run();
+    result_export.write();
   }
-  ShowOptParameters();
-  SS2PLResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime, FLAGS_thread_num);
-
   return 0;
 } catch (bad_alloc) {
   ERR;
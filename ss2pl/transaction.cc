@@ -65,8 +65,6 @@ void TxExecutor::abort() {
   read_set_.clear();
   write_set_.clear();
 
-  ++sres_->local_abort_counts_;
-
 #if BACK_OFF
 #if ADD_ANALYSIS
   uint64_t start(rdtscp());
@@ -162,7 +160,7 @@ void TxExecutor::read(uint64_t key) {
 FINISH_READ:
 
 #if ADD_ANALYSIS
-  sres_->local_read_latency_ += rdtscp() - start;
+  sres_->recordReadLatency(rdtscp() - start);
 #endif
   return;
 }
@@ -244,7 +242,7 @@ void TxExecutor::write(uint64_t key) {
 
 FINISH_WRITE:
 #if ADD_ANALYSIS
-  sres_->local_write_latency_ += rdtscp() - start;
+  sres_->recordWriteLatency(rdtscp() - start);
 #endif  // ADD_ANALYSIS
   return;
 }
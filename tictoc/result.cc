@@ -8,4 +8,7 @@ using namespace std;
 
 alignas(CACHE_LINE_SIZE) std::vector<Result> TicTocResult;
 
-void initResult() { TicTocResult.resize(FLAGS_thread_num); }
+void initResult() {
+  TicTocResult.clear();
+  TicTocResult.resize(FLAGS_thread_num);
+}
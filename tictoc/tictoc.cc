@@ -18,9 +18,13 @@
 #include "../include/backoff.hh"
 #include "../include/cpu.hh"
 #include "../include/debug.hh"
+#include "../include/driver.hh"
 #include "../include/masstree_wrapper.hh"
 #include "../include/random.hh"
 #include "../include/result.hh"
+#include "../include/result_export.hh"
+#include "../include/sampler.hh"
+#include "../include/sweep.hh"
 #include "../include/tsc.hh"
 #include "../include/util.hh"
 #include "../include/zipf.hh"
@@ -29,18 +33,53 @@
 #include "include/transaction.hh"
 #include "include/util.hh"
 
-void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
-  Xoroshiro128Plus rnd;
-  rnd.init();
+/**
+ * @brief TicToc engine for the driver.
+ */
+class TicTocEngine : public Engine<TicTocEngine> {
+public:
+  TicTocEngine(size_t thid, Result &myres)
+          : trans_(thid, &myres)
+#if BACK_OFF
+          , backoff_(FLAGS_clocks_per_us)
+#endif
+  {}
+
+  std::vector<Procedure> &procedures() { return trans_.pro_set_; }
+
+  INLINE void leaderWork() {
+#if BACK_OFF
+    leaderBackoffWork(backoff_, TicTocResult);
+#endif
+  }
 
-  FastZipf zipf(&rnd, FLAGS_zipf_skew, FLAGS_tuple_num);
+  INLINE void begin() { trans_.begin(); }
+
+  INLINE void read(uint64_t key) { trans_.read(key); }
+
+  INLINE void write(uint64_t key) { trans_.write(key); }
+
+  INLINE bool aborted() const {
+    return trans_.status_ == TransactionStatus::aborted;
+  }
+
+  INLINE bool commit() {
+    if (!trans_.validationPhase()) return false;
+    trans_.writePhase();
+    return true;
+  }
 
-  Result &myres = std::ref(TicTocResult[thid]);
-  TxExecutor trans(thid, (Result *) &TicTocResult[thid]);
+  INLINE void abort() { trans_.abort(); }
 
+private:
+  TxExecutor trans_;
 #if BACK_OFF
-  Backoff backoff(FLAGS_clocks_per_us);
+  Backoff backoff_;
 #endif
+};
+
+void worker(size_t thid, Driver &driver) {
+  TicTocEngine engine(thid, TicTocResult[thid]);
 
 #if MASSTREE_USE
   MasstreeWrapper<Tuple>::thread_init(int(thid));
@@ -56,84 +95,46 @@ void worker(size_t thid, char &ready, const bool &start, const bool &quit) {
   // sysconf(_SC_NPROCESSORS_CONF));
 #endif
 
-  storeRelease(ready, 1);
-  while (!loadAcquire(start)) _mm_pause();
-  while (!loadAcquire(quit)) {
-    makeProcedure(trans.pro_set_, rnd, zipf, FLAGS_tuple_num, FLAGS_max_ope,
-                  FLAGS_thread_num, FLAGS_rratio, FLAGS_rmw, FLAGS_ycsb, false,
-                  thid, myres);
-RETRY:
-#if BACK_OFF
-    if (thid == 0) leaderBackoffWork(std::ref(backoff), TicTocResult);
-#endif
-    if (loadAcquire(quit)) break;
-
-    trans.begin();
-    for (auto itr = trans.pro_set_.begin(); itr != trans.pro_set_.end();
-         ++itr) {
-      if ((*itr).ope_ == Ope::READ) {
-        trans.read((*itr).key_);
-      } else if ((*itr).ope_ == Ope::WRITE) {
-        trans.write((*itr).key_);
-      } else if ((*itr).ope_ == Ope::READ_MODIFY_WRITE) {
-        trans.read((*itr).key_);
-        trans.write((*itr).key_);
-      } else {
-        ERR;
-      }
-
-      if (trans.status_ == TransactionStatus::aborted) {
-        trans.abort();
-        goto RETRY;
-      }
-    }
-
-    if (trans.validationPhase()) {
-      trans.writePhase();
-      /**
-       * local_commit_counts is used at ../include/backoff.hh to calcurate about
-       * backoff.
-       */
-      storeRelease(myres.local_commit_counts_,
-                   loadAcquire(myres.local_commit_counts_) + 1);
-    } else {
-      trans.abort();
-      goto RETRY;
-    }
-  }
+  driver.work(engine, thid);
+}
+
+void run() {
+  initResult();
+  Driver driver({FLAGS_tuple_num, FLAGS_max_ope, FLAGS_thread_num,
+                 FLAGS_rratio, FLAGS_rmw, false, FLAGS_ycsb, FLAGS_zipf_skew,
+                 FLAGS_arrival_rate, FLAGS_arrival_poisson,
+                 FLAGS_clocks_per_us, FLAGS_trace_record, FLAGS_trace_replay,
+                 YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist,
+                         FLAGS_scan_len)},
+                TicTocResult);
+  driver.run(worker, FLAGS_warmup, FLAGS_extime, FLAGS_sample_interval);
 
-  return;
+  ShowOptParameters();
+  driver.display(FLAGS_extime);
 }
 
 int main(int argc, char *argv[]) try {
   gflags::SetUsageMessage("TicToc benchmark.");
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  setYcsbZipfSkew(
+          YcsbMix(FLAGS_ycsb_workload, FLAGS_request_dist, FLAGS_scan_len),
+          FLAGS_zipf_skew);
+  ResultExport result_export(FLAGS_result_format, FLAGS_result_file);
+  std::vector<SweepPoint> points = makeSweepPoints(
+          FLAGS_sweep_thread_num, FLAGS_sweep_zipf_skew, FLAGS_sweep_rratio,
+          FLAGS_sweep_max_ope,
+          {FLAGS_thread_num, FLAGS_zipf_skew, FLAGS_rratio, FLAGS_max_ope});
   chkArg();
   makeDB();
 
-  alignas(CACHE_LINE_SIZE) bool start = false;
-  alignas(CACHE_LINE_SIZE) bool quit = false;
-  initResult();
-  std::vector<char> readys(FLAGS_thread_num);
-  std::vector<std::thread> thv;
-  for (size_t i = 0; i < FLAGS_thread_num; ++i)
-    thv.emplace_back(worker, i, std::ref(readys[i]), std::ref(start),
-                     std::ref(quit));
-  waitForReady(readys);
-  storeRelease(start, true);
-  for (size_t i = 0; i < FLAGS_extime; ++i) {
-    sleepMs(1000);
-  }
-  storeRelease(quit, true);
-  for (auto &th : thv) th.join();
-
-  for (unsigned int i = 0; i < FLAGS_thread_num; ++i) {
-    TicTocResult[0].addLocalAllResult(TicTocResult[i]);
+  for (auto &point : points) {
+    FLAGS_thread_num = point.thread_num_;
+    FLAGS_zipf_skew = point.zipf_skew_;
+    FLAGS_rratio = point.rratio_;
+    FLAGS_max_ope = point.max_ope_;
+    run();
+    result_export.write();
   }
-  ShowOptParameters();
-  TicTocResult[0].displayAllResult(FLAGS_clocks_per_us, FLAGS_extime,
-                                   FLAGS_thread_num);
-
   return 0;
 } catch (bad_alloc) {
   ERR;
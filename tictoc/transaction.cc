@@ -136,7 +136,7 @@ void TxExecutor::read(uint64_t key) {
 FINISH_READ:
 
 #if ADD_ANALYSIS
-  tres_->local_read_latency_ += rdtscp() - start;
+  tres_->recordReadLatency(rdtscp() - start);
 #endif
   return;
 }
@@ -179,7 +179,7 @@ void TxExecutor::write(uint64_t key) {
 FINISH_WRITE:;
 
 #if ADD_ANALYSIS
-  tres_->local_write_latency_ += rdtscp() - start;
+  tres_->recordWriteLatency(rdtscp() - start);
 #endif
 }
 
@@ -192,7 +192,7 @@ bool TxExecutor::validationPhase() {
 #if NO_WAIT_LOCKING_IN_VALIDATION
   if (this->status_ == TransactionStatus::aborted) {
 #if ADD_ANALYSIS
-    tres_->local_vali_latency_ += rdtscp() - start;
+    tres_->recordValiLatency(rdtscp() - start);
 #endif
     return false;
   }
@@ -252,7 +252,7 @@ bool TxExecutor::validationPhase() {
 #endif
           // end timestamp history processing
 #if ADD_ANALYSIS
-          tres_->local_vali_latency_ += rdtscp() - start;
+          tres_->recordValiLatency(rdtscp() - start);
 #endif
           unlockWriteSet();
           return false;
@@ -267,7 +267,7 @@ bool TxExecutor::validationPhase() {
              * so other transaction locked.
              */
 #if ADD_ANALYSIS
-            tres_->local_vali_latency_ += rdtscp() - start;
+            tres_->recordValiLatency(rdtscp() - start);
 #endif
             unlockWriteSet();
             return false;
@@ -303,7 +303,7 @@ bool TxExecutor::validationPhase() {
     }
   }
 #if ADD_ANALYSIS
-  tres_->local_vali_latency_ += rdtscp() - start;
+  tres_->recordValiLatency(rdtscp() - start);
 #endif
   return true;
 }
@@ -315,8 +315,6 @@ void TxExecutor::abort() {
   read_set_.clear();
   write_set_.clear();
 
-  ++tres_->local_abort_counts_;
-
 #if BACK_OFF
 
 #if ADD_ANALYSIS
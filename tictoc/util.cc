@@ -17,6 +17,7 @@
 #include "../include/debug.hh"
 #include "../include/inline.hh"
 #include "../include/random.hh"
+#include "../include/snapshot.hh"
 #include "../include/result.hh"
 #include "../include/zipf.hh"
 #include "include/common.hh"
@@ -57,14 +58,32 @@ void displayDB() {
 }
 
 void displayParameter() {
+  cout << "#FLAGS_arrival_poisson:\t" << FLAGS_arrival_poisson << endl;
+  cout << "#FLAGS_arrival_rate:\t" << FLAGS_arrival_rate << endl;
   cout << "#FLAGS_clocks_per_us:\t" << FLAGS_clocks_per_us << endl;
   cout << "#FLAGS_extime:\t\t" << FLAGS_extime << endl;
   cout << "#FLAGS_max_ope:\t\t" << FLAGS_max_ope << endl;
+  cout << "#FLAGS_request_dist:\t" << FLAGS_request_dist << endl;
+  cout << "#FLAGS_result_file:\t" << FLAGS_result_file << endl;
+  cout << "#FLAGS_result_format:\t" << FLAGS_result_format << endl;
   cout << "#FLAGS_rmw:\t\t" << FLAGS_rmw << endl;
   cout << "#FLAGS_rratio:\t\t" << FLAGS_rratio << endl;
+  cout << "#FLAGS_sample_interval:\t" << FLAGS_sample_interval << endl;
+  cout << "#FLAGS_scan_len:\t" << FLAGS_scan_len << endl;
+  cout << "#FLAGS_snapshot:\t" << FLAGS_snapshot << endl;
+  cout << "#FLAGS_snapshot_hugepage:\t" << FLAGS_snapshot_hugepage << endl;
+  cout << "#FLAGS_snapshot_populate:\t" << FLAGS_snapshot_populate << endl;
+  cout << "#FLAGS_sweep_max_ope:\t" << FLAGS_sweep_max_ope << endl;
+  cout << "#FLAGS_sweep_rratio:\t" << FLAGS_sweep_rratio << endl;
+  cout << "#FLAGS_sweep_thread_num:\t" << FLAGS_sweep_thread_num << endl;
+  cout << "#FLAGS_sweep_zipf_skew:\t" << FLAGS_sweep_zipf_skew << endl;
   cout << "#FLAGS_thread_num:\t" << FLAGS_thread_num << endl;
+  cout << "#FLAGS_trace_record:\t" << FLAGS_trace_record << endl;
+  cout << "#FLAGS_trace_replay:\t" << FLAGS_trace_replay << endl;
   cout << "#FLAGS_tuple_num:\t" << FLAGS_tuple_num << endl;
+  cout << "#FLAGS_warmup:\t\t" << FLAGS_warmup << endl;
   cout << "#FLAGS_ycsb:\t\t" << FLAGS_ycsb << endl;
+  cout << "#FLAGS_ycsb_workload:\t" << FLAGS_ycsb_workload << endl;
   cout << "#FLAGS_zipf_skew:\t" << FLAGS_zipf_skew << endl;
 }
 
@@ -89,7 +108,8 @@ void partTableInit([[maybe_unused]] size_t thid, uint64_t start, uint64_t end) {
 void ShowOptParameters() {
   cout << "#ShowOptParameters()"
        << ": ADD_ANALYSIS " << ADD_ANALYSIS << ": BACK_OFF " << BACK_OFF
-       << ": KEY_SIZE " << KEY_SIZE << ": MASSTREE_USE " << MASSTREE_USE
+       << ": KEY_SIZE " << KEY_SIZE << ": HASH_INDEX_USE " << HASH_INDEX_USE
+       << ": MASSTREE_USE " << MASSTREE_USE
        << ": NO_WAIT_OF_TICTOC " << NO_WAIT_OF_TICTOC
        << ": NO_WAIT_LOCKING_IN_VALIDATION " << NO_WAIT_LOCKING_IN_VALIDATION
        << ": PREEMPTIVE_ABORTS " << PREEMPTIVE_ABORTS << ": SLEEP_READ_PHASE "
@@ -97,7 +117,35 @@ void ShowOptParameters() {
        << ": VAL_SIZE " << VAL_SIZE << endl;
 }
 
+#if MASSTREE_USE
+static void partIndexInit(size_t thid, uint64_t start, uint64_t end) {
+  MasstreeWrapper<Tuple>::thread_init(thid);
+  for (auto i = start; i <= end; ++i) MT.insert_value(i, &Table[i]);
+}
+#endif
+
 void makeDB() {
+#if MASSTREE_USE
+  MT.reserve(FLAGS_tuple_num);
+#endif
+  if (!FLAGS_snapshot.empty()) {
+    Table = loadTableSnapshot<Tuple>(FLAGS_snapshot, FLAGS_tuple_num,
+                                     FLAGS_snapshot_populate,
+                                     FLAGS_snapshot_hugepage);
+    if (Table != nullptr) {
+#if MASSTREE_USE
+      // masstree consists of pointers, so it is rebuilt on the mapped table.
+      size_t maxthread = decideParallelBuildNumber(FLAGS_tuple_num);
+      std::vector<std::thread> thv;
+      for (size_t i = 0; i < maxthread; ++i)
+        thv.emplace_back(partIndexInit, i, i * (FLAGS_tuple_num / maxthread),
+                         (i + 1) * (FLAGS_tuple_num / maxthread) - 1);
+      for (auto &th : thv) th.join();
+#endif
+      return;
+    }
+  }
+
   if (posix_memalign((void **) &Table, PAGE_SIZE,
                      (FLAGS_tuple_num) * sizeof(Tuple)) != 0)
     ERR;
@@ -114,4 +162,7 @@ void makeDB() {
     thv.emplace_back(partTableInit, i, i * (FLAGS_tuple_num / maxthread),
                      (i + 1) * (FLAGS_tuple_num / maxthread) - 1);
   for (auto &th : thv) th.join();
+
+  if (!FLAGS_snapshot.empty())
+    writeTableSnapshot(FLAGS_snapshot, Table, FLAGS_tuple_num);
 }
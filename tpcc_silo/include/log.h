@@ -9,6 +9,8 @@
 
 #include <cstdint>
 #include <cstring>
+#include <string>
+#include <string_view>
 
 #include "fileio.h"
 #include "interface.h"
@@ -70,17 +72,22 @@ public:
   public:
     LogRecord() = default;
 
-    LogRecord(const tid_word &tid, const OP_TYPE op, const Tuple *const tuple)
-            : tid_(tid), op_(op), tuple_(tuple) {}
+    LogRecord(const tid_word &tid, const OP_TYPE op, const Storage st,
+              const Tuple *const tuple)
+            : tid_(tid), op_(op), st_(st), tuple_(tuple) {}
 
     bool operator<(const LogRecord &right) {  // NOLINT
       return this->tid_ < right.tid_;
     }
 
     /**
-     * @brief Compute checksum.
+     * @brief Serializes this record at the tail of the buffer.
+     * @details The format is tid_word | OP_TYPE | Storage | key_length | key |
+     * value_length | value_align | value. The value body of DELETE is omitted
+     * and its value_length is 0.
+     * @return the checksum of the appended bytes.
      */
-    unsigned int compute_checksum();  // NOLINT
+    unsigned int serialize(std::string &buf) const;  // NOLINT
 
     tid_word &get_tid() { return tid_; }  // NOLINT
 
@@ -96,11 +103,14 @@ public:
       return op_;
     }
 
+    [[nodiscard]] Storage get_st() const { return st_; }  // NOLINT
+
     [[maybe_unused]] void set_tuple(Tuple *tuple) { this->tuple_ = tuple; }
 
   private:
     tid_word tid_{};
     OP_TYPE op_{OP_TYPE::NONE};
+    Storage st_{};
     const Tuple *tuple_{nullptr};
   };
 
@@ -112,7 +122,29 @@ public:
     kLogDirectory.assign(new_directory);
   }
 
-  [[maybe_unused]] static void single_recovery_from_log();
+  /**
+   * @brief Computes the checksum of serialized bytes.
+   */
+  static unsigned int compute_checksum(std::string_view bytes);  // NOLINT
+
+  /**
+   * @brief Writes the header and the serialized records to the file.
+   * @details It initializes the header and clears the buffer after writing.
+   */
+  static void write_log(File &file, LogHeader &header, std::string &buf);
+
+  /**
+   * @brief Recovery by multiple threads.
+   * @details Log files are mapped into the memory and decoded by @a thread_num
+   * threads. Records are partitioned by storage and key, and each thread
+   * installs the latest version of its keys into masstree directly. This
+   * function isn't thread safe.
+   * @pre It must decide correct wal directory name by set_kLogDirectory before
+   * it executes recovery.
+   * @return the number of records installed into masstree.
+   */
+  [[maybe_unused]] static std::size_t recovery_from_log(  // NOLINT
+          std::size_t thread_num);
 
 private:
   static inline std::string kLogDirectory{};  // NOLINT
@@ -105,7 +105,9 @@ public:
 
   class log_handler {
   public:
-    std::vector<Log::LogRecord> &get_log_set() { return log_set_; }  // NOLINT
+    std::string &get_log_buf() { return log_buf_; }  // NOLINT
+
+    std::string &get_log_dir() { return log_dir_; }  // NOLINT
 
     File &get_log_file() { return log_file_; }  // NOLINT
 
@@ -118,7 +120,10 @@ public:
   private:
     std::string log_dir_{};
     File log_file_{};
-    std::vector<Log::LogRecord> log_set_{};
+    /**
+     * @brief serialized log records which aren't written yet.
+     */
+    std::string log_buf_{};
     Log::LogHeader latest_log_header_{};
   };
 
@@ -187,8 +192,8 @@ public:
     return scan_handle_.get_len_rkey();
   }
 
-  std::vector<Log::LogRecord> &get_log_set() {  // NOLINT
-    return log_handle_.get_log_set();
+  log_handler &get_log_handle() {  // NOLINT
+    return log_handle_;
   }
 
   tid_word &get_mrctid() { return mrc_tid_; }  // NOLINT
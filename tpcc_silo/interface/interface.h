@@ -290,12 +290,15 @@ Status search_key(Token token, Storage storage,  // NOLINT
                          std::string_view key, Tuple **tuple);
 
 /**
- * @brief Recovery by single thread.
- * @details This function isn't thread safe.
+ * @brief Recovery by multiple threads.
+ * @details It installs the latest version of each key in log files into
+ * masstree directly. This function isn't thread safe.
+ * @param[in] thread_num the number of threads for recovery.
  * @pre It must decide correct wal directory name decided by
  * change_wal_directory function before it executes recovery.
+ * @return the number of recovered records.
  */
-[[maybe_unused]] void single_recovery_from_log();
+[[maybe_unused]] std::size_t recovery_from_log(std::size_t thread_num);
 
 /**
  * @brief update the record for the given key
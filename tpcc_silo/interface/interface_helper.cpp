@@ -61,12 +61,16 @@ Status init(__attribute__((unused)) std::string_view log_directory_path) {  // N
   /**
    * If it already exists log files, it recoveries from those.
    */
-  // single_recovery_from_log();
+  // recovery_from_log(KVS_NUMBER_OF_LOGICAL_CORES);
   session_info_table::init_kThreadTable();
   epoch::invoke_epocher();
   return Status::OK;
 }
 
+[[maybe_unused]] std::size_t recovery_from_log(std::size_t thread_num) {  // NOLINT
+  return Log::recovery_from_log(thread_num);
+}
+
 Status leave(Token token) {  // NOLINT
   for (auto &&itr : session_info_table::get_thread_info_table()) {
     if (&itr == static_cast<session_info *>(token)) {
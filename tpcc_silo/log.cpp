@@ -5,6 +5,19 @@
 
 #include "log.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "index/masstree_beta/include/masstree_beta_wrapper.h"
+
 namespace ccbench {
 
 void Log::LogHeader::init() {
@@ -33,149 +46,314 @@ void Log::LogHeader::set_checksum(unsigned int checksum) {
   this->checksum_ = checksum;
 }
 
-unsigned int Log::LogRecord::compute_checksum() {  // NOLINT
-  // compute checksum
-  // tid_word
-  unsigned int chkSum = 0;
-  const char *charitr = reinterpret_cast<char *>(this);  // NOLINT
-  for (std::size_t i = 0; i < sizeof(tid_word); ++i) {
-    chkSum += (*charitr);
-    ++charitr;  // NOLINT
+namespace {
+
+template<typename T>
+void append_bytes(std::string &buf, const T &obj) {
+  buf.append(reinterpret_cast<const char *>(&obj), sizeof(T));  // NOLINT
+}
+
+/**
+ * @brief Reader of serialized bytes in a mapped log file.
+ * @details Every read checks the boundary, so a torn tail is detected.
+ */
+class LogReader {
+public:
+  LogReader(const char *begin, const char *end) : pos_(begin), end_(end) {}
+
+  template<typename T>
+  bool read(T &obj) {
+    if (static_cast<std::size_t>(end_ - pos_) < sizeof(T)) return false;
+    ::memcpy(static_cast<void *>(&obj), pos_, sizeof(T));
+    pos_ += sizeof(T);  // NOLINT
+    return true;
   }
 
-  // OP_TYPE
-  chkSum += static_cast<decltype(chkSum)>(op_);
+  bool read_view(std::string_view &view, std::size_t len) {
+    if (static_cast<std::size_t>(end_ - pos_) < len) return false;
+    view = std::string_view(pos_, len);
+    pos_ += len;  // NOLINT
+    return true;
+  }
 
-  // key_length
-  std::string_view key_view = tuple_->get_key();
-  std::size_t key_length = key_view.size();
-  charitr = reinterpret_cast<char *>(&(key_length));  // NOLINT
-  for (std::size_t i = 0; i < sizeof(std::size_t); ++i) {
-    chkSum += (*charitr);
-    ++charitr;  // NOLINT
+  [[nodiscard]] const char *get_pos() const { return pos_; }  // NOLINT
+
+private:
+  const char *pos_;
+  const char *end_;
+};
+
+/**
+ * @brief Log record decoded from a mapped log file.
+ * @details key_ and val_ point into the mapping, so it doesn't copy them.
+ */
+class DecodedLogRecord {
+public:
+  tid_word tid_{};
+  OP_TYPE op_{OP_TYPE::NONE};
+  Storage st_{};
+  std::string_view key_{};
+  std::string_view val_{};
+  std::align_val_t val_align_{};
+};
+
+/**
+ * @brief Log file mapped into the memory.
+ */
+class MappedLogFile {
+public:
+  explicit MappedLogFile(std::string path) : path_(std::move(path)) {}
+
+  MappedLogFile(const MappedLogFile &) = delete;
+
+  MappedLogFile &operator=(const MappedLogFile &) = delete;
+
+  ~MappedLogFile() {
+    if (addr_ != nullptr) ::munmap(addr_, size_);
+    if (fd_ >= 0) ::close(fd_);
   }
 
-  // key_body
-  charitr = key_view.data();
-  for (std::size_t i = 0; i < key_view.size(); ++i) {
-    chkSum += (*charitr);
-    ++charitr;  // NOLINT
+  void map() {
+    fd_ = ::open(path_.c_str(), O_RDONLY);  // NOLINT
+    if (fd_ < 0) throw LibcError(errno, "open failed: ");  // NOLINT
+    struct stat st {};
+    if (::fstat(fd_, &st) < 0) throw LibcError(errno, "fstat failed: ");  // NOLINT
+    size_ = st.st_size;
+    if (size_ == 0) return;
+    void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE | MAP_POPULATE,  // NOLINT
+                        fd_, 0);
+    if (addr == MAP_FAILED) throw LibcError(errno, "mmap failed: ");  // NOLINT
+    addr_ = static_cast<char *>(addr);
+    ::madvise(addr_, size_, MADV_SEQUENTIAL);
   }
 
-  // value_length
-  std::string_view value_view = tuple_->get_val();
-  std::size_t value_length = value_view.size();
-  charitr = reinterpret_cast<char *>(&(value_length));  // NOLINT
-  for (std::size_t i = 0; i < sizeof(std::size_t); ++i) {
-    chkSum += (*charitr);
-    ++charitr;  // NOLINT
+  /**
+   * @brief decode blocks from the head of the file.
+   * @details It stops at the first block which is torn or whose checksum is
+   * broken, because the following blocks aren't durable.
+   */
+  void decode() {
+    const char *const end = addr_ + size_;  // NOLINT
+    LogReader reader(addr_, end);
+    std::vector<DecodedLogRecord> block;
+    for (;;) {
+      const char *block_begin = reader.get_pos();
+      Log::LogHeader header{};
+      if (!reader.read(header)) return;
+      block.clear();
+      for (unsigned int i = 0; i < header.get_log_rec_num(); ++i) {
+        DecodedLogRecord rec{};
+        std::size_t key_length{};
+        std::size_t value_length{};
+        std::size_t value_align{};
+        if (!reader.read(rec.tid_) || !reader.read(rec.op_) ||
+            !reader.read(rec.st_) || !reader.read(key_length) ||
+            !reader.read_view(rec.key_, key_length) ||
+            !reader.read(value_length) || !reader.read(value_align) ||
+            !reader.read_view(rec.val_, value_length) ||
+            static_cast<std::uint32_t>(rec.st_) >=
+            static_cast<std::uint32_t>(Storage::SECONDARY) + 1) {
+          return;
+        }
+        rec.val_align_ = static_cast<std::align_val_t>(value_align);
+        block.emplace_back(rec);
+      }
+      const char *records_begin = block_begin + sizeof(Log::LogHeader);  // NOLINT
+      if (header.get_checksum() +
+          Log::compute_checksum(std::string_view(
+                  records_begin,
+                  static_cast<std::size_t>(reader.get_pos() - records_begin))) !=
+          0) {
+        ++broken_blocks_;
+        return;
+      }
+      byte_count_ += static_cast<std::size_t>(reader.get_pos() - block_begin);
+      for (auto &&rec : block) {
+        max_epoch_ = std::max(max_epoch_, rec.tid_.get_epoch());
+        records_.emplace_back(rec);
+      }
+    }
   }
 
-  // value_body
-  charitr = value_view.data();
-  for (std::size_t i = 0; i < value_view.size(); ++i) {
-    chkSum += (*charitr);
-    ++charitr;  // NOLINT
+  std::vector<DecodedLogRecord> &get_records() { return records_; }  // NOLINT
+
+  [[nodiscard]] epoch::epoch_t get_max_epoch() const {  // NOLINT
+    return max_epoch_;
+  }
+
+private:
+  std::string path_;
+  int fd_{-1};
+  char *addr_{nullptr};
+  std::size_t size_{0};
+  std::vector<DecodedLogRecord> records_{};
+  epoch::epoch_t max_epoch_{0};
+  std::size_t byte_count_{0};
+  std::size_t broken_blocks_{0};
+};
+
+template<typename Func>
+void run_parallel(std::size_t thread_num, Func func) {
+  std::vector<std::thread> thv;
+  thv.reserve(thread_num);
+  for (std::size_t i = 0; i < thread_num; ++i) thv.emplace_back(func, i);
+  for (auto &&th : thv) th.join();
+}
+
+/**
+ * @brief Installs the record into masstree without the transaction interface.
+ * @return true if the key exists after this call.
+ */
+bool install_record(const DecodedLogRecord &rec) {
+  auto *rec_ptr = static_cast<Record *>(kohler_masstree::find_record(rec.st_, rec.key_));  // NOLINT
+  if (rec.op_ == OP_TYPE::DELETE) {
+    if (rec_ptr != nullptr) {
+      kohler_masstree::get_mtdb(rec.st_).remove_value(rec.key_.data(),
+                                                       rec.key_.size());
+      delete rec_ptr;  // NOLINT
+    }
+    return false;
+  }
+  if (rec_ptr != nullptr) {
+    rec_ptr->get_tuple() = Tuple(rec.key_, rec.val_, rec.val_align_);
+  } else {
+    rec_ptr = new Record(Tuple(rec.key_, rec.val_, rec.val_align_));  // NOLINT
+    rec_ptr->set_for_load();
+    if (kohler_masstree::insert_record(rec.st_, rec.key_, rec_ptr) != Status::OK) {
+      // only the owner of the partition inserts this key.
+      std::abort();
+    }
   }
+  tid_word tidw = rec.tid_;
+  tidw.set_lock(false);
+  tidw.set_absent(false);
+  tidw.set_latest(true);
+  rec_ptr->set_tidw(tidw);
+  return true;
+}
+
+}  // namespace
+
+unsigned int Log::LogRecord::serialize(std::string &buf) const {  // NOLINT
+  const std::size_t begin = buf.size();
+
+  append_bytes(buf, tid_);
+  append_bytes(buf, op_);
+  append_bytes(buf, st_);
+
+  std::string_view key_view = tuple_->get_key();
+  append_bytes(buf, key_view.size());
+  buf.append(key_view);
+
+  std::string_view value_view{};
+  if (op_ != OP_TYPE::DELETE) value_view = tuple_->get_val();
+  append_bytes(buf, value_view.size());
+  append_bytes(buf, static_cast<std::size_t>(tuple_->get_val_align()));
+  buf.append(value_view);
 
+  return compute_checksum(std::string_view(buf).substr(begin));
+}
+
+unsigned int Log::compute_checksum(std::string_view bytes) {  // NOLINT
+  unsigned int chkSum = 0;
+  for (char c : bytes) chkSum += c;
   return chkSum;
 }
 
-[[maybe_unused]] void Log::single_recovery_from_log() {
-  std::vector<LogRecord> log_set;
+void Log::write_log(File &file, LogHeader &header, std::string &buf) {
+  header.compute_two_complement_of_checksum();
+  file.write(static_cast<void *>(&header), sizeof(LogHeader));
+  file.write(static_cast<const void *>(buf.data()), buf.size());
+  header.init();
+  buf.clear();
+}
+
+[[maybe_unused]] std::size_t Log::recovery_from_log(std::size_t thread_num) {  // NOLINT
+  if (thread_num == 0) thread_num = 1;
+
+  std::vector<std::unique_ptr<MappedLogFile>> files;
   for (auto i = 0; i < KVS_MAX_PARALLEL_THREADS; ++i) {
-    File logfile{};
     std::string filename(kLogDirectory);
     filename.append("/log");
     filename.append(std::to_string(i));
-    if (!logfile.try_open(filename, O_RDONLY)) {
+    struct stat st {};
+    if (::stat(filename.c_str(), &st) != 0) {
       /**
        * the file doesn't exist.
        */
       continue;
     }
+    files.emplace_back(std::make_unique<MappedLogFile>(filename));
+  }
 
-    LogRecord log{};
-    LogHeader log_header{};
-    std::vector<Tuple> tuple_buffer;
-
-    const std::size_t fix_size = sizeof(tid_word) + sizeof(OP_TYPE);
-    while (sizeof(LogHeader) ==
-           logfile.read(reinterpret_cast<void *>(&log_header),  // NOLINT
-                        sizeof(LogHeader))) {
-      std::vector<LogRecord> log_tmp_buf;
-      for (unsigned int j = 0; j < log_header.get_log_rec_num(); ++j) {
-        if (fix_size != logfile.read(static_cast<void *>(&log), fix_size)) break;
-        std::unique_ptr<char[]> key_ptr;    // NOLINT
-        std::unique_ptr<char[]> value_ptr;  // NOLINT
-        std::size_t key_length{};
-        std::size_t value_length{};
-        // read key_length
-        if (sizeof(std::size_t) != logfile.read(static_cast<void *>(&key_length),
-                                                sizeof(std::size_t))) {
-          break;
-        }
-        // read key_body
-        if (key_length > 0) {
-          key_ptr = std::make_unique<char[]>(key_length);  // NOLINT
-          if (key_length !=
-              logfile.read(static_cast<void *>(key_ptr.get()), key_length)) {
-            break;
-          }
-        }
-        // read value_length
-        if (sizeof(std::size_t) !=
-            logfile.read(static_cast<void *>(&value_length),
-                         sizeof(std::size_t))) {
-          break;
-        }
-        // read value_body
-        if (value_length > 0) {
-          value_ptr = std::make_unique<char[]>(value_length);  // NOLINT
-          if (value_length !=
-              logfile.read(static_cast<void *>(value_ptr.get()), value_length)) {
-            break;
-          }
-        }
+  /**
+   * If no log files exist, it return.
+   */
+  if (files.empty()) return 0;
 
-        log_header.set_checksum(log_header.get_checksum() +
-                                log.compute_checksum());
-        log_tmp_buf.emplace_back(std::move(log));
-      }
-      if (log_header.get_checksum() == 0) {
-        for (auto &&itr : log_tmp_buf) {
-          log_set.emplace_back(std::move(itr));
-        }
-      } else {
-        break;
-      }
+  // map and decode log files in parallel.
+  run_parallel(thread_num, [&](std::size_t thid) {
+    for (std::size_t i = thid; i < files.size(); i += thread_num) {
+      files[i]->map();
+      files[i]->decode();
     }
+  });
 
-    logfile.close();
+  epoch::epoch_t max_epoch = 0;
+  for (auto &&file : files) {
+    max_epoch = std::max(max_epoch, file->get_max_epoch());
   }
+  /**
+   * The latest two epochs may not be durable in all log files.
+   */
+  if (max_epoch <= 2) return 0;
+  const epoch::epoch_t recovery_epoch = max_epoch - 2;
 
   /**
-   * If no log files exist, it return.
+   * Partition records by storage and key. buckets[thid][part] is written only
+   * by thid, and refers the mapped bytes without copying.
    */
-  if (log_set.empty()) return;
-
-  sort(log_set.begin(), log_set.end());
-  const epoch::epoch_t recovery_epoch =
-          log_set.back().get_tid().get_epoch() - 2;
-
-  Token s{};
-  Storage st{};
-  enter(s);
-  for (auto &&itr : log_set) {
-    if (itr.get_tid().get_epoch() > recovery_epoch) break;
-    if (itr.get_op() == OP_TYPE::UPDATE || itr.get_op() == OP_TYPE::INSERT) {
-      upsert(s, st, itr.get_tuple()->get_key(), itr.get_tuple()->get_val(), itr.get_tuple()->get_val_align());
-    } else if (itr.get_op() == OP_TYPE::DELETE) {
-      delete_record(s, st, itr.get_tuple()->get_key());
+  std::vector<std::vector<std::vector<const DecodedLogRecord *>>> buckets(
+          thread_num,
+          std::vector<std::vector<const DecodedLogRecord *>>(thread_num));
+  run_parallel(thread_num, [&](std::size_t thid) {
+    for (std::size_t i = thid; i < files.size(); i += thread_num) {
+      for (auto &&rec : files[i]->get_records()) {
+        if (rec.tid_.get_epoch() > recovery_epoch) continue;
+        std::size_t hash = std::hash<std::string_view>{}(rec.key_) ^
+                           static_cast<std::size_t>(rec.st_);
+        buckets[thid][hash % thread_num].emplace_back(&rec);
+      }
     }
-    commit(s);
-  }
-  leave(s);
+  });
+
+  // each thread installs the latest version of the keys in its partition.
+  std::vector<std::size_t> installed(thread_num);
+  run_parallel(thread_num, [&](std::size_t part) {
+    masstree_wrapper<Record>::thread_init(static_cast<int>(part));
+    std::vector<const DecodedLogRecord *> recs;
+    for (std::size_t i = 0; i < thread_num; ++i) {
+      recs.insert(recs.end(), buckets[i][part].begin(), buckets[i][part].end());
+    }
+    std::sort(recs.begin(), recs.end(),
+              [](const DecodedLogRecord *a, const DecodedLogRecord *b) {
+                if (a->st_ != b->st_) return a->st_ < b->st_;
+                if (a->key_ != b->key_) return a->key_ < b->key_;
+                return a->tid_ < b->tid_;
+              });
+    for (std::size_t i = 0; i < recs.size(); ++i) {
+      if (i + 1 < recs.size() && recs[i]->st_ == recs[i + 1]->st_ &&
+          recs[i]->key_ == recs[i + 1]->key_) {
+        // it is not the latest version.
+        continue;
+      }
+      if (install_record(*recs[i])) ++installed[part];
+    }
+  });
+
+  std::size_t installed_sum = 0;
+  for (auto &&n : installed) installed_sum += n;
+  return installed_sum;
 }
 
 }  // namespace ccbench
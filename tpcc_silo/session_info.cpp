@@ -194,77 +194,29 @@ void session_info::unlock_write_set(  // NOLINT
 
 void session_info::wal(uint64_t commit_id) {
   for (auto &&itr : write_set) {
+    const Tuple *tupleptr{};
     if (itr.get_op() == OP_TYPE::UPDATE) {
-      log_handle_.get_log_set().emplace_back(commit_id, itr.get_op(),
-                                             &itr.get_tuple_to_local());
+      tupleptr = &itr.get_tuple_to_local();
     } else {
       // insert/delete
-      log_handle_.get_log_set().emplace_back(commit_id, itr.get_op(),
-                                             &itr.get_tuple_to_db());
+      tupleptr = &itr.get_tuple_to_db();
     }
+    Log::LogRecord log(commit_id, itr.get_op(), itr.get_st(), tupleptr);
     log_handle_.get_latest_log_header().add_checksum(
-            log_handle_.get_log_set().back().compute_checksum());  // NOLINT
+            static_cast<int>(log.serialize(log_handle_.get_log_buf())));
     log_handle_.get_latest_log_header().inc_log_rec_num();
   }
 
   /**
-   * This part includes many write system call.
-   * Future work: if this degrades the system performance, it should prepare
-   * some buffer (like char*) and do memcpy instead of write system call
-   * and do write system call in a batch.
+   * Records are serialized into the buffer, so the write set can be released
+   * after commit. The buffer is written by one write system call.
    */
-  if (log_handle_.get_log_set().size() > KVS_LOG_GC_THRESHOLD) {
-    // prepare write header
-    log_handle_.get_latest_log_header().compute_two_complement_of_checksum();
-
-    // write header
-    log_handle_.get_log_file().write(
-            static_cast<void *>(&log_handle_.get_latest_log_header()),
-            sizeof(Log::LogHeader));
-
-    // write log record
-    for (auto &&itr : log_handle_.get_log_set()) {
-      // write tx id, op(operation type)
-      log_handle_.get_log_file().write(
-              static_cast<void *>(&itr),
-              sizeof(itr.get_tid()) + sizeof(itr.get_op()));
-
-      // common subexpression elimination
-      const Tuple *tupleptr = itr.get_tuple();
-
-      std::string_view key_view = tupleptr->get_key();
-      // write key_length
-      // key_view.size() returns constexpr.
-      std::size_t key_size = key_view.size();
-      log_handle_.get_log_file().write(static_cast<void *>(&key_size),
-                                       sizeof(key_size));
-
-      // write key_body
-      log_handle_.get_log_file().write(
-              static_cast<const void *>(key_view.data()),
-              key_size);  // NOLINT
-
-      std::string_view value_view = tupleptr->get_val();
-      // write value_length
-      // value_view.size() returns constexpr.
-      std::size_t value_size = value_view.size();
-      log_handle_.get_log_file().write(
-              static_cast<const void *>(value_view.data()),
-              value_size);  // NOLINT
-
-      // write val_body
-      if (itr.get_op() != OP_TYPE::DELETE) {
-        if (value_size != 0) {
-          log_handle_.get_log_file().write(
-                  static_cast<const void *>(value_view.data()),
-                  value_size);  // NOLINT
-        }
-      }
-    }
+  if (log_handle_.get_latest_log_header().get_log_rec_num() >
+      KVS_LOG_GC_THRESHOLD) {
+    Log::write_log(log_handle_.get_log_file(),
+                   log_handle_.get_latest_log_header(),
+                   log_handle_.get_log_buf());
   }
-
-  log_handle_.get_latest_log_header().init();
-  log_handle_.get_log_set().clear();
 }
 
 }  // namespace ccbench
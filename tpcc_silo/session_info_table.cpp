@@ -47,15 +47,15 @@ void session_info_table::init_kThreadTable() {
      * about logging.
      */
 #ifdef WAL
-    itr->log_dir_.assign(kLogDirectory);
-    itr->log_dir_.append("/log");
-    itr->log_dir_.append(std::to_string(ctr));
-    if (!itr->log_file_.open(itr->log_dir_, O_CREAT | O_TRUNC | O_WRONLY,
-                             0644)) {
-      ERR;
-    }
-    // itr->log_file_.ftruncate(10^9); // if it want to be high performance in
-    // experiments, this line is used.
+    std::string &log_dir = itr.get_log_handle().get_log_dir();
+    log_dir.assign(Log::get_kLogDirectory());
+    log_dir.append("/log");
+    log_dir.append(std::to_string(ctr));
+    itr.get_log_handle().get_log_file().open(log_dir,
+                                             O_CREAT | O_TRUNC | O_WRONLY,
+                                             0644);
+    // itr.get_log_handle().get_log_file().ftruncate(10^9); // if it want to be
+    // high performance in experiments, this line is used.
 #endif
     ++ctr;
   }
@@ -76,10 +76,16 @@ void session_info_table::fin_kThreadTable() {
     /**
      * about logging
      */
-    itr.get_log_set().clear();
 #ifdef WAL
-    itr->log_file_.close();
+    if (itr.get_log_handle().get_latest_log_header().get_log_rec_num() > 0) {
+      Log::write_log(itr.get_log_handle().get_log_file(),
+                     itr.get_log_handle().get_latest_log_header(),
+                     itr.get_log_handle().get_log_buf());
+    }
+    itr.get_log_handle().get_log_file().close();
 #endif
+    itr.get_log_handle().get_log_buf().clear();
+    itr.get_log_handle().get_latest_log_header().init();
   }
 }
 
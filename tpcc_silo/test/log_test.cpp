@@ -0,0 +1,120 @@
+#include <string>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+#include "gtest/gtest.h"
+#include "interface.h"
+#include "log.h"
+#include "masstree_beta_wrapper.h"
+
+namespace ccbench::testing {
+
+using namespace ccbench;
+
+class log_test : public ::testing::Test {
+public:
+  void SetUp() override {
+    init();
+    log_dir_ = boost::filesystem::temp_directory_path() /
+               boost::filesystem::unique_path();
+    boost::filesystem::create_directories(log_dir_);
+    Log::set_kLogDirectory(log_dir_.string());
+  }
+
+  void TearDown() override {
+    fin();
+    boost::filesystem::remove_all(log_dir_);
+  }
+
+  /**
+   * @brief write one block per element of @a blocks to log<id>.
+   */
+  void write_log_file(std::size_t id,
+                      const std::vector<std::vector<Log::LogRecord>> &blocks) {
+    File file{};
+    file.open(log_dir_.string() + "/log" + std::to_string(id),
+              O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    Log::LogHeader header{};
+    header.init();
+    std::string buf;
+    for (auto &&block : blocks) {
+      for (auto &&rec : block) {
+        header.add_checksum(static_cast<int>(rec.serialize(buf)));
+        header.inc_log_rec_num();
+      }
+      Log::write_log(file, header, buf);
+    }
+  }
+
+  static tid_word make_tid(epoch::epoch_t epoch, std::uint64_t tid) {
+    tid_word tidw;
+    tidw.set_epoch(epoch);
+    tidw.set_tid(tid);
+    return tidw;
+  }
+
+  static std::string_view get_val(Storage st, std::string_view key) {
+    auto *rec_ptr = static_cast<Record *>(kohler_masstree::find_record(st, key));
+    if (rec_ptr == nullptr) return {};
+    return rec_ptr->get_tuple().get_val();
+  }
+
+private:
+  boost::filesystem::path log_dir_;
+};
+
+TEST_F(log_test, recovery_test) {  // NOLINT
+  const auto align = static_cast<std::align_val_t>(alignof(std::string));
+  Tuple a1("a", "a1", align);
+  Tuple a2("a", "a2", align);
+  Tuple b1("b", "b1", align);
+  Tuple c1("c", "c1", align);
+  Tuple d1("d", "d1", align);
+  write_log_file(0, {{{make_tid(1, 1), OP_TYPE::INSERT, Storage::CUSTOMER, &a1},
+                      {make_tid(1, 1), OP_TYPE::INSERT, Storage::STOCK, &b1}},
+                     {{make_tid(3, 1), OP_TYPE::UPDATE, Storage::CUSTOMER, &a2}},
+                     {{make_tid(5, 1), OP_TYPE::INSERT, Storage::ITEM, &d1}}});
+  write_log_file(1, {{{make_tid(2, 1), OP_TYPE::INSERT, Storage::CUSTOMER, &c1}},
+                     {{make_tid(3, 2), OP_TYPE::DELETE, Storage::CUSTOMER, &c1}}});
+
+  /**
+   * The records of epoch 4 and 5 aren't recovered, because the latest two
+   * epochs may not be durable.
+   */
+  ASSERT_EQ(Log::recovery_from_log(2), 2U);
+  ASSERT_EQ(get_val(Storage::CUSTOMER, "a"), "a2");
+  ASSERT_EQ(get_val(Storage::STOCK, "b"), "b1");
+  ASSERT_EQ(kohler_masstree::find_record(Storage::CUSTOMER, "b"), nullptr);
+  ASSERT_EQ(kohler_masstree::find_record(Storage::CUSTOMER, "c"), nullptr);
+  ASSERT_EQ(kohler_masstree::find_record(Storage::ITEM, "d"), nullptr);
+}
+
+TEST_F(log_test, broken_block_test) {  // NOLINT
+  const auto align = static_cast<std::align_val_t>(alignof(std::string));
+  Tuple a1("a", "a1", align);
+  Tuple a2("a", "a2", align);
+  Tuple b1("b", "b1", align);
+  write_log_file(0, {{{make_tid(1, 1), OP_TYPE::INSERT, Storage::CUSTOMER, &a1}},
+                     {{make_tid(2, 1), OP_TYPE::UPDATE, Storage::CUSTOMER, &a2}},
+                     {{make_tid(9, 1), OP_TYPE::INSERT, Storage::CUSTOMER, &b1}}});
+
+  // corrupt the value of the second block.
+  {
+    File file{};
+    file.open(Log::get_kLogDirectory() + "/log0", O_RDWR);
+    std::string bytes(boost::filesystem::file_size(Log::get_kLogDirectory() + "/log0"), '\0');
+    ASSERT_EQ(file.read(bytes.data(), bytes.size()), bytes.size());
+    std::size_t pos = bytes.find("a2");
+    ASSERT_NE(pos, std::string::npos);
+    ASSERT_EQ(::pwrite(file.fd(), "x", 1, static_cast<off_t>(pos + 1)), 1);
+  }
+
+  /**
+   * The blocks after the broken block are discarded, so the maximum epoch is
+   * 1 and nothing is recovered.
+   */
+  ASSERT_EQ(Log::recovery_from_log(1), 0U);
+  ASSERT_EQ(kohler_masstree::find_record(Storage::CUSTOMER, "a"), nullptr);
+}
+
+}  // namespace ccbench::testing